@@ -0,0 +1,273 @@
+// ============================================================================
+// DriveSender - uyarlamalı sürüş çerçevesi göndericisi
+// ============================================================================
+// Joystick olayları saniyede onlarca kez gelir; her birini ayrı çerçeve
+// olarak göndermek ESP8266'nın WebSocket kuyruğunu doldurur. Bu sınıf:
+//  - Olayları biriktirir, animasyon karesi (rAF) başına en fazla bir
+//    çerçeve gönderir (yalnızca en son değer gider)
+//  - Sol/sağ değişimi eşiğin altındaysa çerçeveyi bastırır
+//  - Gönderim aralığını ölçülen gidiş-dönüş süresine (RTT) göre ayarlar;
+//    soket tamponunda bekleyen veri varsa yeni çerçeveyi erteler
+//  - Girdi yokken hafif bir OP_KEEPALIVE gönderir (bağlantı canlılığı)
+//  - Durdurma (OP_STOP) hiçbir sınırlamaya takılmadan anında gider
+//  - mixed: true ise update() gaz/direksiyon alır ve OP_MIX gönderir;
+//    sol/sağ karışımı sunucudaki DriveMixer'da yapılır (include/DriveMixer.h)
+//  - sendManeuver() zamanlı segment dizisini tek mesajla yükler; dizi
+//    cihazda kontrol döngüsünde yürütülür (include/ManeuverRunner.h),
+//    ilerleme {"type":"maneuver",...} metin olaylarıyla gelir
+//
+// RTT: aynı anda tek bir çerçeveye FLAG_ACK_REQUEST konur, sunucunun
+// OP_ACK yanıtındaki seq ile eşleştirilip TCP tarzı SRTT hesaplanır.
+//
+// Çerçeve yerleşimi include/DriveProtocol.h ile aynıdır (12 byte, LE):
+// opcode, flags, seq(u16), left(i16), right(i16), stamp(u32, ms)
+// seq ve damga sayesinde sunucu gecikmiş/sırası bozuk çerçeveleri atar;
+// ACK'in right alanı sunucuda atılan çerçeve sayısını, FLAG_FAULT biti
+// sunucu bekçisinin (komut gelmediği için) aracı durdurduğunu taşır.
+
+class DriveSender {
+    constructor(getSocket, options = {}) {
+        this.getSocket = getSocket;  // () => WebSocket (ya da null)
+        this.binary = options.binary !== undefined ? options.binary : true;
+        this.mixed = options.mixed || false;
+        this.threshold = options.threshold !== undefined ? options.threshold : 15;
+        this.minInterval = options.minInterval || 33;          // ms (~30 Hz)
+        this.maxInterval = options.maxInterval || 200;         // ms
+        this.keepaliveInterval = options.keepaliveInterval || 250;
+        this.probeTimeout = 1000;                              // Kayıp ACK
+
+        this.seq = 0;
+        this.target = { left: 0, right: 0 };
+        this.sent = { left: 0, right: 0 };
+        this.dirty = false;
+        this.frameRequest = null;
+        this.lastSendTime = 0;
+
+        this.srtt = null;
+        this.probeSeq = null;
+        this.probeTime = 0;
+        this.fault = false;
+
+        this.stats = { sent: 0, coalesced: 0, suppressed: 0, deferred: 0, keepalives: 0, serverDropped: 0 };
+
+        this.keepaliveTimer = setInterval(() => this.keepalive(), this.keepaliveInterval);
+    }
+
+    // Joystick değeri: -1000..1000 (mixed ise left: gaz, right: direksiyon).
+    // Çerçeve bir sonraki karede gider.
+    update(left, right) {
+        if (this.dirty) this.stats.coalesced++;
+        this.target.left = Math.round(left);
+        this.target.right = Math.round(right);
+        this.dirty = true;
+        this.schedule();
+    }
+
+    // Anında durdur (eşik/aralık/tampon kontrolü yok)
+    stop() {
+        this.cancel();
+        this.target.left = this.target.right = 0;
+        this.sent.left = this.sent.right = 0;
+        this.send(DriveSender.OP_STOP, 0, 0);
+    }
+
+    // Manevra yükle ve başlat (yalnızca ikili protokol). segments:
+    // [{ kind: 'wheels' | 'curve', a, b, ms }] - wheels: a/b sol/sağ,
+    // curve: a hız, b eğrilik (-1000..1000). repeat: ek tur sayısı.
+    // Herhangi bir sürüş/durdurma komutu manevrayı keser.
+    sendManeuver(segments, repeat = 0) {
+        const ws = this.openSocket();
+        if (!ws || !this.binary) return false;
+        if (segments.length === 0 || segments.length > DriveSender.MANEUVER_MAX_SEGMENTS) return false;
+
+        this.cancel();
+        this.target.left = this.target.right = 0;
+        this.sent.left = this.sent.right = 0;
+        this.seq = (this.seq + 1) & 0xFFFF;
+        this.lastSendTime = performance.now();
+        this.stats.sent++;
+
+        const buf = new ArrayBuffer(DriveSender.MANEUVER_HEADER_SIZE +
+                                    segments.length * DriveSender.MANEUVER_SEGMENT_SIZE);
+        const view = new DataView(buf);
+        view.setUint8(0, DriveSender.OP_MANEUVER);
+        view.setUint8(1, 0);
+        view.setUint16(2, this.seq, true);
+        view.setUint8(4, segments.length);
+        view.setUint8(5, repeat);
+        segments.forEach((s, i) => {
+            const offset = DriveSender.MANEUVER_HEADER_SIZE + i * DriveSender.MANEUVER_SEGMENT_SIZE;
+            view.setUint8(offset, s.kind === 'curve' ? 1 : 0);
+            view.setInt16(offset + 1, Math.round(s.a), true);
+            view.setInt16(offset + 3, Math.round(s.b), true);
+            view.setUint16(offset + 5, Math.round(s.ms), true);
+        });
+        ws.send(buf);
+        return true;
+    }
+
+    setSpeed(value) {
+        this.send(DriveSender.OP_SPEED, value, 0, DriveSender.FLAG_ACK_REQUEST);
+    }
+
+    // Sunucu mesajı; OP_ACK ise { seq, speed, dropped, fault } döner, değilse null
+    handleMessage(data) {
+        if (!(data instanceof ArrayBuffer) || data.byteLength !== DriveSender.FRAME_SIZE) {
+            return null;
+        }
+        const view = new DataView(data);
+        if (view.getUint8(0) !== DriveSender.OP_ACK) return null;
+
+        const seq = view.getUint16(2, true);
+        if (seq === this.probeSeq) {
+            const sample = performance.now() - this.probeTime;
+            this.srtt = this.srtt === null ? sample : this.srtt * 0.875 + sample * 0.125;
+            this.probeSeq = null;
+        }
+        this.stats.serverDropped = view.getInt16(6, true);
+        this.fault = (view.getUint8(1) & DriveSender.FLAG_FAULT) !== 0;
+        return { seq: seq, speed: view.getInt16(4, true), dropped: this.stats.serverDropped, fault: this.fault };
+    }
+
+    // Şu anki gönderim aralığı: RTT'den hızlı göndermenin anlamı yok
+    sendInterval() {
+        if (this.srtt === null) return this.minInterval;
+        return Math.min(this.maxInterval, Math.max(this.minInterval, this.srtt));
+    }
+
+    rtt() {
+        return this.srtt === null ? null : Math.round(this.srtt);
+    }
+
+    dispose() {
+        this.cancel();
+        clearInterval(this.keepaliveTimer);
+    }
+
+    // ------------------------------------------------------------------------
+
+    schedule() {
+        if (this.frameRequest === null) {
+            this.frameRequest = requestAnimationFrame(() => {
+                this.frameRequest = null;
+                this.flush();
+            });
+        }
+    }
+
+    cancel() {
+        if (this.frameRequest !== null) {
+            cancelAnimationFrame(this.frameRequest);
+            this.frameRequest = null;
+        }
+        this.dirty = false;
+    }
+
+    flush() {
+        if (!this.dirty) return;
+
+        const ws = this.openSocket();
+        if (!ws) {
+            this.dirty = false;
+            return;
+        }
+
+        const { left, right } = this.target;
+        const delta = Math.max(Math.abs(left - this.sent.left), Math.abs(right - this.sent.right));
+        // Sıfıra dönüş (bırakma) eşikten bağımsız olarak her zaman gider
+        const release = left === 0 && right === 0;
+
+        if (delta === 0 || (delta < this.threshold && !release)) {
+            if (delta !== 0) this.stats.suppressed++;
+            this.dirty = false;
+            return;
+        }
+
+        if (!release) {
+            if (performance.now() - this.lastSendTime < this.sendInterval() || ws.bufferedAmount > 0) {
+                this.stats.deferred++;
+                this.schedule();
+                return;
+            }
+        }
+
+        this.send(this.mixed ? DriveSender.OP_MIX : DriveSender.OP_DRIVE, left, right);
+        this.sent.left = left;
+        this.sent.right = right;
+        this.dirty = false;
+    }
+
+    keepalive() {
+        if (performance.now() - this.lastSendTime < this.keepaliveInterval) return;
+        if (this.send(DriveSender.OP_KEEPALIVE, 0, 0)) {
+            this.stats.keepalives++;
+        }
+    }
+
+    openSocket() {
+        const ws = this.getSocket();
+        return ws && ws.readyState === WebSocket.OPEN ? ws : null;
+    }
+
+    send(opcode, left, right, flags = 0) {
+        const ws = this.openSocket();
+        if (!ws) return false;
+
+        const now = performance.now();
+        this.lastSendTime = now;
+        this.stats.sent++;
+
+        if (!this.binary) {
+            // JSON yedek yolu: RTT ölçümü yok, keepalive {"cmd":"ka"}
+            if (opcode === DriveSender.OP_DRIVE) {
+                ws.send(JSON.stringify({ cmd: 'custom', left: left, right: right }));
+            } else if (opcode === DriveSender.OP_MIX) {
+                ws.send(JSON.stringify({ cmd: 'drive', throttle: left, steer: right }));
+            } else if (opcode === DriveSender.OP_STOP) {
+                ws.send(JSON.stringify({ cmd: 'move', direction: 'stop' }));
+            } else if (opcode === DriveSender.OP_SPEED) {
+                ws.send(JSON.stringify({ cmd: 'speed', value: left }));
+            } else if (opcode === DriveSender.OP_KEEPALIVE) {
+                ws.send('{"cmd":"ka"}');
+            }
+            return true;
+        }
+
+        this.seq = (this.seq + 1) & 0xFFFF;
+
+        // Aynı anda tek RTT ölçümü; yanıt gelmezse zaman aşımından sonra yenisi
+        if (this.probeSeq === null || now - this.probeTime > this.probeTimeout) {
+            flags |= DriveSender.FLAG_ACK_REQUEST;
+        }
+        if (flags & DriveSender.FLAG_ACK_REQUEST) {
+            this.probeSeq = this.seq;
+            this.probeTime = now;
+        }
+
+        const buf = new ArrayBuffer(DriveSender.FRAME_SIZE);
+        const view = new DataView(buf);
+        view.setUint8(0, opcode);
+        view.setUint8(1, flags);
+        view.setUint16(2, this.seq, true);
+        view.setInt16(4, left, true);
+        view.setInt16(6, right, true);
+        view.setUint32(8, Math.floor(now) >>> 0, true);
+        ws.send(buf);
+        return true;
+    }
+}
+
+// İkili sürüş protokolü sabitleri (include/DriveProtocol.h)
+DriveSender.FRAME_SIZE = 12;
+DriveSender.OP_DRIVE = 0x01;
+DriveSender.OP_STOP = 0x02;
+DriveSender.OP_SPEED = 0x03;
+DriveSender.OP_KEEPALIVE = 0x04;
+DriveSender.OP_MIX = 0x05;
+DriveSender.OP_MANEUVER = 0x06;
+DriveSender.MANEUVER_HEADER_SIZE = 6;
+DriveSender.MANEUVER_SEGMENT_SIZE = 7;
+DriveSender.MANEUVER_MAX_SEGMENTS = 32;
+DriveSender.OP_ACK = 0x81;
+DriveSender.FLAG_ACK_REQUEST = 0x01;
+DriveSender.FLAG_FAULT = 0x02;
@@ -42,7 +42,7 @@ function init() {
 function connectWebSocket() {
     try {
         const protocol = window.location.protocol === 'https:' ? 'wss:' : 'ws:';
-        const wsUrl = `${protocol}//${window.location.hostname}:81`;
+        const wsUrl = `${protocol}//${window.location.host}/ws`;
         
         ws = new WebSocket(wsUrl);
         
@@ -9,6 +9,12 @@ let ws = null;
 let wsConnected = false;
 let currentSpeed = 150;
 
+// İkili sürüş protokolü (include/DriveProtocol.h ile aynı yerleşim)
+// false yapılırsa JSON formatına geri dönülür. Çerçeveler drive-sender.js
+// üzerinden gider (kare başına birleştirme, delta eşiği, keepalive).
+let useBinaryProtocol = true;
+const sender = new DriveSender(() => ws, { binary: useBinaryProtocol, mixed: true });
+
 // Joystick değerleri (global olarak tutuyoruz)
 let joystickValues = {
     vertical: { x: 0, y: 0, distance: 0 },
@@ -42,9 +48,10 @@ function init() {
 function connectWebSocket() {
     try {
         const protocol = window.location.protocol === 'https:' ? 'wss:' : 'ws:';
-        const wsUrl = `${protocol}//${window.location.hostname}:81`;
+        const wsUrl = `${protocol}//${window.location.host}/ws`;
         
         ws = new WebSocket(wsUrl);
+        ws.binaryType = 'arraybuffer';
         
         ws.onopen = () => {
             wsConnected = true;
@@ -54,6 +61,7 @@ function connectWebSocket() {
         };
         
         ws.onmessage = (event) => {
+            if (sender.handleMessage(event.data)) return;
             console.log('WS mesaj:', event.data);
         };
         
@@ -205,19 +213,10 @@ function initHorizontalJoystick() {
 // ESP8266'ya Veri Gönderme (Direkt - hızlanma yok)
 // ============================================================================
 function sendToESP() {
-    // Joystick değerlerini kombinle
-    const vertical = joystickValues.vertical.forward || 0;
-    const horizontal = joystickValues.horizontal.turn || 0;
-    
-    // Motor hızlarını hesapla (-100..100 arası)
-    const leftSpeed = Math.round(Math.max(-100, Math.min(100, vertical + horizontal)));
-    const rightSpeed = Math.round(Math.max(-100, Math.min(100, vertical - horizontal)));
-    
-    // PWM değerlerine çevir (-100..100 -> -1000..1000)
-    const leftPWM = leftSpeed * 10;
-    const rightPWM = rightSpeed * 10;
-    
-    console.log(`[DEBUG] V=${vertical}, H=${horizontal} | Motor: L=${leftPWM}, R=${rightPWM}`);
+    // Gaz/direksiyon (-100..100 -> -1000..1000); sol/sağ karışımı araçta
+    // (OP_MIX, DriveMixer) yapılır
+    const throttle = (joystickValues.vertical.forward || 0) * 10;
+    const steer = (joystickValues.horizontal.turn || 0) * 10;
     
     if (!wsConnected) {
         console.error('[HATA] WebSocket bağlı değil!');
@@ -229,15 +228,9 @@ function sendToESP() {
         return;
     }
     
-    // ESP'nin beklediği JSON formatı
-    const payload = {
-        cmd: "custom",
-        left: leftPWM,
-        right: rightPWM
-    };
-    
-    console.log('[GÖNDER]', JSON.stringify(payload));
-    ws.send(JSON.stringify(payload));
+    // Her nipplejs olayı ayrı çerçeve değil; sender bir sonraki karede
+    // yalnızca en son değeri gönderir
+    sender.update(throttle, steer);
 }
 
 // ============================================================================
@@ -245,6 +238,11 @@ function sendToESP() {
 // ============================================================================
 function sendCommand(cmdStr) {
     if (wsConnected && ws && ws.readyState === WebSocket.OPEN) {
+        if (useBinaryProtocol && cmdStr === 'stop') {
+            sender.stop();
+            return;
+        }
+        
         // JSON formatında gönder
         const payload = {
             cmd: "move",
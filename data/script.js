@@ -4,10 +4,15 @@ class RCCarController {
         this.currentSpeed = 150;
         this.autoReconnect = true;
         this.reconnectInterval = 3000;
-        this.commandInterval = null;
         this.activeCommand = null;
-        this.lastJoystickCommand = 0; // Throttle için
-        this.joystickThrottleDelay = 100; // 100ms'de bir komut
+        
+        // İkili sürüş protokolü (include/DriveProtocol.h ile aynı yerleşim)
+        // false yapılırsa JSON formatına geri dönülür
+        this.useBinaryProtocol = true;
+        
+        // Joystick çerçevelerini birleştirir, RTT'ye göre hız ayarlar
+        // ve boştayken keepalive gönderir (drive-sender.js)
+        this.sender = new DriveSender(() => this.ws, { binary: this.useBinaryProtocol });
         
         this.init();
     }
@@ -15,10 +20,6 @@ class RCCarController {
     init() {
         // Sayfa yüklendiğinde tüm aktif komutları temizle
         this.activeCommand = null;
-        if (this.commandInterval) {
-            clearInterval(this.commandInterval);
-            this.commandInterval = null;
-        }
         
         this.bindEvents();
         this.connectWebSocket();
@@ -39,6 +40,11 @@ class RCCarController {
             this.updateSpeed(e.target.value);
         });
         
+        // Ayar kutuları: her değişiklik cihazdaki gölge sete yazılır
+        document.querySelectorAll('[data-param]').forEach((input) => {
+            input.addEventListener('change', () => this.sendParam(input));
+        });
+        
         // Bağlantı durumu kontrolü
         setInterval(() => {
             this.updateConnectionStatus();
@@ -47,9 +53,10 @@ class RCCarController {
     
     connectWebSocket() {
         const protocol = window.location.protocol === 'https:' ? 'wss:' : 'ws:';
-        const wsUrl = `${protocol}//${window.location.hostname}:81`;
+        const wsUrl = `${protocol}//${window.location.host}/ws`;
         
         this.ws = new WebSocket(wsUrl);
+        this.ws.binaryType = 'arraybuffer';
         
         this.ws.onopen = () => {
             console.log('WebSocket bağlantısı açıldı');
@@ -81,6 +88,18 @@ class RCCarController {
         };
         
         this.ws.onmessage = (event) => {
+            if (event.data instanceof ArrayBuffer) {
+                const wasFault = this.sender.fault;
+                const ack = this.sender.handleMessage(event.data);
+                if (ack && ack.fault && !wasFault) {
+                    this.showToast('Bağlantı zayıf: araç durduruldu', 'warning');
+                }
+                if (ack) {
+                    this.currentSpeed = ack.speed;
+                    this.updateSpeedDisplay();
+                }
+                return;
+            }
             try {
                 const data = JSON.parse(event.data);
                 this.handleWebSocketMessage(data);
@@ -93,6 +112,24 @@ class RCCarController {
     handleWebSocketMessage(data) {
         if (data.type === 'welcome') {
             console.log('Sunucu mesajı:', data.message);
+        } else if (data.type === 'telemetry') {
+            // Sunucuda atılan (eski/sırasız/bayat) çerçeveler ve kuyruk yaşı
+            this.linkStats = data.drive;
+            if (data.battery) this.updateBattery(data.battery);
+            if (data.drive && data.drive.stale + data.drive.reordered > 0) {
+                console.debug('Bağlantı:', data.drive, 'RTT:', this.sender.rtt(), 'ms');
+            }
+        } else if (data.type === 'maneuver') {
+            this.updateManeuverStatus(data);
+        } else if (data.type === 'params') {
+            this.updateParams(data);
+        } else if (data.type === 'battery') {
+            this.updateBattery(data);
+            if (data.guard) {
+                this.showToast('Batarya çöküyor: motor gücü sınırlandı', 'error');
+            } else if (data.state === 'low' || data.state === 'critical') {
+                this.showToast(`Batarya düşük (${(data.mv / 1000).toFixed(2)} V)`, 'warning');
+            }
         } else if (data.status === 'ok') {
             if (data.speed !== undefined) {
                 this.currentSpeed = data.speed;
@@ -101,6 +138,17 @@ class RCCarController {
         }
     }
 
+    // Sol/sağ motor değerlerini gönder (-1000..1000); gönderim zamanını
+    // DriveSender belirler (kare başına en fazla bir çerçeve)
+    sendDrive(left, right) {
+        if (!this.ws || this.ws.readyState !== WebSocket.OPEN) {
+            this.showToast('Bağlantı yok!', 'error');
+            return;
+        }
+        
+        this.sender.update(left, right);
+    }
+
     sendSoundCommand(action) {
         if (!this.ws || this.ws.readyState !== WebSocket.OPEN) {
             this.showToast('Bağlantı yok!', 'error');
@@ -111,6 +159,79 @@ class RCCarController {
         this.ws.send(message);
     }
 
+    // Hazır manevralar: cihaza tek mesajla yüklenir, kontrol döngüsünde
+    // yürütülür. Joystick ya da durdurma manevrayı keser.
+    runManeuver(name) {
+        const maneuver = RCCarController.MANEUVERS[name];
+        if (!maneuver || !this.sender.sendManeuver(maneuver.segments, maneuver.repeat)) {
+            this.showToast('Manevra için ikili protokol bağlantısı gerekli', 'warning');
+            return;
+        }
+        this.showToast(maneuver.label + ' başlatıldı', 'info');
+    }
+
+    updateManeuverStatus(data) {
+        const statusEl = document.getElementById('maneuverStatus');
+        if (data.state === 'running') {
+            statusEl.textContent = `Segment ${data.segment + 1}/${data.count}, tur ${data.pass + 1}/${data.repeat + 1}`;
+        } else if (data.state === 'done') {
+            statusEl.textContent = `Tamamlandı (${(data.elapsed_ms / 1000).toFixed(1)} s)`;
+        } else if (data.state === 'aborted') {
+            statusEl.textContent = 'Kesildi';
+            this.showToast('Manevra kesildi', 'warning');
+        } else if (data.state === 'rejected') {
+            statusEl.textContent = 'Geçersiz manevra';
+        }
+    }
+
+    updateBattery(battery) {
+        const el = document.getElementById('batteryValue');
+        if (battery.state === 'absent') {
+            el.textContent = 'USB';
+            el.style.color = '';
+            return;
+        }
+        el.textContent = `${(battery.mv / 1000).toFixed(2)} V`;
+        el.style.color = battery.state === 'ok' ? '' : (battery.state === 'low' ? '#e67e22' : '#c0392b');
+    }
+
+    // Canlı ayar: değer gölge sete yazılır, Uygula ile sürüşte geçerli olur
+    sendParam(input) {
+        if (!this.ws || this.ws.readyState !== WebSocket.OPEN) {
+            this.showToast('Bağlantı yok!', 'error');
+            return;
+        }
+        const value = input.type === 'number' ? parseInt(input.value) : input.value;
+        if (input.type === 'number' && isNaN(value)) return;
+        this.ws.send(JSON.stringify({ cmd: 'param', name: input.dataset.param, value: value }));
+        if (input.type === 'password') input.value = '';
+    }
+
+    paramsAction(action) {
+        if (!this.ws || this.ws.readyState !== WebSocket.OPEN) {
+            this.showToast('Bağlantı yok!', 'error');
+            return;
+        }
+        this.ws.send(JSON.stringify({ cmd: 'params', action: action }));
+    }
+
+    updateParams(data) {
+        document.querySelectorAll('[data-param]').forEach((input) => {
+            const value = data.set[input.dataset.param];
+            // Düzenlenmekte olan kutunun üzerine yazma
+            if (value !== undefined && document.activeElement !== input) input.value = value;
+        });
+        
+        const notes = [];
+        if (data.rejected) notes.push(`geçersiz: ${data.rejected}`);
+        if (data.dirty) notes.push('uygulanmadı');
+        if (data.save_pending) notes.push('araç durunca kaydedilecek');
+        if (data.restart) notes.push('WiFi yeniden başlatınca');
+        const source = { stored: 'kayıtlı', defaults: 'varsayılan', invalid: 'kayıt bozuk, varsayılan' }[data.source];
+        document.getElementById('paramsStatus').textContent =
+            `${source} #${data.rev}` + (notes.length ? ` (${notes.join(', ')})` : '');
+    }
+
     playHorn() {
         this.sendSoundCommand('horn');
         this.showToast('Korna çalınıyor', 'info');
@@ -140,6 +261,16 @@ class RCCarController {
             return;
         }
         
+        if (this.useBinaryProtocol && value === null && command === 'stop') {
+            this.sender.stop();
+            return;
+        }
+        
+        if (this.useBinaryProtocol && command === 'speed') {
+            this.sender.setSpeed(value);
+            return;
+        }
+        
         const message = value !== null 
             ? JSON.stringify({ cmd: command, value: value })
             : JSON.stringify({ cmd: 'move', direction: command });
@@ -155,13 +286,6 @@ class RCCarController {
     emergencyStop() {
         console.log('emergencyStop çağrıldı');
         
-        // Tüm aktif interval'ları temizle
-        if (this.commandInterval) {
-            clearInterval(this.commandInterval);
-            this.commandInterval = null;
-            console.log('Interval temizlendi');
-        }
-        
         // Aktif komutu sıfırla
         this.activeCommand = null;
         console.log('Aktif komut sıfırlandı');
@@ -188,22 +312,12 @@ class RCCarController {
         
         this.activeCommand = command;
         console.log(`Yeni aktif komut: ${this.activeCommand}`);
+        // Komut bir kez gider; buton basılı kaldıkça bağlantıyı
+        // DriveSender'ın keepalive çerçeveleri canlı tutar
         this.sendCommand(command);
-        
-        // Sürekli komut gönderme - interval'i artır (daha stabil)
-        this.commandInterval = setInterval(() => {
-            if (this.activeCommand === command) {
-                this.sendCommand(command);
-            }
-        }, 200); // 200ms'ye çıkar (daha az sıklık)
     }
     
     stopCommand() {
-        if (this.commandInterval) {
-            clearInterval(this.commandInterval);
-            this.commandInterval = null;
-        }
-        
         if (this.activeCommand && this.activeCommand !== 'stop') {
             this.sendCommand('stop');
         }
@@ -262,6 +376,9 @@ class RCCarController {
     
     setupKeyboardControls() {
         document.addEventListener('keydown', (e) => {
+            // Ayar kutularına yazarken araç sürülmesin
+            if (e.target.tagName === 'INPUT') return;
+            
             // Space tuşunu engelle (sayfa kaymasın)
             if (e.code === 'Space') {
                 e.preventDefault();
@@ -296,6 +413,7 @@ class RCCarController {
         });
         
         document.addEventListener('keyup', (e) => {
+            if (e.target.tagName === 'INPUT') return;
             if (e.code === 'Space') {
                 e.preventDefault();
             }
@@ -532,51 +650,44 @@ class RCCarController {
     }
     
     handleJoystickMovement(direction, distance) {
-        // Throttle kontrolü - çok sık komut gönderme
-        const now = Date.now();
-        if (now - this.lastJoystickCommand < this.joystickThrottleDelay) {
-            return; // Çok sık, atla
-        }
-        this.lastJoystickCommand = now;
-        
         console.log(`Joystick hareket: ${direction}, mesafe: ${distance}`);
         
-        // Mesafeye göre hız ayarı (0-100 arası)
-        const speed = Math.min(Math.max(distance, 0), 100);
+        // Mesafeye göre hız ayarı (0-100 arası -> -1000..1000 motor aralığı)
+        const speed = Math.min(Math.max(distance, 0), 100) * 10;
         console.log(`Hesaplanan hız: ${speed}`);
         
         switch(direction) {
             case 'İleri':
                 console.log('İleri komutu gönderiliyor');
-                this.sendCommand('custom', { left: speed, right: speed });
+                this.sendDrive(speed, speed);
                 break;
             case 'Geri':
                 console.log('Geri komutu gönderiliyor');
-                this.sendCommand('custom', { left: -speed, right: -speed });
+                this.sendDrive(-speed, -speed);
                 break;
             case 'Sağ':
                 console.log('Sağ komutu gönderiliyor');
-                this.sendCommand('custom', { left: speed, right: -speed });
+                this.sendDrive(speed, -speed);
                 break;
             case 'Sol':
                 console.log('Sol komutu gönderiliyor');
-                this.sendCommand('custom', { left: -speed, right: speed });
+                this.sendDrive(-speed, speed);
                 break;
             case 'İleri Sağ':
                 console.log('İleri Sağ komutu gönderiliyor');
-                this.sendCommand('custom', { left: speed, right: speed * 0.3 });
+                this.sendDrive(speed, speed * 0.3);
                 break;
             case 'İleri Sol':
                 console.log('İleri Sol komutu gönderiliyor');
-                this.sendCommand('custom', { left: speed * 0.3, right: speed });
+                this.sendDrive(speed * 0.3, speed);
                 break;
             case 'Geri Sağ':
                 console.log('Geri Sağ komutu gönderiliyor');
-                this.sendCommand('custom', { left: -speed, right: -speed * 0.3 });
+                this.sendDrive(-speed, -speed * 0.3);
                 break;
             case 'Geri Sol':
                 console.log('Geri Sol komutu gönderiliyor');
-                this.sendCommand('custom', { left: -speed * 0.3, right: -speed });
+                this.sendDrive(-speed * 0.3, -speed);
                 break;
             default:
                 console.log('Bilinmeyen yön, durdurma komutu gönderiliyor');
@@ -595,6 +706,29 @@ class RCCarController {
     }
 }
 
+// Hazır manevralar (include/ManeuverRunner.h): curve = hız/eğrilik,
+// wheels = sol/sağ; değerler -1000..1000, süreler ms
+RCCarController.MANEUVERS = {
+    eight: {
+        label: 'Sekiz',
+        repeat: 1,
+        segments: [
+            { kind: 'curve', a: 600, b: 700, ms: 2400 },
+            { kind: 'curve', a: 600, b: -700, ms: 2400 }
+        ]
+    },
+    park: {
+        label: 'Park',
+        repeat: 0,
+        segments: [
+            { kind: 'curve', a: -500, b: 800, ms: 900 },
+            { kind: 'curve', a: -500, b: -800, ms: 900 },
+            { kind: 'wheels', a: 400, b: 400, ms: 300 },
+            { kind: 'wheels', a: 0, b: 0, ms: 200 }
+        ]
+    }
+};
+
 // Global fonksiyonlar (HTML'den çağrılacak)
 let carController;
 
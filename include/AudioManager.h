@@ -1,24 +1,90 @@
 #ifndef AUDIO_MANAGER_H
 #define AUDIO_MANAGER_H
 
-#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "Hal.h"
+#include "DFPlayerProtocol.h"
+#include "LatencyStats.h"
+#include "ParamStore.h"
 
+// Bu sayı kadar bayt loop() geçişi başına yazılır. 1: paket (~10 ms hat
+// süresi) geçişlere yayılır. 10: eski davranış (paket tek seferde), önce/
+// sonra karşılaştırması için -DAUDIO_TX_BYTES_PER_PASS=10 ile ölçülebilir.
+#ifndef AUDIO_TX_BYTES_PER_PASS
+#define AUDIO_TX_BYTES_PER_PASS 1
+#endif
+
+// DFPlayer Mini sürücüsü - bloke etmeyen komut kuyruğu
+//
+// SoftwareSerial'de her bayt ~1 ms CPU'yu meşgul eder; 10 byte'lık paketi
+// WebSocket işleyicisi içinde tek seferde yazmak WiFi'yi ve kontrol
+// tick'ini 10 ms'den fazla durduruyordu. Komutlar artık kuyruğa paket
+// olarak girer, loop() her geçişte en fazla AUDIO_TX_BYTES_PER_PASS bayt
+// yazar. Modül yanıtları (açılış, ACK, hata, parça bitti) da loop()'ta
+// bayt bayt ayrıştırılır; begin() modülün açılmasını beklemez.
+//
+// Her yazım çağrısının bloke süresi (kesme kapalı kalabilecek en uzun
+// pencerenin üst sınırı) histogramda tutulur: "audio.tx_block_*" (µs).
 class AudioManager {
 public:
+    enum State : uint8_t {
+        OFFLINE,        // Modül yanıt vermedi (sonradan açılırsa hazır olur)
+        STARTING,       // Reset gönderildi, EVT_ONLINE bekleniyor
+        READY
+    };
+
     AudioManager(uint8_t rxPin, uint8_t txPin);
     void begin();
 
+    // Her loop() geçişinde çağrılır; bloke süresi en fazla
+    // AUDIO_TX_BYTES_PER_PASS bayt hat süresi kadardır
+    void loop(uint32_t nowUs);
+
     void playHorn();
     void playSiren();
     void playNextSong();
     void stop();
 
-    bool isReady() const { return ready; }
+    // Canlı parametreler: yayınlanan setteki ses seviyesi loop()'ta uygulanır
+    void setParams(const ParamStore* store);
+
+    bool isReady() const { return state == READY; }
+    bool isPlaying() const { return playing; }
+
+    // {"state":..,"playing":..,"queued":..,"sent":..,"dropped":..,"acks":..,
+    //  "errors":..,"rx_errors":..,"tx_block_p50":..,"tx_block_p99":..,
+    //  "tx_block_max":..} (bloke süreleri µs)
+    size_t writeJson(char* buf, size_t size) const;
 
 private:
+    static const uint8_t QUEUE_SIZE = 8;                // 2'nin kuvveti
+    static const uint32_t TX_BYTE_GAP_US = 2000;        // Baytlar arası (hat süresi ~1042 µs)
+    static const uint32_t START_TIMEOUT_MS = 3000;      // Reset -> EVT_ONLINE
+    static const uint8_t START_RETRIES = 3;
+
     uint8_t rxPin;
     uint8_t txPin;
-    bool ready = false;
+    hal::SerialPort* port = nullptr;
+
+    State state = OFFLINE;
+    uint32_t stateSince = 0;
+    uint8_t startAttempts = 0;
+    bool playing = false;
+
+    uint8_t queue[QUEUE_SIZE][DFPlayerProtocol::PACKET_SIZE];
+    uint8_t head = 0;       // Yazılmakta olan paket
+    uint8_t tail = 0;
+    uint8_t txOffset = 0;   // Baştaki paketin sıradaki baytı
+    uint32_t lastTxUs = 0;
+
+    DFPlayerProtocol::Parser parser;
+
+    uint32_t sent = 0;
+    uint32_t dropped = 0;
+    uint32_t acks = 0;
+    uint32_t errors = 0;
+    LatencyHistogram txBlock;   // µs
 
     uint8_t songMin = 1;
     uint8_t songMax = 10;
@@ -26,7 +92,16 @@ private:
 
     uint8_t hornTrack = 11;
     uint8_t sirenTrack = 12;
+    uint8_t volume = 20;        // 0-30
+
+    const ParamStore* params = nullptr;
+    uint32_t paramsVersion = 0;
 
+    bool enqueue(uint8_t command, uint16_t param, bool feedback);
+    void transmit(uint32_t nowUs);
+    void receive();
+    void handlePacket(const DFPlayerProtocol::Packet& packet);
+    void requestReset(uint32_t nowMs);
     void playTrack(uint16_t track);
 };
 
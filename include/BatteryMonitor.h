@@ -0,0 +1,105 @@
+#ifndef BATTERY_MONITOR_H
+#define BATTERY_MONITOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Batarya gerilimi (A0) ayarları
+struct BatteryConfig {
+    uint16_t fullScaleMv;   // A0 = 1023 iken batarya gerilimi (bölücü oranı)
+    uint16_t nominalMv;     // PWM değerleri bu gerilime göre ayarlı
+    uint16_t lowMv;         // Altı: düşük gerilim uyarısı
+    uint16_t criticalMv;    // Anlık okuma altına inerse akım sınırlanır
+    uint16_t absentMv;      // Altı: batarya yok (USB besleme), telafi kapalı
+};
+
+// Batarya gerilimi izleme, PWM besleme telafisi ve çökme (brownout) koruması.
+//
+// poll() düşük öncelikli bir görevden çağrılır: A0'ı OVERSAMPLE kez okur
+// (ortalama çözünürlüğü artırır, minimum anlık çöküşü yakalar) ve birinci
+// derece IIR'den geçirir. Kontrol tick'i ADC'ye dokunmaz; apply() yalnızca
+// son hesaplanan ölçek ve tavanı kullanır.
+//
+// Telafi: duty * (nominal / filtrelenmiş) ile motorun gördüğü ortalama
+// gerilim batarya boşaldıkça sabit kalır (ölü bölge eşiği de ölçeklenir,
+// düşük gerilimde kalkış korunur). Ölçek SCALE_MIN..SCALE_MAX ile sınırlı.
+//
+// Koruma: anlık okuma criticalMv altına düşerse (kalkış/yön değiştirme
+// akımıyla çöken batarya, ESP8266 sıfırlanmadan önce) PWM tavanı adım adım
+// düşürülür ve telafi 1'e sınırlanır; gerilim histerezisle toparlanınca
+// tavan yavaşça açılır.
+class BatteryMonitor {
+public:
+    // LOW Arduino makrosu olduğundan LOW_VOLTAGE
+    enum State : uint8_t { ABSENT = 0, NORMAL = 1, LOW_VOLTAGE = 2, CRITICAL = 3 };
+
+    static const uint8_t OVERSAMPLE = 4;        // poll() başına okuma
+    static const uint8_t FILTER_SHIFT = 3;      // IIR katsayısı 1/8
+    static const uint16_t HYSTERESIS_MV = 200;
+    static const uint16_t SCALE_MIN = 3277;     // Q12 0.8
+    static const uint16_t SCALE_MAX = 5734;     // Q12 1.4
+    static const int16_t LIMIT_MIN = 128;       // Koruma altında en düşük PWM tavanı
+    static const int16_t LIMIT_STEP_DOWN = 32;  // Çöküş başına
+    static const int16_t LIMIT_STEP_UP = 4;     // Toparlanınca poll başına
+
+private:
+    BatteryConfig config;
+
+    uint32_t filteredQ4 = 0;    // mV << 4
+    uint16_t lastMv = 0;        // Son ortalama
+    uint16_t dipMv = 0;         // Son poll'daki en düşük anlık okuma
+    uint16_t minMv = 0xFFFF;    // Açılıştan beri en düşük (filtrelenmiş)
+    bool primed = false;
+
+    State state = ABSENT;
+    uint16_t scaleQ12 = 4096;
+    int16_t pwmLimit = 255;
+    bool guarding = false;
+
+    uint32_t lowEvents = 0;
+    uint32_t brownoutEvents = 0;
+    volatile uint32_t version = 0;  // Durum ya da koruma değişince artar
+
+    uint16_t toMv(uint32_t counts) const {
+        return (uint16_t)(counts * config.fullScaleMv / 1023);
+    }
+
+    void setState(State next);
+
+public:
+    explicit BatteryMonitor(const BatteryConfig& cfg) : config(cfg) {}
+
+    // A0'ı okur ve günceller (görevden, ~OVERSAMPLE * 0.1 ms)
+    void poll(uint32_t nowMs);
+
+    // Ham ADC örnekleriyle güncelle (poll() ve testler): toplam, en küçük
+    void update(uint32_t sum, uint16_t minimum, uint8_t count);
+
+    // Tick'te sürücüye gitmeden önce: besleme telafisi + çökme tavanı
+    int16_t apply(int16_t pwm, int16_t pwmMax) const {
+        if (pwm == 0) return 0;
+        int32_t magnitude = pwm < 0 ? -pwm : pwm;
+        if (state != ABSENT) {
+            magnitude = (magnitude * scaleQ12) >> 12;
+        }
+        if (magnitude > pwmMax) magnitude = pwmMax;
+        if (magnitude > pwmLimit) magnitude = pwmLimit;
+        return (int16_t)(pwm < 0 ? -magnitude : magnitude);
+    }
+
+    State getState() const { return state; }
+    uint16_t getMillivolts() const { return (uint16_t)(filteredQ4 >> 4); }
+    uint16_t getScaleQ12() const { return scaleQ12; }
+    int16_t getPwmLimit() const { return pwmLimit; }
+    uint32_t getVersion() const { return version; }
+    static const char* stateName(State value);
+
+    // {"state":..,"mv":..,"sample_mv":..,"dip_mv":..,"min_mv":..,"scale_pct":..,
+    //  "pwm_limit":..,"low_events":..,"brownout_events":..}
+    size_t writeJson(char* buf, size_t size) const;
+
+    // Durum olayı (WebSocket): {"type":"battery",...}
+    size_t writeEvent(char* buf, size_t size) const;
+};
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef COMMAND_PROCESSOR_H
+#define COMMAND_PROCESSOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Hal.h"
+#include "MotorController.h"
+#include "AudioManager.h"
+#include "DriveProtocol.h"
+#include "DriveInbox.h"
+#include "LatencyStats.h"
+#include "CommandRegistry.h"
+#include "ParamStore.h"
+
+// Komut yolu: WebSocket çerçevesi / HTTP komutu -> ayrıştırma -> motor/ses.
+//
+// Ağ kütüphanelerinden bağımsızdır; yanıtlar hal::Transport üzerinden
+// gönderilir. Cihazda WebServerManager, host'ta native simülatör besler.
+class CommandProcessor {
+private:
+    MotorController* motor;
+    AudioManager* audio;
+    hal::Transport* transport;
+    ParamStore* params = nullptr;   // Canlı ayar (yoksa param komutları yok sayılır)
+    
+    // Komut tipi başına alım -> pin yazımı gecikmeleri
+    LatencyStats latency;
+    
+    // İkili sürüş çerçeveleri: geçiş başına en yenisi uygulanır
+    DriveInbox inbox;
+    
+    // Son sürüş komutunu (hareket, durdurma, manevra) veren istemci;
+    // keepalive yalnızca ondan gelirse bekçiyi besler. Boşta duran ikinci
+    // sekme ölmüş sürücünün aracını sürmeye devam ettiremez.
+    uint8_t driveClient = NO_CLIENT;
+    
+    // Manevra ilerlemesi yükleyen istemciye gönderilir (flush())
+    uint8_t maneuverClient = 0;
+    uint16_t maneuverVersion = 0;
+    
+    // Pinlere dokunmayan komutlar (hız, ses) dağıtım anında kaydedilir
+    void recordImmediate(LatencyTrace& trace, uint8_t type);
+    
+    void sendAck(uint8_t client, const DriveProtocol::Frame& frame);
+    void sendManeuverProgress();
+    
+    // OP_MANEUVER yüklemesi (değişken boyutlu)
+    void handleManeuver(uint8_t client, const uint8_t* payload, size_t length);
+    
+    // Kayıttaki (CommandRegistry) komutların argümanları ve işleyicileri
+    struct CommandArgs {
+        int32_t value;
+        int32_t left;
+        int32_t right;
+        int32_t throttle;
+        int32_t steer;
+        const char* name;       // ARG_PARAM: alan adı
+        const char* text;       // ARG_PARAM: metin değer (sayıysa nullptr)
+        uint8_t client;         // Komutu gönderen (WebSocket slotu, HTTP_CLIENT ...)
+    };
+    
+    struct Binding {
+        void (*handler)(CommandProcessor& self, const CommandArgs& args);
+        uint8_t traceType;      // CMD_MOVE/CMD_DRIVE_JSON: pin yazımında, diğerleri anında kaydedilir
+    };
+    
+    // CommandRegistry::CommandId sırasıyla
+    static const Binding HANDLERS[];
+    
+    void execute(CommandRegistry::CommandId id, const CommandArgs& args, LatencyTrace& trace);
+    
+public:
+    // WebSocket slotlarından (0..MAX_WS_CLIENTS-1) ve UdpControl::CLIENT_ID'den
+    // ayrı istemci kimlikleri: tüm /control istekleri tek istemci sayılır
+    static const uint8_t HTTP_CLIENT = 0xFD;
+    static const uint8_t NO_CLIENT = 0xFF;
+    
+    CommandProcessor(MotorController* motorController, AudioManager* audioManager,
+                     hal::Transport* transport);
+    
+    void setParams(ParamStore* store) { params = store; }
+    
+    void onConnect(uint8_t client);
+    void onDisconnect(uint8_t client);
+    
+    // Bağlantısız istemcinin yeni oturumu (UDP belirteci): seq baştan başlar
+    void onSession(uint8_t client);
+    
+    // WebSocket ping/pong gidiş-dönüş süresi; bekçi zaman aşımını uyarlar
+    void onPong(uint8_t client, uint32_t rttMs);
+    
+    // rxCycles: çerçevenin alındığı an (hal::cycleCount())
+    
+    // JSON metin çerçevesi (yedek protokol). payload yerinde ayrıştırılır
+    // ve değiştirilir; çağrıdan sonra içeriği kullanılmamalı
+    void handleText(uint8_t client, uint8_t* payload, size_t length, uint32_t rxCycles);
+    
+    // Sabit düzenli ikili çerçeve (DriveProtocol). OP_DRIVE hemen
+    // uygulanmaz, gelen kutusuna alınır; bkz. flush(). OP_MANEUVER
+    // değişken boyutludur ve manevra yürütücüsüne aktarılır.
+    void handleBinary(uint8_t client, const uint8_t* payload, size_t length, uint32_t rxCycles);
+    
+    // Ağ servisi bittikten sonra, loop() geçişi başına bir kez: bekleyen
+    // sürüş çerçevelerinden yalnızca en yenisini uygular, manevra
+    // ilerlemesi değiştiyse olay gönderir
+    void flush();
+    
+    // /control?cmd=... komutları ("F", "B", "SPD:200" ...); bilinmiyorsa false
+    bool handleControl(const char* command, uint32_t rxCycles);
+    
+    LatencyStats& getLatencyStats() { return latency; }
+    const DriveInbox& getDriveInbox() const { return inbox; }
+    
+    // Uygulanmadan atılan ikili sürüş çerçeveleri (üzerine yazılan + sırasız + bayat)
+    uint32_t droppedFrames() const;
+};
+
+#endif
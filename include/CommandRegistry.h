@@ -0,0 +1,171 @@
+#ifndef COMMAND_REGISTRY_H
+#define COMMAND_REGISTRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Metin komut kaydı: /control?cmd=... ve WebSocket JSON yolunun ortak
+// token -> komut tablosu.
+//
+// Tablolar derleme zamanında sabittir ve strcmp sırasıyla dizilidir
+// (static_assert ile denetlenir); arama ikili aramadır, 33 token için en
+// fazla 6 karşılaştırma. Komut eklemek sıcak yolu uzatmaz. Her token bir
+// CommandId'ye ve argüman şemasına eşlenir; kimlik -> işleyici bağlaması
+// CommandProcessor.cpp'deki HANDLERS tablosundadır. Bu başlık Arduino'ya
+// bağımlı değildir (tools/bench_dispatch.cpp host'ta ölçer).
+namespace CommandRegistry {
+
+enum CommandId : uint8_t {
+    FORWARD,
+    BACKWARD,
+    TURN_LEFT,
+    TURN_RIGHT,
+    FORWARD_LEFT,
+    FORWARD_RIGHT,
+    BACKWARD_LEFT,
+    BACKWARD_RIGHT,
+    PIVOT_LEFT,
+    PIVOT_RIGHT,
+    STOP,
+    SET_SPEED,
+    DRIVE,
+    DRIVE_MIXED,
+    SET_MIX_MODE,
+    SET_CURVE,
+    MOVE,           // Alt token "direction" ile COMMANDS'ta çözülür
+    SOUND,          // Alt token "action" ile SOUND_ACTIONS'ta çözülür
+    HORN,
+    SIREN,
+    SONG_NEXT,
+    SOUND_STOP,
+    PARAM_SET,
+    PARAMS,         // Alt token "action" ile PARAM_ACTIONS'ta çözülür
+    PARAMS_APPLY,
+    PARAMS_SAVE,
+    PARAMS_REVERT,
+    PARAMS_DEFAULTS,
+    KEEPALIVE,      // Yalnızca bekçiyi besler (değişimde gönderen JSON/HTTP istemcileri)
+    COMMAND_COUNT
+};
+
+enum ArgSchema : uint8_t {
+    ARG_NONE,
+    ARG_VALUE,          // JSON "value" ya da HTTP "TOKEN:<sayı>"
+    ARG_LEFT_RIGHT,     // JSON "left", "right"
+    ARG_THROTTLE_STEER, // JSON "throttle", "steer"
+    ARG_DIRECTION,      // JSON "direction" (yalnızca ARG_NONE komutları)
+    ARG_ACTION,         // JSON "action" (SOUND_ACTIONS)
+    ARG_PARAM,          // JSON "name", "value" (sayı ya da metin)
+    ARG_PARAM_ACTION    // JSON "action" (PARAM_ACTIONS)
+};
+
+struct Entry {
+    const char* token;
+    CommandId id;
+    ArgSchema args;
+};
+
+// HTTP kısa kodları ve JSON "cmd"/"direction" değerleri (ASCII: büyük harf önce)
+constexpr Entry COMMANDS[] = {
+    { "B",              BACKWARD,       ARG_NONE },
+    { "BL",             BACKWARD_LEFT,  ARG_NONE },
+    { "BR",             BACKWARD_RIGHT, ARG_NONE },
+    { "F",              FORWARD,        ARG_NONE },
+    { "FL",             FORWARD_LEFT,   ARG_NONE },
+    { "FR",             FORWARD_RIGHT,  ARG_NONE },
+    { "L",              TURN_LEFT,      ARG_NONE },
+    { "PL",             PIVOT_LEFT,     ARG_NONE },
+    { "PR",             PIVOT_RIGHT,    ARG_NONE },
+    { "R",              TURN_RIGHT,     ARG_NONE },
+    { "S",              STOP,           ARG_NONE },
+    { "SPD",            SET_SPEED,      ARG_VALUE },
+    { "backward",       BACKWARD,       ARG_NONE },
+    { "backward_left",  BACKWARD_LEFT,  ARG_NONE },
+    { "backward_right", BACKWARD_RIGHT, ARG_NONE },
+    { "custom",         DRIVE,          ARG_LEFT_RIGHT },
+    { "drive",          DRIVE_MIXED,    ARG_THROTTLE_STEER },
+    { "expo",           SET_CURVE,      ARG_VALUE },
+    { "forward",        FORWARD,        ARG_NONE },
+    { "forward_left",   FORWARD_LEFT,   ARG_NONE },
+    { "forward_right",  FORWARD_RIGHT,  ARG_NONE },
+    { "ka",             KEEPALIVE,      ARG_NONE },
+    { "left",           TURN_LEFT,      ARG_NONE },
+    { "mix",            SET_MIX_MODE,   ARG_VALUE },
+    { "move",           MOVE,           ARG_DIRECTION },
+    { "param",          PARAM_SET,      ARG_PARAM },
+    { "params",         PARAMS,         ARG_PARAM_ACTION },
+    { "pivot_left",     PIVOT_LEFT,     ARG_NONE },
+    { "pivot_right",    PIVOT_RIGHT,    ARG_NONE },
+    { "right",          TURN_RIGHT,     ARG_NONE },
+    { "sound",          SOUND,          ARG_ACTION },
+    { "speed",          SET_SPEED,      ARG_VALUE },
+    { "stop",           STOP,           ARG_NONE },
+};
+
+// JSON {"cmd":"sound","action":...}
+constexpr Entry SOUND_ACTIONS[] = {
+    { "horn",      HORN,       ARG_NONE },
+    { "siren",     SIREN,      ARG_NONE },
+    { "song_next", SONG_NEXT,  ARG_NONE },
+    { "stop",      SOUND_STOP, ARG_NONE },
+};
+
+// JSON {"cmd":"params","action":...}: gölge setin yayını / kaydı
+constexpr Entry PARAM_ACTIONS[] = {
+    { "apply",    PARAMS_APPLY,    ARG_NONE },
+    { "defaults", PARAMS_DEFAULTS, ARG_NONE },
+    { "revert",   PARAMS_REVERT,   ARG_NONE },
+    { "save",     PARAMS_SAVE,     ARG_NONE },
+};
+
+// a[0..length) ile sıfır sonlu b'yi strcmp sırasıyla karşılaştırır
+constexpr int compare(const char* a, size_t length, const char* b) {
+    size_t i = 0;
+    for (; i < length && b[i] != '\0'; i++) {
+        if (a[i] != b[i]) return (uint8_t)a[i] < (uint8_t)b[i] ? -1 : 1;
+    }
+    if (i < length) return 1;
+    return b[i] == '\0' ? 0 : -1;
+}
+
+constexpr size_t length(const char* s) {
+    size_t n = 0;
+    while (s[n] != '\0') n++;
+    return n;
+}
+
+template <size_t N>
+constexpr bool isSorted(const Entry (&table)[N]) {
+    for (size_t i = 1; i < N; i++) {
+        if (compare(table[i - 1].token, length(table[i - 1].token), table[i].token) >= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isSorted(COMMANDS), "COMMANDS strcmp sırasında ve tekil olmalı");
+static_assert(isSorted(SOUND_ACTIONS), "SOUND_ACTIONS strcmp sırasında ve tekil olmalı");
+static_assert(isSorted(PARAM_ACTIONS), "PARAM_ACTIONS strcmp sırasında ve tekil olmalı");
+
+// token[0..length) için ikili arama; bulunamazsa nullptr
+template <size_t N>
+inline const Entry* find(const Entry (&table)[N], const char* token, size_t length) {
+    size_t lo = 0;
+    size_t hi = N;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        int c = compare(token, length, table[mid].token);
+        if (c == 0) return &table[mid];
+        if (c < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return nullptr;
+}
+
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef CONTROL_TIMER_H
+#define CONTROL_TIMER_H
+
+#include <stdint.h>
+
+// micros() tabanlı sabit periyotlu zamanlayıcı.
+//
+// loop() her geçişte poll() çağırır; bir tick zamanı geldiyse true döner.
+// Zamanlama sapması (jitter) ve tamamen kaçırılan tick'ler ölçülür.
+// Kaçırılan tick'ler telafi edilmez (burst yok), bir sonraki periyoda
+// hizalanılır. Saat taşması (wrap) işaretli fark ile güvenle ele alınır.
+class ControlTimer {
+private:
+    uint32_t periodUs;
+    uint32_t nextDueUs = 0;
+    bool started = false;
+
+    uint32_t ticks = 0;
+    uint32_t missedTicks = 0;
+    uint32_t maxJitterUs = 0;
+    uint64_t totalJitterUs = 0;
+
+public:
+    explicit ControlTimer(uint32_t periodUs = 0) : periodUs(periodUs) {}
+
+    bool poll(uint32_t nowUs) {
+        if (!started) {
+            started = true;
+            nextDueUs = nowUs;
+        }
+
+        int32_t late = (int32_t)(nowUs - nextDueUs);
+        if (late < 0) return false;
+
+        uint32_t skipped = (uint32_t)late / periodUs;
+        uint32_t jitter = (uint32_t)late - skipped * periodUs;
+
+        missedTicks += skipped;
+        nextDueUs += (skipped + 1) * periodUs;
+
+        ticks++;
+        totalJitterUs += jitter;
+        if (jitter > maxJitterUs) maxJitterUs = jitter;
+        return true;
+    }
+
+    void resetStats() {
+        ticks = 0;
+        missedTicks = 0;
+        maxJitterUs = 0;
+        totalJitterUs = 0;
+    }
+
+    uint32_t getPeriodUs() const { return periodUs; }
+    uint32_t getTicks() const { return ticks; }
+    uint32_t getMissedTicks() const { return missedTicks; }
+    uint32_t getMaxJitterUs() const { return maxJitterUs; }
+    uint32_t getAvgJitterUs() const { return ticks ? (uint32_t)(totalJitterUs / ticks) : 0; }
+};
+
+#endif
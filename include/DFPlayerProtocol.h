@@ -0,0 +1,100 @@
+#ifndef DFPLAYER_PROTOCOL_H
+#define DFPLAYER_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// DFPlayer Mini seri protokolü (9600 8N1)
+//
+// Her paket 10 byte'tır, iki yönde de aynı yerleşim:
+//   [0]    0x7E başlangıç
+//   [1]    0xFF sürüm
+//   [2]    0x06 uzunluk
+//   [3]    komut
+//   [4]    geri bildirim (1: modül 0x41 ACK göndersin)
+//   [5..6] parametre (big-endian)
+//   [7..8] sağlama: -(bayt 1..6 toplamı), big-endian
+//   [9]    0xEF bitiş
+namespace DFPlayerProtocol {
+
+const size_t PACKET_SIZE = 10;
+
+enum Command : uint8_t {
+    CMD_PLAY_TRACK   = 0x03,   // Parametre: parça no (1..2999)
+    CMD_VOLUME       = 0x06,   // 0..30
+    CMD_EQ           = 0x07,   // 0: normal
+    CMD_RESET        = 0x0C,
+    CMD_STOP         = 0x16,
+
+    // Modül -> ESP
+    EVT_TRACK_DONE_U = 0x3C,   // U-disk parçası bitti
+    EVT_TRACK_DONE   = 0x3D,   // SD kart parçası bitti
+    EVT_ONLINE       = 0x3F,   // Açılış/reset tamam; parametre: cihaz maskesi
+    EVT_ERROR        = 0x40,   // Parametre: hata kodu (1: meşgul/başlatılıyor)
+    EVT_ACK          = 0x41
+};
+
+const uint16_t ERROR_BUSY = 1;
+
+struct Packet {
+    uint8_t command;
+    uint8_t feedback;
+    uint16_t param;
+};
+
+inline uint16_t checksum(const uint8_t* p) {
+    uint16_t sum = 0;
+    for (uint8_t i = 1; i < 7; i++) sum += p[i];
+    return (uint16_t)(0 - sum);
+}
+
+inline void encode(const Packet& packet, uint8_t* out) {
+    out[0] = 0x7E;
+    out[1] = 0xFF;
+    out[2] = 0x06;
+    out[3] = packet.command;
+    out[4] = packet.feedback;
+    out[5] = (uint8_t)(packet.param >> 8);
+    out[6] = (uint8_t)(packet.param & 0xFF);
+    uint16_t sum = checksum(out);
+    out[7] = (uint8_t)(sum >> 8);
+    out[8] = (uint8_t)(sum & 0xFF);
+    out[9] = 0xEF;
+}
+
+// Bayt bayt gelen akıştan paket çıkarır; bozuk paketleri atıp başlangıç
+// baytında yeniden hizalanır. Heap ya da bekleme yok.
+class Parser {
+private:
+    uint8_t buf[PACKET_SIZE];
+    uint8_t length = 0;
+    uint32_t errors = 0;
+
+public:
+    // Paket tamamlandıysa true döner ve packet doldurulur
+    bool push(uint8_t value, Packet& packet) {
+        if (length == 0 && value != 0x7E) {
+            errors++;
+            return false;
+        }
+        buf[length++] = value;
+        if (length < PACKET_SIZE) return false;
+        length = 0;
+
+        uint16_t sum = (uint16_t)((buf[7] << 8) | buf[8]);
+        if (buf[1] != 0xFF || buf[2] != 0x06 || buf[9] != 0xEF || sum != checksum(buf)) {
+            errors++;
+            return false;
+        }
+        packet.command = buf[3];
+        packet.feedback = buf[4];
+        packet.param = (uint16_t)((buf[5] << 8) | buf[6]);
+        return true;
+    }
+
+    uint32_t getErrors() const { return errors; }
+};
+
+}
+
+#endif
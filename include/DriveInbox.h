@@ -0,0 +1,183 @@
+#ifndef DRIVE_INBOX_H
+#define DRIVE_INBOX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "DriveProtocol.h"
+#include "LatencyStats.h"
+
+// Sürüş çerçevesi gelen kutusu: döngü geçişi başına yalnızca en yeni çerçeve.
+//
+// WiFi takıldığında TCP biriken joystick çerçevelerini art arda teslim eder;
+// hepsini sırayla uygulamak aracı saniyeler önceki direksiyonla sürer.
+// Çerçeveler burada toplanır, loop() geçişinin sonunda yalnızca en yenisi
+// motora gider; üzerine yazılanlar sayılır.
+//
+// - seq (uint16, sarmaya dayanıklı) son kabul edilenden yeni değilse
+//   çerçeve sırası bozuk/tekrar sayılıp atılır.
+// - Yaş, istemci damgasıyla göreli tek yön gecikmesidir: saatler ortak
+//   olmadığından (alım_ms - damga) farkının son iki penceredeki en küçüğü
+//   taban alınır, yaş = fark - taban (kuyrukta bekleme süresi). Yaşı
+//   staleMs'yi aşan sürüş çerçevesi bayat sayılıp uygulanmaz.
+// - seq ve taban istemci başına tutulur (MAX_CLIENTS: 4 WebSocket slotu +
+//   UDP). Araya giren başka istemcinin çerçeveleri (ör. WebSocket
+//   keepalive'ı) UDP sürücüsünün sırası/yaş tabanını sıfırlamaz.
+class DriveInbox {
+public:
+    enum Verdict : uint8_t {
+        FRESH,
+        REORDERED,      // seq eski ya da tekrar
+        STALE           // Kuyrukta staleMs'den uzun beklemiş
+    };
+
+    static const uint32_t DEFAULT_STALE_MS = 500;
+    static const uint32_t BASELINE_WINDOW_MS = 10000;
+    static const uint8_t MAX_CLIENTS = 5;       // WebServerManager::MAX_WS_CLIENTS + UDP
+
+private:
+    DriveProtocol::Frame pending = {};
+    LatencyTrace pendingTrace = {};
+    bool hasPending = false;
+
+    // İstemci başına seq ve yaş tabanı
+    struct Track {
+        bool active;
+        uint8_t client;
+        uint16_t lastSeq;
+        int32_t windowMin;
+        int32_t prevWindowMin;
+        uint32_t windowStart;
+        uint32_t lastRxMs;
+    };
+    Track tracks[MAX_CLIENTS] = {};
+
+    uint32_t staleMs = DEFAULT_STALE_MS;
+
+    uint32_t received = 0;
+    uint32_t applied = 0;
+    uint32_t superseded = 0;
+    uint32_t reordered = 0;
+    uint32_t stale = 0;
+    LatencyHistogram ages;  // ms
+
+    static uint32_t ageOf(Track& track, uint32_t stamp, uint32_t rxMs) {
+        int32_t offset = (int32_t)(rxMs - stamp);
+
+        if (rxMs - track.windowStart >= BASELINE_WINDOW_MS) {
+            track.prevWindowMin = track.windowMin;
+            track.windowMin = offset;
+            track.windowStart = rxMs;
+        } else if (offset < track.windowMin) {
+            track.windowMin = offset;
+        }
+
+        int32_t baseline = track.windowMin < track.prevWindowMin ? track.windowMin : track.prevWindowMin;
+        return offset > baseline ? (uint32_t)(offset - baseline) : 0;
+    }
+
+    // İstemcinin takibi; yoksa boş ya da en uzun süredir sessiz yuva
+    // yeniden öğrenilmek üzere verilir
+    Track& trackOf(uint8_t client, const DriveProtocol::Frame& frame, uint32_t rxMs) {
+        Track* victim = &tracks[0];
+        for (Track& track : tracks) {
+            if (track.active && track.client == client) return track;
+            if (victim->active && (!track.active || rxMs - track.lastRxMs > rxMs - victim->lastRxMs)) {
+                victim = &track;
+            }
+        }
+        victim->active = true;
+        victim->client = client;
+        victim->lastSeq = (uint16_t)(frame.seq - 1);
+        victim->windowMin = victim->prevWindowMin = (int32_t)(rxMs - frame.stamp);
+        victim->windowStart = rxMs;
+        return *victim;
+    }
+
+public:
+    void setStaleMs(uint32_t ms) { staleMs = ms; }
+
+    // İstemci bağlandı/ayrıldı ya da yeni oturum açtı: yalnızca onun seq ve
+    // yaş tabanı yeniden öğrenilir; bekleyen çerçeve atılır
+    void reset(uint8_t client) {
+        for (Track& track : tracks) {
+            if (track.active && track.client == client) track.active = false;
+        }
+        hasPending = false;
+    }
+
+    // Her ikili çerçeve için (opcode fark etmeksizin) seq ve yaşı değerlendir
+    Verdict observe(uint8_t client, const DriveProtocol::Frame& frame, uint32_t rxMs) {
+        received++;
+
+        Track& track = trackOf(client, frame, rxMs);
+        track.lastRxMs = rxMs;
+
+        if ((int16_t)(frame.seq - track.lastSeq) <= 0) {
+            reordered++;
+            return REORDERED;
+        }
+        track.lastSeq = frame.seq;
+
+        uint32_t age = ageOf(track, frame.stamp, rxMs);
+        ages.record(age);
+        if (age > staleMs) {
+            stale++;
+            return STALE;
+        }
+        return FRESH;
+    }
+
+    // Taze sürüş çerçevesini beklemeye al; öncekinin üzerine yazar
+    void offer(const DriveProtocol::Frame& frame, const LatencyTrace& trace) {
+        if (hasPending) superseded++;
+        pending = frame;
+        pendingTrace = trace;
+        hasPending = true;
+    }
+
+    // Bekleyen sürüş çerçevesini at (ör. ardından STOP geldi)
+    void discard() {
+        if (hasPending) superseded++;
+        hasPending = false;
+    }
+
+    // loop() geçişinin sonunda: en yeni çerçeveyi al
+    bool take(DriveProtocol::Frame& frame, LatencyTrace& trace) {
+        if (!hasPending) return false;
+        frame = pending;
+        trace = pendingTrace;
+        hasPending = false;
+        applied++;
+        return true;
+    }
+
+    uint32_t getReceived() const { return received; }
+    uint32_t getApplied() const { return applied; }
+    uint32_t getSuperseded() const { return superseded; }
+    uint32_t getReordered() const { return reordered; }
+    uint32_t getStale() const { return stale; }
+    const LatencyHistogram& getAges() const { return ages; }
+
+    void resetStats() {
+        received = applied = superseded = reordered = stale = 0;
+        ages.reset();
+    }
+
+    // {"rx":..,"applied":..,"superseded":..,"reordered":..,"stale":..,
+    //  "age_p50":..,"age_p99":..,"age_max":..} (yaşlar ms)
+    size_t writeJson(char* buf, size_t size) const {
+        if (size == 0) return 0;
+        int n = snprintf(buf, size,
+                         "{\"rx\":%u,\"applied\":%u,\"superseded\":%u,\"reordered\":%u,"
+                         "\"stale\":%u,\"age_p50\":%u,\"age_p99\":%u,\"age_max\":%u}",
+                         (unsigned)received, (unsigned)applied, (unsigned)superseded,
+                         (unsigned)reordered, (unsigned)stale,
+                         (unsigned)ages.percentile(50), (unsigned)ages.percentile(99),
+                         (unsigned)ages.max());
+        if (n < 0) return 0;
+        return (size_t)n < size ? (size_t)n : size - 1;
+    }
+};
+
+#endif
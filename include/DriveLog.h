@@ -0,0 +1,201 @@
+#ifndef DRIVE_LOG_H
+#define DRIVE_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Sürüş kaydı dosya biçimi (cihaz: DriveRecorder, host: tools/drive_replay.cpp)
+//
+// Dosya BLOCK_SIZE baytlık bloklardan oluşan bir halkadır; blok indeksi
+// seq % blok sayısı. Her blok kendi başına çözülebilir: başlıkta bloğun
+// başlangıç durumu (zaman, sol/sağ) mutlak tutulur, kayıtlar buna göre
+// farktır. Halka sarınca en eski blok ezilir, kalanlar okunabilir kalır.
+//
+// Blok başlığı (little-endian, 16 byte):
+//   [0]      MAGIC
+//   [1]      used     (başlıktan sonraki kayıt baytı)
+//   [2..3]   session  (uint16, her kayıt başlangıcında artar)
+//   [4..7]   seq      (uint32, oturumlar boyunca artan blok sayacı)
+//   [8..11]  t0       (uint32, oturum başından ms)
+//   [12..13] left0    (int16, bloktan önceki son sol PWM)
+//   [14..15] right0   (int16)
+//
+// Kayıt: varint((dt << 3) | source), zigzag varint(dLeft), zigzag varint(dRight)
+//   dt: önceki kayıttan ms, source: LatencyStats CommandType ya da SOURCE_STOP.
+//   Tipik joystick kaydı 3-5 bayt.
+namespace DriveLog {
+
+const size_t BLOCK_SIZE = 256;
+const size_t HEADER_SIZE = 16;
+const size_t MAX_RECORD_SIZE = 5 + 3 + 3;
+const uint8_t MAGIC = 0xD5;
+
+const uint8_t SOURCE_BITS = 3;
+const uint8_t SOURCE_STOP = 7;          // Acil durdurma (rampasız)
+const uint32_t MAX_DT_MS = (1UL << (32 - SOURCE_BITS)) - 1;
+
+struct Record {
+    uint32_t t;             // Oturum başından ms
+    int16_t left;
+    int16_t right;
+    uint8_t source;
+};
+
+struct Header {
+    uint8_t used;
+    uint16_t session;
+    uint32_t seq;
+    uint32_t t0;
+    int16_t left0;
+    int16_t right0;
+};
+
+inline uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+inline int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+inline size_t writeVarint(uint8_t* p, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+// Taşma/bozuk girdide false
+inline bool readVarint(const uint8_t* p, size_t length, size_t& pos, uint32_t& out) {
+    out = 0;
+    for (uint8_t shift = 0; shift < 35 && pos < length; shift += 7) {
+        uint8_t b = p[pos++];
+        out |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+inline void writeHeader(uint8_t* block, const Header& h) {
+    block[0] = MAGIC;
+    block[1] = h.used;
+    block[2] = (uint8_t)h.session;
+    block[3] = (uint8_t)(h.session >> 8);
+    for (uint8_t i = 0; i < 4; i++) {
+        block[4 + i] = (uint8_t)(h.seq >> (8 * i));
+        block[8 + i] = (uint8_t)(h.t0 >> (8 * i));
+    }
+    block[12] = (uint8_t)h.left0;
+    block[13] = (uint8_t)((uint16_t)h.left0 >> 8);
+    block[14] = (uint8_t)h.right0;
+    block[15] = (uint8_t)((uint16_t)h.right0 >> 8);
+}
+
+// Başlık geçersizse (boş/silinmiş blok: 0xFF) false
+inline bool readHeader(const uint8_t* block, Header& h) {
+    if (block[0] != MAGIC || block[1] > BLOCK_SIZE - HEADER_SIZE) return false;
+    h.used = block[1];
+    h.session = (uint16_t)(block[2] | (block[3] << 8));
+    h.seq = 0;
+    h.t0 = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        h.seq |= (uint32_t)block[4 + i] << (8 * i);
+        h.t0 |= (uint32_t)block[8 + i] << (8 * i);
+    }
+    h.left0 = (int16_t)(block[12] | (block[13] << 8));
+    h.right0 = (int16_t)(block[14] | (block[15] << 8));
+    return true;
+}
+
+// Bir bloğu doldurur; başlık seal() ile yazılır
+class BlockWriter {
+private:
+    uint8_t* block = nullptr;
+    Header header = {};
+    size_t pos = HEADER_SIZE;
+    Record last = {};
+
+public:
+    void begin(uint8_t* buffer, uint16_t session, uint32_t seq, const Record& state) {
+        block = buffer;
+        header.used = 0;
+        header.session = session;
+        header.seq = seq;
+        header.t0 = state.t;
+        header.left0 = state.left;
+        header.right0 = state.right;
+        pos = HEADER_SIZE;
+        last = state;
+    }
+
+    // Yer yoksa false (blok kapatılıp yenisi açılmalı)
+    bool append(const Record& r) {
+        if (pos + MAX_RECORD_SIZE > BLOCK_SIZE) return false;
+        uint32_t dt = r.t - last.t;
+        if (dt > MAX_DT_MS) dt = MAX_DT_MS;
+        pos += writeVarint(block + pos, (dt << SOURCE_BITS) | (r.source & 0x07));
+        pos += writeVarint(block + pos, zigzag((int32_t)r.left - last.left));
+        pos += writeVarint(block + pos, zigzag((int32_t)r.right - last.right));
+        // Çözücüyle aynı zaman: dt kırpıldıysa kayıt o kadar kayar
+        uint32_t t = last.t + dt;
+        last = r;
+        last.t = t;
+        return true;
+    }
+
+    // Başlığı yazar; blok (kısmen dolu da olsa) diske yazılmaya hazır
+    void seal() {
+        header.used = (uint8_t)(pos - HEADER_SIZE);
+        writeHeader(block, header);
+    }
+
+    bool empty() const { return pos == HEADER_SIZE; }
+    size_t size() const { return pos; }
+    const Header& getHeader() const { return header; }
+    const Record& lastRecord() const { return last; }
+};
+
+// Bir bloğun kayıtlarını sırayla çözer
+class BlockReader {
+private:
+    const uint8_t* block = nullptr;
+    size_t end = 0;
+    size_t pos = 0;
+    Record last = {};
+
+public:
+    bool begin(const uint8_t* buffer, Header& header) {
+        if (!readHeader(buffer, header)) return false;
+        block = buffer;
+        pos = HEADER_SIZE;
+        end = HEADER_SIZE + header.used;
+        last.t = header.t0;
+        last.left = header.left0;
+        last.right = header.right0;
+        last.source = 0;
+        return true;
+    }
+
+    bool next(Record& out) {
+        if (pos >= end) return false;
+        uint32_t head, dl, dr;
+        if (!readVarint(block, end, pos, head) || !readVarint(block, end, pos, dl) ||
+            !readVarint(block, end, pos, dr)) {
+            pos = end;
+            return false;
+        }
+        last.t += head >> SOURCE_BITS;
+        last.source = (uint8_t)(head & 0x07);
+        last.left = (int16_t)(last.left + unzigzag(dl));
+        last.right = (int16_t)(last.right + unzigzag(dr));
+        out = last;
+        return true;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef DRIVE_MIXER_H
+#define DRIVE_MIXER_H
+
+#include <stdint.h>
+
+// Q15 sabit nokta yardımcıları: -32767..32767 = -1.0..1.0
+//
+// Kablo (WebSocket/JSON) aralığı -1000..1000'dir; motor çıkışı PWM
+// birimidir. Ölçekleme yalnızca çarpma ve kaydırmayla yapılır (FPU'suz
+// çekirdekte bölme ve float yok).
+namespace q15 {
+
+const int16_t ONE = 32767;
+const int16_t WIRE_MAX = 1000;
+
+inline int16_t saturate(int32_t v) {
+    if (v > ONE) return ONE;
+    if (v < -ONE) return -ONE;
+    return (int16_t)v;
+}
+
+// a * b (ikisi de Q15), yuvarlamalı
+inline int16_t mul(int16_t a, int16_t b) {
+    return saturate(((int32_t)a * b + (1 << 14)) >> 15);
+}
+
+// -1000..1000 -> Q15. 32768/1000 = 536871 / 2^14
+inline int16_t fromWire(int32_t v) {
+    if (v > WIRE_MAX) v = WIRE_MAX;
+    if (v < -WIRE_MAX) v = -WIRE_MAX;
+    return saturate((v * 536871) >> 14);
+}
+
+// Q15 -> -full..full (ör. PWM_MAX ya da varsayılan hız), yuvarlamalı
+inline int16_t scale(int16_t v, int16_t full) {
+    return (int16_t)(((int32_t)v * full + (1 << 14)) >> 15);
+}
+
+// Derleme zamanı sabiti: Q(0.5) == 16384
+constexpr int16_t Q(double v) {
+    return (int16_t)(v * 32767 + (v < 0 ? -0.5 : 0.5));
+}
+
+}
+
+// Gaz/direksiyon -> sol/sağ teker karıştırıcı (Q15)
+//
+// Modlar:
+//  - ARCADE: sol = gaz + direksiyon, sağ = gaz - direksiyon; doygunlukta
+//    ikisi oranı koruyarak küçültülür
+//  - TANK: girdiler doğrudan sol ve sağ tekerdir
+//  - CURVATURE: direksiyon dönüş yarıçapını belirler (sol = gaz +
+//    |gaz| * direksiyon); gaz sıfıra yakınken yerinde döner
+// Direksiyon pozitifse sağa döner.
+//
+// Girdiler önce tepki eğrisinden geçer: derleme zamanında üretilen 33
+// noktalı tablo (expo: y = (1-k)x + kx^3), doğrusal aradeğerleme ile.
+// Eğri orta stick'i yumuşatır, uç değerleri (0 ve +-1) değiştirmez.
+class DriveMixer {
+public:
+    enum Mode : uint8_t {
+        ARCADE,
+        TANK,
+        CURVATURE,
+        MODE_COUNT
+    };
+
+    enum Curve : uint8_t {
+        CURVE_LINEAR,
+        CURVE_EXPO_30,
+        CURVE_EXPO_60,
+        CURVE_COUNT
+    };
+
+    static const uint8_t CURVE_SEGMENTS = 32;
+
+    struct CurveTable {
+        int16_t points[CURVE_SEGMENTS + 1];     // |x| = 0..1 için Q15
+    };
+
+    static constexpr CurveTable makeExpo(int percent) {
+        CurveTable table = {};
+        double k = percent / 100.0;
+        for (int i = 0; i <= CURVE_SEGMENTS; i++) {
+            double x = (double)i / CURVE_SEGMENTS;
+            table.points[i] = q15::Q((1 - k) * x + k * x * x * x);
+        }
+        return table;
+    }
+
+    // Gaz bu değerin altındayken CURVATURE yerinde döner (~%5)
+    static const int16_t QUICK_TURN_THRESHOLD = 1638;
+
+private:
+    Mode mode = ARCADE;
+    Curve curve = CURVE_LINEAR;
+
+    static const CurveTable& table(Curve c) {
+        static constexpr CurveTable TABLES[CURVE_COUNT] = {
+            makeExpo(0), makeExpo(30), makeExpo(60)
+        };
+        return TABLES[c < CURVE_COUNT ? c : CURVE_LINEAR];
+    }
+
+    static int16_t abs16(int16_t v) { return v < 0 ? (int16_t)-v : v; }
+
+    // Oranı koruyarak +-1'e sığdır (tek bölme, yalnızca doygunlukta)
+    static void desaturate(int32_t& left, int32_t& right) {
+        int32_t l = left < 0 ? -left : left;
+        int32_t r = right < 0 ? -right : right;
+        int32_t m = l > r ? l : r;
+        if (m <= q15::ONE) return;
+        left = left * q15::ONE / m;
+        right = right * q15::ONE / m;
+    }
+
+public:
+    void setMode(Mode m) { mode = m < MODE_COUNT ? m : ARCADE; }
+    Mode getMode() const { return mode; }
+    void setCurve(Curve c) { curve = c < CURVE_COUNT ? c : CURVE_LINEAR; }
+    Curve getCurve() const { return curve; }
+
+    // Tepki eğrisi (işaret simetrik)
+    static int16_t shape(Curve c, int16_t x) {
+        if (c == CURVE_LINEAR) return x;
+        const CurveTable& t = table(c);
+        int16_t ax = abs16(x);
+        int16_t y;
+        if (ax >= q15::ONE) {
+            y = t.points[CURVE_SEGMENTS];
+        } else {
+            uint8_t i = (uint8_t)(ax >> 10);                // 32767 / 32 dilim
+            int32_t frac = ax & 0x3FF;
+            y = (int16_t)(t.points[i] + (((t.points[i + 1] - t.points[i]) * frac) >> 10));
+        }
+        return x < 0 ? (int16_t)-y : y;
+    }
+
+    static void arcade(int16_t throttle, int16_t steer, int16_t& left, int16_t& right) {
+        int32_t l = (int32_t)throttle + steer;
+        int32_t r = (int32_t)throttle - steer;
+        desaturate(l, r);
+        left = (int16_t)l;
+        right = (int16_t)r;
+    }
+
+    static void curvature(int16_t throttle, int16_t steer, int16_t& left, int16_t& right) {
+        if (abs16(throttle) < QUICK_TURN_THRESHOLD) {
+            left = steer;
+            right = (int16_t)-steer;
+            return;
+        }
+        int16_t turn = q15::mul(abs16(throttle), steer);
+        int32_t l = (int32_t)throttle + turn;
+        int32_t r = (int32_t)throttle - turn;
+        desaturate(l, r);
+        left = (int16_t)l;
+        right = (int16_t)r;
+    }
+
+    // Seçili mod ve eğriyle karıştır. TANK'ta a = sol, b = sağ; diğerlerinde
+    // a = gaz, b = direksiyon. Girdi ve çıktı Q15.
+    void mix(int16_t a, int16_t b, int16_t& left, int16_t& right) const {
+        a = shape(curve, a);
+        b = shape(curve, b);
+        switch (mode) {
+            case TANK:
+                left = a;
+                right = b;
+                break;
+            case CURVATURE:
+                curvature(a, b, left, right);
+                break;
+            default:
+                arcade(a, b, left, right);
+                break;
+        }
+    }
+};
+
+#endif
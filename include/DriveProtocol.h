@@ -0,0 +1,116 @@
+#ifndef DRIVE_PROTOCOL_H
+#define DRIVE_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// İkili (binary) WebSocket sürüş protokolü
+//
+// JSON yolunun aksine her çerçeve sabit boyutludur ve doğrudan payload
+// tamponundan çözülür; String/JsonDocument ya da heap tahsisi yoktur.
+//
+// Çerçeve yerleşimi (little-endian, 12 byte):
+//   [0]     opcode
+//   [1]     flags
+//   [2..3]  seq   (uint16, istemci her çerçevede artırır)
+//   [4..5]  left  (int16)
+//   [6..7]  right (int16)
+//   [8..11] stamp (uint32, istemcinin gönderim anı, ms; ACK'te aynen döner)
+namespace DriveProtocol {
+
+const size_t FRAME_SIZE = 12;
+
+// Manevra yüklemesi (OP_MANEUVER, ManeuverRunner):
+//   [0]     OP_MANEUVER
+//   [1]     flags
+//   [2..3]  seq
+//   [4]     count  (segment sayısı)
+//   [5]     repeat (ek tur sayısı)
+//   sonra count x 7 byte: kind(u8), a(i16), b(i16), duration_ms(u16)
+const size_t MANEUVER_HEADER_SIZE = 6;
+const size_t MANEUVER_SEGMENT_SIZE = 7;
+
+// UDP kontrol datagramı (UdpControl): [0..3] oturum belirteci (uint32) +
+// 12 byte çerçeve. Sunucunun OP_ACK'i aynı biçimde, aynı belirteçle döner.
+const size_t UDP_TOKEN_SIZE = 4;
+const size_t UDP_PACKET_SIZE = UDP_TOKEN_SIZE + FRAME_SIZE;
+
+enum Opcode : uint8_t {
+    OP_DRIVE     = 0x01,   // left/right: -1000..1000 (JSON "custom" ile aynı)
+    OP_STOP      = 0x02,   // left/right kullanılmaz
+    OP_SPEED     = 0x03,   // left: 0..255 varsayılan hız
+    OP_KEEPALIVE = 0x04,   // Girdi yokken bağlantı canlılığı; motora dokunmaz
+    OP_MIX       = 0x05,   // left: gaz, right: direksiyon (-1000..1000, DriveMixer)
+    OP_MANEUVER  = 0x06,   // Değişken boyutlu manevra yüklemesi (aşağıda); decode() almaz
+    OP_ACK       = 0x81    // Sunucu -> istemci: seq/stamp aynen, left: hız,
+                           // right: sunucuda atılan sürüş çerçevesi sayısı
+};
+
+enum Flags : uint8_t {
+    FLAG_ACK_REQUEST = 0x01,  // İstemci bu çerçeve için ACK istiyor
+    FLAG_FAULT       = 0x02   // Sunucu -> istemci (ACK): bekçi aracı durdurdu
+};
+
+struct Frame {
+    uint8_t opcode;
+    uint8_t flags;
+    uint16_t seq;
+    int16_t left;
+    int16_t right;
+    uint32_t stamp;
+};
+
+inline uint16_t readU16(const uint8_t* p) {
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+inline void writeU16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)(v >> 8);
+}
+
+inline uint32_t readU32(const uint8_t* p) {
+    return (uint32_t)readU16(p) | ((uint32_t)readU16(p + 2) << 16);
+}
+
+inline void writeU32(uint8_t* p, uint32_t v) {
+    writeU16(p, (uint16_t)(v & 0xFFFF));
+    writeU16(p + 2, (uint16_t)(v >> 16));
+}
+
+// Çerçeveyi çözer; boyut ya da opcode geçersizse false döner
+inline bool decode(const uint8_t* buf, size_t length, Frame& out) {
+    if (buf == nullptr || length != FRAME_SIZE) return false;
+
+    out.opcode = buf[0];
+    out.flags = buf[1];
+    out.seq = readU16(buf + 2);
+    out.left = (int16_t)readU16(buf + 4);
+    out.right = (int16_t)readU16(buf + 6);
+    out.stamp = readU32(buf + 8);
+
+    switch (out.opcode) {
+        case OP_DRIVE:
+        case OP_STOP:
+        case OP_SPEED:
+        case OP_KEEPALIVE:
+        case OP_MIX:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Çerçeveyi buf'a yazar (buf en az FRAME_SIZE byte olmalı)
+inline void encode(const Frame& frame, uint8_t* buf) {
+    buf[0] = frame.opcode;
+    buf[1] = frame.flags;
+    writeU16(buf + 2, frame.seq);
+    writeU16(buf + 4, (uint16_t)frame.left);
+    writeU16(buf + 6, (uint16_t)frame.right);
+    writeU32(buf + 8, frame.stamp);
+}
+
+}
+
+#endif
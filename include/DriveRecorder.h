@@ -0,0 +1,138 @@
+#ifndef DRIVE_RECORDER_H
+#define DRIVE_RECORDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Hal.h"
+#include "DriveLog.h"
+#include "LatencyStats.h"
+
+class MotorController;
+
+// Sürüş oturumu kaydedici ve oynatıcı.
+//
+// Kayıt: MotorController'a uygulanan her hedef (sol/sağ PWM, kaynak)
+// onApplied() ile RAM'deki etkin bloğa delta/varint olarak eklenir (sıcak
+// yolda yalnızca birkaç bayt yazımı). Dolan blok kuyruğa alınır; flash'a
+// yazım yalnızca poll()'da (düşük öncelikli zamanlayıcı görevi), geçiş
+// başına en fazla bir blok olarak yapılır. Kısmi blok FLUSH_INTERVAL_MS'de
+// bir aynı yuvaya yeniden yazılır; güç kesilirse en fazla o kadar kayıp.
+// Kuyruk doluysa blok atılır ve sayılır (kontrol yolu hiç beklemez).
+//
+// Oynatma: son oturum, kayıttaki zamanlamayla (1x) ya da hızlandırılmış
+// olarak motor hedeflerine yeniden uygulanır; bekçi beslenir. Oynatma
+// sırasında canlı bir komut gelirse oynatma hemen bırakılır.
+//
+// HTTP geri çağrıları yalnızca istek bırakır (requestStart() vb.);
+// dosya işlemleri poll()'da yapılır.
+class DriveRecorder {
+public:
+    enum State : uint8_t {
+        UNAVAILABLE,    // Dosya sistemi yok
+        IDLE,
+        RECORDING,
+        REPLAYING
+    };
+
+    static constexpr const char* PATH = "/drive.log";
+    static const uint16_t BLOCK_COUNT = 128;            // 32 KB halka
+    static const uint32_t FLUSH_INTERVAL_MS = 2000;
+    static const uint8_t MAX_REPLAY_SPEED = 16;
+
+private:
+    static const uint8_t QUEUE_BLOCKS = 2;
+
+    enum Request : uint8_t {
+        REQ_NONE,
+        REQ_START,
+        REQ_STOP,
+        REQ_REPLAY
+    };
+
+    MotorController* motor;
+    hal::BlockFile* file = nullptr;
+    State state = UNAVAILABLE;
+
+    volatile uint8_t request = REQ_NONE;
+    volatile uint8_t requestedSpeed = 1;
+
+    // Etkin blok (kayıtta yazılan, oynatmada okunan) ve flash kuyruğu
+    uint8_t active[DriveLog::BLOCK_SIZE];
+    uint8_t queue[QUEUE_BLOCKS][DriveLog::BLOCK_SIZE];
+    uint8_t queueHead = 0;
+    uint8_t queueCount = 0;
+
+    DriveLog::BlockWriter writer;
+    uint16_t session = 0;       // Son (ya da süren) oturum
+    uint32_t nextSeq = 0;
+    uint32_t sessionStartMs = 0;
+    uint32_t lastFlushMs = 0;
+    bool activeDirty = false;
+
+    DriveLog::BlockReader reader;
+    DriveLog::Record pending = {};
+    bool hasPending = false;
+    uint32_t replaySeq = 0;
+    uint32_t replayEndSeq = 0;
+    uint32_t replayBaseMs = 0;
+    uint32_t replayT0 = 0;
+    uint8_t replaySpeed = 1;
+    bool applying = false;      // Oynatıcı motoru sürüyor (onApplied yoksayar)
+
+    // Metrikler
+    uint32_t records = 0;
+    uint32_t blocksWritten = 0;
+    uint32_t droppedBlocks = 0;
+    uint32_t writeErrors = 0;
+    uint32_t replayed = 0;
+    uint32_t replayAborts = 0;
+    LatencyHistogram writeUs;
+
+    uint16_t slotOf(uint32_t seq) const { return (uint16_t)(seq % BLOCK_COUNT); }
+    bool scanSession(uint16_t wanted, uint32_t& minSeq, uint32_t& maxSeq);
+
+    void startRecording(uint32_t nowMs);
+    void stopRecording();
+    void rotateBlock();
+    bool writeBlock(const uint8_t* block, size_t length);
+    void writeQueued();
+    void flushPartial(uint32_t nowMs);
+
+    void startReplay(uint32_t nowMs, uint8_t speed);
+    bool loadReplayBlock();
+    bool fetchReplay();
+    void stepReplay(uint32_t nowMs);
+    void finishReplay();
+
+public:
+    explicit DriveRecorder(MotorController* motorController);
+
+    // Blok dosyasını açar, son oturumu/seq'i bulur (açılışta bir kez)
+    void begin();
+
+    // Düşük öncelikli zamanlayıcı görevi: istekler, flash yazımı, oynatma
+    void poll(uint32_t nowMs);
+
+    // Dosya sistemi sökülmeden önce (OTA): süren kayıt ve kuyruk yazılır,
+    // oynatma bırakılır, dosya kapatılır; sonrası UNAVAILABLE
+    void end();
+
+    // MotorController her yeni hedefte çağırır (source: CommandType ya da
+    // DriveLog::SOURCE_STOP)
+    void onApplied(int16_t left, int16_t right, uint8_t source);
+
+    // Ağ geri çağrılarından güvenle çağrılabilir; poll()'da uygulanır
+    void requestStart() { request = REQ_START; }
+    void requestStop() { request = REQ_STOP; }
+    void requestReplay(uint8_t speed);
+
+    State getState() const { return state; }
+    static const char* stateName(State s);
+
+    // {"state":"..","session":..,"records":..,"blocks":..,"dropped":..,
+    //  "write_errors":..,"write_p99_us":..,"write_max_us":..,"replay_speed":..,
+    //  "replayed":..,"replay_aborts":..}
+    size_t writeJson(char* buf, size_t size) const;
+};
+
+#endif
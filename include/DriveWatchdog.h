@@ -0,0 +1,82 @@
+#ifndef DRIVE_WATCHDOG_H
+#define DRIVE_WATCHDOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Ölü adam (dead-man) bekçisi: araç hareket hâlindeyken timeout süresince
+// geçerli sürüş çerçevesi (ya da keepalive) gelmezse bir kez tetiklenir.
+// MotorController tetiklenince hedefi sıfırlar; araç rampayla yavaşlayıp
+// durur ve fault bayrağı bir sonraki geçerli çerçeveye kadar kalkmaz.
+//
+// Zaman aşımı bağlantı kalitesine uyarlanır:
+//   timeout = minTimeoutMs + rttMultiplier * SRTT, en fazla maxTimeoutMs
+// RTT ölçümü (WebSocket ping/pong) yokken maxTimeoutMs kullanılır.
+// minTimeoutMs istemci keepalive aralığından (250 ms) büyük olmalıdır.
+struct WatchdogConfig {
+    uint16_t minTimeoutMs;
+    uint16_t maxTimeoutMs;
+    uint8_t rttMultiplier;
+};
+
+class DriveWatchdog {
+private:
+    WatchdogConfig config = { 400, 1500, 4 };
+
+    uint32_t lastFeedMs = 0;
+    uint32_t srtt8 = 0;         // SRTT * 8 (ms), 0: ölçüm yok
+    bool fault = false;
+    uint32_t trips = 0;
+
+public:
+    void configure(const WatchdogConfig& cfg) { config = cfg; }
+
+    // Geçerli çerçeve geldi; fault bayrağını temizler
+    void feed(uint32_t nowMs) {
+        lastFeedMs = nowMs;
+        fault = false;
+    }
+
+    // Ping/pong gidiş-dönüş örneği (TCP tarzı 1/8 ağırlıklı ortalama)
+    void rttSample(uint32_t rttMs) {
+        if (srtt8 == 0) {
+            srtt8 = (rttMs ? rttMs : 1) * 8;
+        } else {
+            srtt8 = srtt8 - srtt8 / 8 + rttMs;
+        }
+    }
+
+    uint32_t rttMs() const { return srtt8 / 8; }
+
+    uint32_t timeoutMs() const {
+        if (srtt8 == 0) return config.maxTimeoutMs;
+        uint32_t t = config.minTimeoutMs + config.rttMultiplier * rttMs();
+        return t < config.maxTimeoutMs ? t : config.maxTimeoutMs;
+    }
+
+    // Kontrol tick'inde çağrılır; tetiklendiği tick'te bir kez true döner.
+    // Araç dururken (moving == false) tetiklenmez.
+    bool poll(uint32_t nowMs, bool moving) {
+        if (!moving || fault) return false;
+        if (nowMs - lastFeedMs <= timeoutMs()) return false;
+        fault = true;
+        trips++;
+        return true;
+    }
+
+    bool hasFault() const { return fault; }
+    uint32_t getTrips() const { return trips; }
+
+    // {"fault":0,"trips":..,"timeout":..,"rtt":..} (ms)
+    size_t writeJson(char* buf, size_t size) const {
+        if (size == 0) return 0;
+        int n = snprintf(buf, size, "{\"fault\":%u,\"trips\":%u,\"timeout\":%u,\"rtt\":%u}",
+                         (unsigned)fault, (unsigned)trips,
+                         (unsigned)timeoutMs(), (unsigned)rttMs());
+        if (n < 0) return 0;
+        return (size_t)n < size ? (size_t)n : size - 1;
+    }
+};
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef ESP8266_GPIO_PORT_H
+#define ESP8266_GPIO_PORT_H
+
+#include "MotorDriver.h"
+
+// ESP8266 register seviyesi GPIO erişimi (GPOS/GPOC ve GP16O)
+class Esp8266GpioPort : public GpioPort {
+public:
+    void configureOutput(uint8_t pin) override;
+    void writeMasks(uint32_t setMask, uint32_t clearMask) override;
+    void writeGpio16(bool high) override;
+    void writePwm(uint8_t pin, uint16_t duty) override;
+};
+
+#endif
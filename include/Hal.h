@@ -0,0 +1,131 @@
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "MotorDriver.h"
+
+// İnce donanım soyutlama katmanı (HAL)
+//
+// Motor ve komut yolu Arduino API'sine doğrudan değil bu arayüze bağlıdır;
+// böylece aynı kod cihazda (src/hal/HalEsp8266.cpp) ve Linux'ta
+// (src/native/HalNative.cpp, [env:native]) derlenir.
+namespace hal {
+
+// Saat
+uint32_t millis();
+uint32_t micros();
+uint32_t cycleCount();        // Cihazda ESP.getCycleCount(), host'ta ns
+uint32_t cyclesPerMicro();
+
+// Seri konsol. logf() bloke olabilir, yalnızca açılışta / sıcak yol dışında
+// kullanılmalı; sıcak yol Log.h üzerinden ertelenmiş kayıt bırakır.
+void logf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+void logWrite(const char* data, size_t length);
+size_t logWritable();   // Bloke olmadan yazılabilecek byte sayısı
+
+// GPIO / PWM
+GpioPort& gpio();
+
+// Heap durumu: boş bayt, en büyük ayrılabilir blok, parçalanma (%).
+// Host'ta ölçülmez (hepsi 0).
+struct HeapInfo {
+    uint32_t freeBytes;
+    uint32_t maxBlock;
+    uint8_t fragmentation;
+};
+HeapInfo heap();
+
+// A0 (10 bit, 0..1023). Cihazda bir okuma ~0,1 ms sürer ve sık okuma WiFi
+// ile çakışır; yalnızca düşük frekanslı bir görevden çağrılmalı.
+uint16_t analogRead();
+
+// Donanım rastgele sayısı (cihazda RNG register'ı); oturum belirteçleri için
+uint32_t random32();
+
+// Teker enkoderi: kenarlar cihazda IRAM'deki kesme rutininde sayılır,
+// count() kesmeyi kapatmadan okunur (32 bit hizalı okuma atomiktir).
+class Encoder {
+public:
+    virtual ~Encoder() {}
+    virtual int32_t count() = 0;
+    // Tek kanallı (hall/optik) enkoder yönü bilemez: sayım yönü sürülen
+    // PWM'in işaretinden gelir. Çift kanallıda (quadrature) yok sayılır.
+    virtual void setDirection(int8_t sign) = 0;
+};
+
+// index 0: sol, 1: sağ. pinB < 0: tek kanal. Pinler GPIO0..15 olmalı
+// (GPIO16 kesme üretmez); pinA < 0 ya da geçersiz pin: nullptr.
+// Host'ta nullptr (simülatör motor modelinin enkoderini doğrudan bağlar).
+Encoder* encoder(uint8_t index, int8_t pinA, int8_t pinB);
+
+// Yavaş çevre birimi seri portu (DFPlayer). write() bir baytın hat
+// süresi boyunca (9600 baud'da ~1 ms) bloke olur; çağıran bayt bayt,
+// döngü geçişlerine yayarak yazmalıdır. read() bloke olmaz.
+class SerialPort {
+public:
+    virtual ~SerialPort() {}
+    virtual int read() = 0;                 // -1: bekleyen bayt yok
+    virtual size_t write(uint8_t value) = 0;
+};
+
+// Cihazda SoftwareSerial (tek örnek; ilk çağrıda açılır), host'ta
+// simüle DFPlayer
+SerialPort& softSerial(uint8_t rxPin, uint8_t txPin, uint32_t baud);
+
+// Sabit boyutlu bloklardan oluşan kalıcı dosya (sürüş kaydı). Cihazda
+// LittleFS, host'ta bellek. write() flash'a yazar (ms mertebesi); yalnızca
+// düşük öncelikli bir görevden çağrılmalı, ağ geri çağrılarından değil.
+class BlockFile {
+public:
+    virtual ~BlockFile() {}
+    virtual uint16_t blockCount() const = 0;
+    // Bloğun ilk length baytı (başlık taraması için kısmi okuma)
+    virtual bool read(uint16_t index, uint8_t* data, size_t length) = 0;
+    virtual bool write(uint16_t index, const uint8_t* data, size_t length) = 0;
+    // Dosya sistemi sökülmeden önce (OTA); sonrası read/write çağrılmaz
+    virtual void close() {}
+};
+
+// path'i blockCount * blockSize baytlık dosya olarak açar; yoksa 0xFF
+// ile oluşturur (tek örnek). Dosya sistemi yoksa nullptr.
+BlockFile* blockFile(const char* path, size_t blockSize, uint16_t blockCount);
+
+// Kalıcı ayar alanı: tek bloklu BlockFile. Cihazda EEPROM emülasyonu
+// (flash'ın ayrı bir sektörü, açılışta RAM'e kopyalanır; read() bellekten,
+// µs). write() sektörü silip yeniden yazar (onlarca ms, bu sürede kod
+// flash'tan çalışamaz): yalnızca düşük öncelikli görevden, araç dururken.
+// Host'ta bellek. Boş alan 0xFF okunur.
+BlockFile* configSector(size_t size);
+
+// UDP uç noktası: IPv4 adresi (ağ bayt sırası, IPAddress ile aynı) ve port
+struct Endpoint {
+    uint32_t address;
+    uint16_t port;
+};
+
+// Bloke olmayan UDP soketi (düşük gecikmeli kontrol kanalı). Cihazda
+// WiFiUDP, host'ta POSIX soketi.
+class DatagramSocket {
+public:
+    virtual ~DatagramSocket() {}
+    // Bekleyen bir datagramı alır: uzunluk, yoksa 0, size'a sığmıyorsa
+    // atılır ve -1 (from yine doldurulur)
+    virtual int receive(uint8_t* buf, size_t size, Endpoint& from) = 0;
+    virtual bool send(const Endpoint& to, const uint8_t* data, size_t length) = 0;
+};
+
+// port'ta dinleyen soket (tek örnek); açılamazsa nullptr
+DatagramSocket* udpSocket(uint16_t port);
+
+// Soket taşıma: komut yolunun istemcilere yanıt gönderdiği kanal
+class Transport {
+public:
+    virtual ~Transport() {}
+    virtual bool sendText(uint8_t client, const char* data, size_t length) = 0;
+    virtual bool sendBinary(uint8_t client, const uint8_t* data, size_t length) = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef HEAP_MONITOR_H
+#define HEAP_MONITOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "Hal.h"
+
+// Uzun süreli heap izleme: boş heap, en büyük blok ve parçalanma.
+//
+// poll() saniyede bir çağrılır (zamanlayıcı görevi). Her SAMPLE_INTERVAL_MS
+// aralığının en kötü değerleri (en az boş, en küçük blok, en yüksek
+// parçalanma) halka tampona yazılır; HISTORY örnekle ~5 saatlik eğilim
+// tutulur. Açılıştan beri en kötü değerler ayrıca saklanır. Düz bir eğri
+// istek yollarının heap'i kalıcı olarak tüketmediğini gösterir; azalan
+// max_block parçalanmanın habercisidir.
+class HeapMonitor {
+public:
+    static const uint8_t HISTORY = 64;
+    static const uint32_t SAMPLE_INTERVAL_MS = 300000;
+
+private:
+    // Cihaz heap'i 64 KB altında; 16 bit yeter
+    struct Sample {
+        uint16_t freeBytes;
+        uint16_t maxBlock;
+        uint8_t fragmentation;
+    };
+
+    Sample history[HISTORY] = {};
+    uint8_t head = 0;           // Sıradaki yazım
+    uint8_t filled = 0;
+
+    hal::HeapInfo current = {};
+    Sample interval = {};       // Süren aralığın en kötüsü
+    bool intervalStarted = false;
+    uint32_t intervalStart = 0;
+
+    uint32_t minFree = UINT32_MAX;
+    uint32_t minBlock = UINT32_MAX;
+    uint8_t maxFragmentation = 0;
+
+    static uint16_t clamp16(uint32_t v) { return v > 0xFFFF ? 0xFFFF : (uint16_t)v; }
+
+public:
+    void poll(uint32_t nowMs, const hal::HeapInfo& info) {
+        current = info;
+        if (info.freeBytes < minFree) minFree = info.freeBytes;
+        if (info.maxBlock < minBlock) minBlock = info.maxBlock;
+        if (info.fragmentation > maxFragmentation) maxFragmentation = info.fragmentation;
+
+        Sample sample = { clamp16(info.freeBytes), clamp16(info.maxBlock), info.fragmentation };
+        if (!intervalStarted) {
+            intervalStarted = true;
+            intervalStart = nowMs;
+            interval = sample;
+        } else {
+            if (sample.freeBytes < interval.freeBytes) interval.freeBytes = sample.freeBytes;
+            if (sample.maxBlock < interval.maxBlock) interval.maxBlock = sample.maxBlock;
+            if (sample.fragmentation > interval.fragmentation) interval.fragmentation = sample.fragmentation;
+        }
+
+        if (nowMs - intervalStart >= SAMPLE_INTERVAL_MS) {
+            history[head] = interval;
+            head = (uint8_t)((head + 1) % HISTORY);
+            if (filled < HISTORY) filled++;
+            intervalStart = nowMs;
+            interval = sample;
+        }
+    }
+
+    const hal::HeapInfo& getCurrent() const { return current; }
+
+    // {"free":..,"max_block":..,"frag":..}
+    size_t writeSummary(char* buf, size_t size) const {
+        if (size == 0) return 0;
+        int n = snprintf(buf, size, "{\"free\":%u,\"max_block\":%u,\"frag\":%u}",
+                         (unsigned)current.freeBytes, (unsigned)current.maxBlock,
+                         (unsigned)current.fragmentation);
+        if (n < 0) return 0;
+        return (size_t)n < size ? (size_t)n : size - 1;
+    }
+
+    // Özet + açılıştan beri en kötüler + "history":[[free,max_block,frag],...]
+    // (eskiden yeniye, aralık başına en kötü değerler); ~1,4 KB
+    size_t writeJson(char* buf, size_t size, uint32_t nowMs) const {
+        if (size < 2) return 0;
+        int n = snprintf(buf, size,
+                         "{\"free\":%u,\"max_block\":%u,\"frag\":%u,\"min_free\":%u,\"min_block\":%u,"
+                         "\"max_frag\":%u,\"uptime_s\":%u,\"interval_s\":%u,\"history\":[",
+                         (unsigned)current.freeBytes, (unsigned)current.maxBlock,
+                         (unsigned)current.fragmentation,
+                         (unsigned)(minFree == UINT32_MAX ? 0 : minFree),
+                         (unsigned)(minBlock == UINT32_MAX ? 0 : minBlock),
+                         (unsigned)maxFragmentation, (unsigned)(nowMs / 1000),
+                         (unsigned)(SAMPLE_INTERVAL_MS / 1000));
+        if (n < 0 || (size_t)n >= size) return size - 1;
+
+        size_t length = (size_t)n;
+        uint8_t start = (uint8_t)((head + HISTORY - filled) % HISTORY);
+        for (uint8_t i = 0; i < filled; i++) {
+            const Sample& s = history[(start + i) % HISTORY];
+            n = snprintf(buf + length, size - length, "%s[%u,%u,%u]", i ? "," : "",
+                         (unsigned)s.freeBytes, (unsigned)s.maxBlock, (unsigned)s.fragmentation);
+            if (n < 0 || (size_t)n >= size - length) return size - 1;
+            length += (size_t)n;
+        }
+
+        if (length + 2 >= size) return size - 1;
+        buf[length++] = ']';
+        buf[length++] = '}';
+        buf[length] = '\0';
+        return length;
+    }
+};
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Komut yolu gecikme ölçümü: alım -> ayrıştırma -> dağıtım -> pin yazımı.
+//
+// Zaman damgaları cycle sayacından (ESP.getCycleCount()) alınır, µs'ye
+// çevrilip sabit kovalı histogramlara yazılır. Hiçbir yerde heap tahsisi
+// yoktur; JSON çıktısı çağıranın tamponuna snprintf ile yazılır.
+
+enum CommandType : uint8_t {
+    CMD_NONE = 0,
+    CMD_DRIVE_BINARY,   // İkili OP_DRIVE / OP_MIX / OP_STOP
+    CMD_DRIVE_JSON,     // JSON "custom" / "drive"
+    CMD_MOVE,           // JSON "move" ve /control yön komutları
+    CMD_SPEED,          // Hız ayarı
+    CMD_SOUND,          // DFPlayer komutları
+    CMD_TYPE_COUNT
+};
+
+struct LatencyTrace {
+    uint8_t type;
+    uint32_t rxCycles;        // onWebSocketEvent girişi
+    uint32_t parseCycles;     // Çerçeve çözüldü
+    uint32_t dispatchCycles;  // Hedef posta kutusuna yazıldı
+};
+
+// Log-doğrusal histogram: oktav başına 4 alt kova, 0..65535 µs.
+// Yüzdelik değerler kova üst sınırıyla döner (en fazla ~%25 hata).
+class LatencyHistogram {
+public:
+    static const uint8_t BUCKETS = 64;
+
+private:
+    uint32_t counts[BUCKETS];
+    uint32_t total;
+    uint32_t maxUs;
+
+    static uint8_t bucketOf(uint32_t us) {
+        if (us < 4) return (uint8_t)us;
+        uint8_t msb = 31 - __builtin_clz(us);
+        uint32_t bucket = (uint32_t)(msb - 1) * 4 + ((us >> (msb - 2)) & 3);
+        return bucket < BUCKETS ? (uint8_t)bucket : BUCKETS - 1;
+    }
+
+    static uint32_t bucketUpper(uint8_t bucket) {
+        if (bucket < 4) return bucket;
+        uint8_t msb = bucket / 4 + 1;
+        uint32_t lower = (uint32_t)(4 + bucket % 4) << (msb - 2);
+        return lower + (1UL << (msb - 2)) - 1;
+    }
+
+public:
+    LatencyHistogram() { reset(); }
+
+    void reset() {
+        for (uint8_t i = 0; i < BUCKETS; i++) counts[i] = 0;
+        total = 0;
+        maxUs = 0;
+    }
+
+    void record(uint32_t us) {
+        counts[bucketOf(us)]++;
+        total++;
+        if (us > maxUs) maxUs = us;
+    }
+
+    uint32_t percentile(uint8_t pct) const {
+        if (total == 0) return 0;
+        uint32_t rank = (uint32_t)(((uint64_t)total * pct + 99) / 100);
+        if (rank == 0) rank = 1;
+        uint32_t seen = 0;
+        for (uint8_t i = 0; i < BUCKETS; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                uint32_t upper = bucketUpper(i);
+                return upper < maxUs ? upper : maxUs;
+            }
+        }
+        return maxUs;
+    }
+
+    uint32_t count() const { return total; }
+    uint32_t max() const { return maxUs; }
+};
+
+class LatencyStats {
+private:
+    struct Stage {
+        uint32_t count;
+        uint32_t sumUs;
+        uint32_t maxUs;
+    };
+
+    struct PerType {
+        LatencyHistogram total;   // Alım -> pin yazımı
+        Stage parse;              // Alım -> ayrıştırma
+        Stage dispatch;           // Ayrıştırma -> dağıtım
+        Stage apply;              // Dağıtım -> pin yazımı (kontrol tick'i)
+    };
+
+    PerType types[CMD_TYPE_COUNT];
+
+    static void addStage(Stage& stage, uint32_t us);
+
+public:
+    LatencyStats() { reset(); }
+
+    static const char* typeName(uint8_t type);
+
+    // applyCycles: çıkışın pinlere yazıldığı an
+    void record(const LatencyTrace& trace, uint32_t applyCycles);
+    void reset();
+
+    uint32_t count(uint8_t type) const { return type < CMD_TYPE_COUNT ? types[type].total.count() : 0; }
+    uint32_t percentile(uint8_t type, uint8_t pct) const {
+        return type < CMD_TYPE_COUNT ? types[type].total.percentile(pct) : 0;
+    }
+
+    // {"drive_bin":{"n":..,"p50":..,"p99":..,"max":..,"parse":..,...},...}
+    // Yazılan uzunluğu döner (kesilirse size - 1)
+    size_t writeJson(char* buf, size_t size) const;
+};
+
+#endif
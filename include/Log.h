@@ -0,0 +1,100 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Hal.h"
+
+// Ertelenmiş (deferred) günlük kaydı
+//
+// Sıcak yoldaki kod Serial'e yazmaz; biçim dizesi işaretçisi ve en fazla
+// 4 tamsayı argümandan oluşan küçük bir kayıt halka tampona itilir.
+// loop() boşta kaldığında Log::drain() kayıtları biçimlendirip seri
+// porta, UART FIFO'yu bloke etmeyecek kadar yazar.
+//
+// - Biçim dizeleri sabit (literal) olmalı, yalnızca %d/%u/%x gibi tamsayı
+//   dönüşümleri kullanılabilir (%s yok: işaretçi ömrü garanti değil).
+// - Üreticiler loop() ve ağ callback'leridir; ISR içinden çağrılmamalı.
+// - LOG_LEVEL altındaki seviyeler derleme zamanında tamamen kaybolur,
+//   -DLOG_DISABLED tüm günlüğü (tamponla birlikte) kaldırır.
+// - LOG_BOOT açılış gibi sıcak yol dışındaki yerler içindir: ertelenmez,
+//   %s kullanabilir, INFO seviyesinde derlenir.
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+#ifdef LOG_DISABLED
+#undef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_NONE
+#endif
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE 32   // 2'nin kuvveti olmalı
+#endif
+
+namespace Log {
+
+const uint8_t MAX_ARGS = 4;
+
+struct Record {
+    uint32_t ms;
+    const char* fmt;
+    int32_t args[MAX_ARGS];
+    uint8_t level;
+};
+
+void pushRecord(uint8_t level, const char* fmt, const int32_t* args, uint8_t count);
+
+template <typename... Args>
+inline void push(uint8_t level, const char* fmt, Args... args) {
+    static_assert(sizeof...(Args) <= MAX_ARGS, "Log kaydı en fazla 4 argüman taşır");
+    const int32_t values[] = { (int32_t)args..., 0 };
+    pushRecord(level, fmt, values, (uint8_t)sizeof...(Args));
+}
+
+// Bekleyen kayıtları biçimlendirip yaz; yazılan kayıt sayısını döner.
+// Seri port tamponu doluysa erken durur (bloke olmaz).
+size_t drain(size_t maxRecords = 4);
+
+uint32_t dropped();
+
+}
+
+// Kapalı seviyeler: argümanlar değerlendirilmez ve kod üretilmez, ama
+// derleyici yine görür (kullanılmayan değişken uyarısı çıkmaz).
+#define LOG_OFF(fmt, ...) do { if (0) hal::logf(fmt, ##__VA_ARGS__); } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_E(fmt, ...) Log::push(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOG_E(fmt, ...) LOG_OFF(fmt, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_W(fmt, ...) Log::push(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define LOG_W(fmt, ...) LOG_OFF(fmt, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_I(fmt, ...) Log::push(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define LOG_BOOT(fmt, ...) hal::logf(fmt, ##__VA_ARGS__)
+#else
+#define LOG_I(fmt, ...) LOG_OFF(fmt, ##__VA_ARGS__)
+#define LOG_BOOT(fmt, ...) LOG_OFF(fmt, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_D(fmt, ...) Log::push(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_D(fmt, ...) LOG_OFF(fmt, ##__VA_ARGS__)
+#endif
+
+#endif
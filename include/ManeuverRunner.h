@@ -0,0 +1,199 @@
+#ifndef MANEUVER_RUNNER_H
+#define MANEUVER_RUNNER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// Cihazda çalışan manevra (zamanlı segment dizisi) yürütücüsü.
+//
+// Sekiz çizme, park gibi hazır manevralar tek mesajla yüklenir ve kontrol
+// tick'inde (200 Hz) yürütülür; adım başına ağ gidiş-dönüşü olmadığından
+// hassasiyet WiFi jitter'ından bağımsızdır. Segment sınırları başlangıca
+// göre mutlak zamanla hesaplanır, tick gecikmesi birikmez.
+//
+// Segment türleri (değerler kablo aralığında, -1000..1000):
+//   WHEELS:    a = sol, b = sağ teker
+//   CURVATURE: a = hız, b = eğrilik (DriveMixer::curvature)
+//
+// Yükleme ağ geri çağrısında stage() ile bırakılır, bir sonraki tick'te
+// başlar. Çalışırken gelen her elle komut (setTarget/stop) manevrayı
+// keser; bkz. MotorController::tick().
+struct ManeuverSegment {
+    int16_t a;
+    int16_t b;
+    uint16_t durationMs;
+    uint8_t kind;
+};
+
+class ManeuverRunner {
+public:
+    enum Kind : uint8_t {
+        WHEELS,
+        CURVATURE,
+        KIND_COUNT
+    };
+
+    enum State : uint8_t {
+        IDLE,
+        RUNNING,
+        DONE,
+        ABORTED
+    };
+
+    enum Event : uint8_t {
+        EVENT_NONE,
+        EVENT_SEGMENT,      // Yeni segment başladı: current() uygulanmalı
+        EVENT_DONE          // Son segment bitti: araç durdurulmalı
+    };
+
+    static const uint8_t MAX_SEGMENTS = 32;
+    static const int16_t WIRE_MAX = 1000;
+    static const uint32_t MAX_TOTAL_MS = 120000;    // Tekrarlar dahil
+
+private:
+    // Ağ tarafının yazdığı bekleyen yükleme
+    ManeuverSegment staged[MAX_SEGMENTS];
+    uint8_t stagedCount = 0;
+    uint8_t stagedRepeat = 0;
+    volatile bool stagedReady = false;
+
+    // Yürütülen dizi (yalnızca tick bağlamı)
+    ManeuverSegment segments[MAX_SEGMENTS];
+    uint8_t count = 0;
+    uint8_t repeat = 0;         // Ek tur sayısı
+    uint32_t passMs = 0;        // Bir turun süresi
+
+    State state = IDLE;
+    uint8_t index = 0;
+    uint8_t pass = 0;
+    uint32_t startMs = 0;
+    uint32_t segmentEndMs = 0;
+    uint32_t elapsedMs = 0;     // Bitince/kesilince dondurulur
+
+    // Her durum/segment değişiminde artar; ilerleme olayları buna bakar
+    volatile uint16_t version = 0;
+
+    uint32_t completed = 0;
+    uint32_t aborts = 0;
+
+    void changed() { version = (uint16_t)(version + 1); }
+
+public:
+    // Dizi geçerli mi: segment sayısı, tür, değer aralığı, toplam süre
+    static bool validate(const ManeuverSegment* list, uint8_t n, uint8_t rep) {
+        if (n == 0 || n > MAX_SEGMENTS) return false;
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < n; i++) {
+            const ManeuverSegment& s = list[i];
+            if (s.kind >= KIND_COUNT || s.durationMs == 0) return false;
+            if (s.a < -WIRE_MAX || s.a > WIRE_MAX || s.b < -WIRE_MAX || s.b > WIRE_MAX) return false;
+            total += s.durationMs;
+        }
+        return total * (rep + 1UL) <= MAX_TOTAL_MS;
+    }
+
+    // Ağ geri çağrısından: diziyi bırakır (öncekini ezer); geçersizse false
+    bool stage(const ManeuverSegment* list, uint8_t n, uint8_t rep) {
+        if (!validate(list, n, rep)) return false;
+        stagedReady = false;
+        memcpy(staged, list, n * sizeof(ManeuverSegment));
+        stagedCount = n;
+        stagedRepeat = rep;
+        stagedReady = true;
+        return true;
+    }
+
+    // Kontrol tick'i: bekleyen yüklemeyi başlatır, segment sınırlarını
+    // ilerletir. Tick geciktiyse aradaki kısa segmentler atlanır.
+    Event step(uint32_t nowMs) {
+        Event event = EVENT_NONE;
+        if (stagedReady) {
+            memcpy(segments, staged, stagedCount * sizeof(ManeuverSegment));
+            count = stagedCount;
+            repeat = stagedRepeat;
+            stagedReady = false;
+
+            passMs = 0;
+            for (uint8_t i = 0; i < count; i++) passMs += segments[i].durationMs;
+            state = RUNNING;
+            index = 0;
+            pass = 0;
+            startMs = nowMs;
+            segmentEndMs = nowMs + segments[0].durationMs;
+            elapsedMs = 0;
+            changed();
+            event = EVENT_SEGMENT;
+        }
+        if (state != RUNNING) return event;
+
+        elapsedMs = nowMs - startMs;
+        while ((int32_t)(nowMs - segmentEndMs) >= 0) {
+            if (index + 1 >= count) {
+                if (pass >= repeat) {
+                    state = DONE;
+                    elapsedMs = passMs * (repeat + 1UL);
+                    completed++;
+                    changed();
+                    return EVENT_DONE;
+                }
+                pass++;
+                index = 0;
+            } else {
+                index++;
+            }
+            segmentEndMs += segments[index].durationMs;
+            changed();
+            event = EVENT_SEGMENT;
+        }
+        return event;
+    }
+
+    // Tick bağlamından: elle komut geldi
+    void abort() {
+        if (state != RUNNING) return;
+        state = ABORTED;
+        aborts++;
+        changed();
+    }
+
+    bool isRunning() const { return state == RUNNING; }
+    State getState() const { return state; }
+    const ManeuverSegment& current() const { return segments[index]; }
+    uint16_t getVersion() const { return version; }
+
+    static const char* stateName(State s) {
+        switch (s) {
+            case RUNNING: return "running";
+            case DONE: return "done";
+            case ABORTED: return "aborted";
+            default: return "idle";
+        }
+    }
+
+    // İlerleme olayı (WebSocket):
+    // {"type":"maneuver","state":"..","segment":..,"count":..,"pass":..,
+    //  "repeat":..,"elapsed_ms":..,"total_ms":..}
+    size_t writeProgress(char* buf, size_t size) const {
+        if (size == 0) return 0;
+        int n = snprintf(buf, size,
+                         "{\"type\":\"maneuver\",\"state\":\"%s\",\"segment\":%u,\"count\":%u,"
+                         "\"pass\":%u,\"repeat\":%u,\"elapsed_ms\":%u,\"total_ms\":%u}",
+                         stateName(state), (unsigned)index, (unsigned)count, (unsigned)pass,
+                         (unsigned)repeat, (unsigned)elapsedMs, (unsigned)(passMs * (repeat + 1UL)));
+        if (n < 0) return 0;
+        return (size_t)n < size ? (size_t)n : size - 1;
+    }
+
+    // {"state":"..","completed":..,"aborts":..}
+    size_t writeSummary(char* buf, size_t size) const {
+        if (size == 0) return 0;
+        int n = snprintf(buf, size, "{\"state\":\"%s\",\"completed\":%u,\"aborts\":%u}",
+                         stateName(state), (unsigned)completed, (unsigned)aborts);
+        if (n < 0) return 0;
+        return (size_t)n < size ? (size_t)n : size - 1;
+    }
+};
+
+#endif
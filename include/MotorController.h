@@ -1,30 +1,132 @@
 #ifndef MOTOR_CONTROLLER_H
 #define MOTOR_CONTROLLER_H
 
-#include <Arduino.h>
+#include <stdint.h>
+#include "SetpointMailbox.h"
+#include "RampGenerator.h"
+#include "MotorDriver.h"
+#include "DriveWatchdog.h"
+#include "DriveMixer.h"
+#include "ManeuverRunner.h"
+#include "SpeedController.h"
+#include "ParamStore.h"
+
+class DriveRecorder;
+class BatteryMonitor;
+
+namespace hal {
+class Encoder;
+}
 
 class MotorController {
 private:
-    // TB6612FNG Pin Tanımlamaları
-    uint8_t PWMA;      // Sol motor PWM
-    uint8_t AIN1;      // Sol motor IN1
-    uint8_t AIN2;      // Sol motor IN2
+    // TB6612FNG sürücüsü (maske tabanlı toplu pin yazımı)
+    Tb6612Driver driver;
     
-    uint8_t PWMB;      // Sağ motor PWM
-    uint8_t BIN1;      // Sağ motor IN1
-    uint8_t BIN2;      // Sağ motor IN2
+    int currentSpeed;
+    uint8_t defaultSpeed = 150; // Parametre setindeki (değişince currentSpeed'e yazılır)
     
-    uint8_t STBY;      // Standby pin
+    // Ağ callback'lerinden gelen hedef; tick() tarafından uygulanır
+    SetpointMailbox target;
+    uint32_t targetVersion = 0;
+    Setpoint goal = {};
     
-    int currentSpeed;
+    // Gecikme ölçümü: sıradaki setTarget() bu izi taşır
+    LatencyStats* latencyStats = nullptr;
+    LatencyTrace pendingTrace = {};
+    
+    // Uygulanan her hedef kaydediciye bildirilir (yoksa nullptr)
+    DriveRecorder* recorder = nullptr;
+    
+    // Teker başına hız rampası ve ölü bölge telafisi
+    RampGenerator leftRamp;
+    RampGenerator rightRamp;
+    RampConfig rampConfig = {};
+    int16_t minPwm = 150;       // Motorların kalkış eşiği
+    
+    // Komut gelmezse rampayla durdurur (tick içinde denetlenir)
+    DriveWatchdog watchdog;
+    
+    // Gaz/direksiyon -> teker karıştırıcı (drive() bunu kullanır)
+    DriveMixer mixer;
+    
+    // Q15 sol/sağ -> hedef; full: tam ölçeğin PWM karşılığı
+    void applyMix(int16_t left, int16_t right, int16_t full);
+    
+    // Sabit komutlar (forward, turnLeft ...): sol/sağ Q15, varsayılan hızla.
+    // Hız zaten PWM'dir, ölü bölge telafisi uygulanmaz (150 -> 150)
+    void preset(int16_t left, int16_t right);
+    
+    // Sabit komutlarda iç teker oranları (Q15): dönüşte geri, kavisli ileri
+    int16_t turnRatio = q15::Q(0.7);
+    int16_t curveRatio = q15::Q(0.5);
+    
+    // Canlı parametreler: tick başında bütün set olarak alınır
+    const ParamStore* params = nullptr;
+    uint32_t paramsVersion = 0;
+    ParamSet activeParams = {};
+    void applyParams(const ParamSet& set);
+    
+    // Cihazda yürütülen manevra; elle gelen her hedef keser
+    ManeuverRunner maneuver;
+    
+    // Kapalı çevrim hız kontrolü (iki enkoder de bağlıysa); yoksa açık çevrim
+    hal::Encoder* leftEncoder = nullptr;
+    hal::Encoder* rightEncoder = nullptr;
+    SpeedController leftSpeed;
+    SpeedController rightSpeed;
+    uint8_t speedPhase = 0;
+    // Besleme gerilimi telafisi ve çökme tavanı (yoksa nullptr)
+    const BatteryMonitor* battery = nullptr;
+    
+    int16_t appliedLeft = 0;    // Son tick'te sürücüye giden PWM
+    int16_t appliedRight = 0;
+    
+    // Tick bağlamından hedef (posta kutusunu atlar, manevrayı kesmez)
+    void setGoal(int16_t left, int16_t right);
+    void applySegment(const ManeuverSegment& segment);
     
 public:
-    MotorController(uint8_t pwma, uint8_t ain1, uint8_t ain2, 
+    // Kontrol döngüsü frekansı (loop() içinde ControlTimer ile sürülür)
+    static constexpr uint32_t CONTROL_HZ = 200;
+    static constexpr uint32_t CONTROL_PERIOD_US = 1000000UL / CONTROL_HZ;
+    static constexpr int16_t PWM_MAX = 255;
+    // Hız denetleyicisi her SPEED_DIVIDER tick'te bir güncellenir (50 Hz):
+    // 200 Hz'de düşük çözünürlüklü enkoder pencere başına birkaç kenar sayar
+    static constexpr uint8_t SPEED_DIVIDER = 4;
+    static constexpr uint16_t SPEED_HZ = CONTROL_HZ / SPEED_DIVIDER;
+    
+    MotorController(GpioPort& port,
+                   uint8_t pwma, uint8_t ain1, uint8_t ain2, 
                    uint8_t pwmb, uint8_t bin1, uint8_t bin2, 
                    uint8_t stby);
     
     void begin();
     void setSpeed(int speed);
+    void setRamp(const RampConfig& config);
+    void setDeadband(int minimumPwm);
+    
+    // Hedef sol/sağ hızı yaz (işaretli); pinlere bir sonraki tick'te uygulanır.
+    // deadband: [0, PWM_MAX] ölçeği kalkış eşiğine eşlenir (joystick birimi);
+    // false ise hedef doğrudan PWM'dir (sabit komutlar)
+    void setTarget(int leftSpeed, int rightSpeed, bool deadband = true);
+    
+    // Sabit frekanslı kontrol tick'i - yalnızca loop()'tan çağrılmalı
+    void tick();
+    
+    // Gecikme ölçümü: traceNext() sonrası ilk hareket komutu izlenir,
+    // hedef pinlere yazıldığında stats'a kaydedilir
+    void setLatencyStats(LatencyStats* stats);
+    void traceNext(const LatencyTrace& trace);
+    void cancelTrace() { pendingTrace.type = CMD_NONE; }
+    
+    // Sürüş kaydı: setTarget()/stop() hedefleri kaynağıyla birlikte bildirir
+    void setRecorder(DriveRecorder* driveRecorder) { recorder = driveRecorder; }
+    
+    // Ölü adam bekçisi: geçerli her sürüş çerçevesinde (keepalive dahil)
+    // feedWatchdog() çağrılmalı; aksi hâlde araç timeout sonunda durur
+    void feedWatchdog();
+    DriveWatchdog& getWatchdog() { return watchdog; }
     
     // Temel Hareket Fonksiyonları
     void forward();
@@ -35,15 +137,48 @@ public:
     void forwardRight();
     void backwardLeft();
     void backwardRight();
-    void stop();
+    void stop();   // Acil durdurma: rampayı atlar, pinleri hemen bırakır
     
     // Özel Hareketler
     void pivotLeft();
     void pivotRight();
+    
+    // Joystick girdileri, kablo aralığında (-1000..1000), tam ölçek PWM_MAX.
+    // smoothTurn: sol/sağ teker (tank), drive: gaz/direksiyon (seçili mod).
+    // Her ikisi de seçili tepki eğrisinden geçer.
     void smoothTurn(int leftSpeed, int rightSpeed);
+    void drive(int throttle, int steer);
+    
+    void setMixMode(DriveMixer::Mode mode) { mixer.setMode(mode); }
+    void setCurve(DriveMixer::Curve curve) { mixer.setCurve(curve); }
+    const DriveMixer& getMixer() const { return mixer; }
+    
+    // Manevra yükleme: stage() ağ geri çağrısından güvenle çağrılabilir,
+    // yürütme bir sonraki tick'te başlar. Yürütme sırasında bekçi
+    // tick'te beslenir (bağlantı kopunca onDisconnect() stop() ile keser).
+    ManeuverRunner& getManeuver() { return maneuver; }
+    
+    // Teker enkoderleri: ikisi de verilirse tick rampa çıkışını hedef hız
+    // sayar ve PI düzeltmesi ekler (config.rateHz, SPEED_HZ'e zorlanır).
+    // begin()'den sonra, görevler başlamadan çağrılmalı.
+    void setEncoders(hal::Encoder* left, hal::Encoder* right, const SpeedConfig& config);
+    bool isClosedLoop() const { return leftEncoder && rightEncoder; }
+    
+    // {"closed_loop":..,"rpm":[l,r],"target_rpm":[l,r],"trim":[l,r],"pwm":[l,r],"sat":..}
+    size_t writeWheelsJson(char* buf, size_t size) const;
+    
+    // Batarya: tick son PWM'i gerilimle ölçekler ve çökme tavanıyla kırpar
+    void setBattery(const BatteryMonitor* monitor) { battery = monitor; }
+    
+    // Canlı parametreler (hız, kalkış eşiği, rampa, dönüş oranları): yayınlanan
+    // set bir sonraki tick'in başında uygulanır. Çağrıldığında hemen uygulanır.
+    void setParams(const ParamStore* store);
+    
+    // Sürücüye son tick'te sıfır PWM gitti (flash yazımı için güvenli an)
+    bool isIdle() const { return appliedLeft == 0 && appliedRight == 0; }
     
     // Getter
     int getCurrentSpeed();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,147 @@
+#ifndef MOTOR_DRIVER_H
+#define MOTOR_DRIVER_H
+
+#include <stdint.h>
+
+// GPIO erişim arayüzü - cihazda register'lar, host'ta kayıt tutan mock.
+//
+// ESP8266'da GPIO0..15 tek bir bankta (GPOS/GPOC ile maske yazımı),
+// GPIO16 ise RTC bloğunda ayrı bir register'dadır.
+class GpioPort {
+public:
+    virtual ~GpioPort() {}
+    virtual void configureOutput(uint8_t pin) = 0;
+    virtual void writeMasks(uint32_t setMask, uint32_t clearMask) = 0;
+    virtual void writeGpio16(bool high) = 0;
+    virtual void writePwm(uint8_t pin, uint16_t duty) = 0;
+};
+
+// TB6612FNG sürücü katmanı.
+//
+// Yön pinleri için set/clear maskeleri begin()'de bir kez hesaplanır; bir
+// yön değişimi iki motor için birlikte tek GPOS + tek GPOC (gerekirse bir
+// GPIO16) yazımıyla uygulanır. Çıkış değişmediyse hiçbir şey yazılmaz.
+// STBY yalnızca begin()'de aktif edilir.
+class Tb6612Driver {
+public:
+    static const uint8_t GPIO16 = 16;
+
+private:
+    enum Direction : uint8_t { DIR_STOP = 0, DIR_FORWARD = 1, DIR_REVERSE = 2 };
+
+    // Bir yön durumu için önceden hesaplanmış yazım
+    struct PinWrite {
+        uint32_t setMask;
+        uint32_t clearMask;
+        int8_t gpio16;   // -1: dokunma, 0/1: GPIO16 değeri
+    };
+
+    GpioPort& port;
+    uint8_t pwmA, ain1, ain2;
+    uint8_t pwmB, bin1, bin2;
+    uint8_t stby;
+
+    PinWrite wheelA[3];
+    PinWrite wheelB[3];
+
+    Direction dirA = DIR_STOP;
+    Direction dirB = DIR_STOP;
+    uint16_t dutyA = 0;
+    uint16_t dutyB = 0;
+
+    static void addPin(PinWrite& w, uint8_t pin, bool high) {
+        if (pin == GPIO16) {
+            w.gpio16 = high ? 1 : 0;
+        } else if (high) {
+            w.setMask |= (1UL << pin);
+        } else {
+            w.clearMask |= (1UL << pin);
+        }
+    }
+
+    static void buildWheel(PinWrite* out, uint8_t in1, uint8_t in2) {
+        for (uint8_t d = 0; d < 3; d++) {
+            out[d].setMask = 0;
+            out[d].clearMask = 0;
+            out[d].gpio16 = -1;
+        }
+        addPin(out[DIR_STOP], in1, false);
+        addPin(out[DIR_STOP], in2, false);
+        addPin(out[DIR_FORWARD], in1, true);
+        addPin(out[DIR_FORWARD], in2, false);
+        addPin(out[DIR_REVERSE], in1, false);
+        addPin(out[DIR_REVERSE], in2, true);
+    }
+
+    static Direction directionOf(int16_t speed) {
+        return speed == 0 ? DIR_STOP : (speed > 0 ? DIR_FORWARD : DIR_REVERSE);
+    }
+
+    static uint16_t dutyOf(int16_t speed) {
+        return (uint16_t)(speed < 0 ? -speed : speed);
+    }
+
+    void writeDirections(Direction a, Direction b) {
+        const PinWrite& wa = wheelA[a];
+        const PinWrite& wb = wheelB[b];
+        port.writeMasks(wa.setMask | wb.setMask, wa.clearMask | wb.clearMask);
+        int8_t g16 = wa.gpio16 >= 0 ? wa.gpio16 : wb.gpio16;
+        if (g16 >= 0) port.writeGpio16(g16 != 0);
+        dirA = a;
+        dirB = b;
+    }
+
+public:
+    Tb6612Driver(GpioPort& port, uint8_t pwma, uint8_t ain1, uint8_t ain2,
+                 uint8_t pwmb, uint8_t bin1, uint8_t bin2, uint8_t stby)
+        : port(port), pwmA(pwma), ain1(ain1), ain2(ain2),
+          pwmB(pwmb), bin1(bin1), bin2(bin2), stby(stby) {}
+
+    void begin() {
+        const uint8_t pins[] = { pwmA, ain1, ain2, pwmB, bin1, bin2, stby };
+        for (uint8_t pin : pins) port.configureOutput(pin);
+
+        buildWheel(wheelA, ain1, ain2);
+        buildWheel(wheelB, bin1, bin2);
+
+        // STBY aktif + tüm yön pinleri LOW, tek seferde
+        PinWrite init = wheelA[DIR_STOP];
+        init.setMask |= wheelB[DIR_STOP].setMask;
+        init.clearMask |= wheelB[DIR_STOP].clearMask;
+        if (init.gpio16 < 0) init.gpio16 = wheelB[DIR_STOP].gpio16;
+        addPin(init, stby, true);
+        port.writeMasks(init.setMask, init.clearMask);
+        if (init.gpio16 >= 0) port.writeGpio16(init.gpio16 != 0);
+
+        release();
+    }
+
+    // İşaretli sol/sağ PWM değerlerini uygula; değişmeyen çıkışlar atlanır
+    void apply(int16_t left, int16_t right) {
+        Direction a = directionOf(left);
+        Direction b = directionOf(right);
+        uint16_t da = dutyOf(left);
+        uint16_t db = dutyOf(right);
+
+        if (a != dirA || b != dirB) writeDirections(a, b);
+        if (da != dutyA) {
+            port.writePwm(pwmA, da);
+            dutyA = da;
+        }
+        if (db != dutyB) {
+            port.writePwm(pwmB, db);
+            dutyB = db;
+        }
+    }
+
+    // Önbelleğe bakmadan iki motoru da bırak (acil durdurma)
+    void release() {
+        writeDirections(DIR_STOP, DIR_STOP);
+        port.writePwm(pwmA, 0);
+        port.writePwm(pwmB, 0);
+        dutyA = 0;
+        dutyB = 0;
+    }
+};
+
+#endif
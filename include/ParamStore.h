@@ -0,0 +1,128 @@
+#ifndef PARAM_STORE_H
+#define PARAM_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "Hal.h"
+
+// Çalışma anında ayarlanabilen parametreler. Düz (POD) yapı, kalıcı kayıtta
+// bayt bayt saklanır: alan eklenir ya da değişirse ParamStore::LAYOUT
+// artırılmalı (eski kayıt reddedilir, varsayılanlar yüklenir).
+struct ParamSet {
+    uint8_t speed;          // Sabit komutların varsayılan hızı (0..255)
+    uint8_t minPwm;         // Kalkış eşiği (ölü bölge telafisi)
+    uint16_t accelPerSec;   // Rampa, PWM birimi / s
+    uint16_t decelPerSec;
+    int16_t turnRatio;      // Q15: dönüşte iç teker bu oranda geri (0.7)
+    int16_t curveRatio;     // Q15: kavisli sürüşte iç teker bu oranda ileri (0.5)
+    uint8_t volume;         // DFPlayer (0..30)
+    uint8_t stationMode;    // 0: Access Point, 1: ev ağı (+ yedek AP)
+    char ssid[33];          // AP adı ya da bağlanılacak ağ
+    char password[65];      // Boş: açık ağ, yoksa 8..63 karakter
+};
+
+// Sürümlü, CRC'li kalıcı parametre deposu ve canlı ayar.
+//
+// Kayıt: 16 baytlık başlık (sihirli sayı, düzen sürümü, uzunluk, kayıt
+// sayacı, CRC32) + ParamSet, hal::configSector()'da (EEPROM sektörü).
+// begin() açılışta kaydı RAM'deki sektör kopyasından okur ve doğrular
+// (µs); boş, bozuk ya da eski düzenli kayıtta derlemedeki varsayılanlar
+// kullanılır.
+//
+// Canlı ayar iki kopyayla yapılır: WebSocket komutları yalnızca gölge
+// kopyayı (shadow) düzenler; apply() gölgeyi yayınlar. Yayın
+// SetpointMailbox ile aynı seqlock'tur: okuyanlar (motor tick'i, ses
+// döngüsü) take() ile seti kendi sınırlarında bütün olarak alır, yarım
+// yazılmış set görmez. save() yayına ek olarak kalıcı yazım ister; yazım
+// flash'ı bloke ettiğinden poll()'da, motorlar dururken yapılır.
+//
+// WiFi alanları WiFiManager::begin()'de okunur, yeniden başlatmada geçerli
+// olur ("restart"); yedek AP sabit kalır (yanlış ağ bilgisinde kurtarma).
+class ParamStore {
+public:
+    static const uint32_t MAGIC = 0x31504352;   // "RCP1"
+    static const uint16_t LAYOUT = 1;           // ParamSet düzeni
+    static const size_t HEADER_SIZE = 16;
+    static const size_t RECORD_SIZE = HEADER_SIZE + sizeof(ParamSet);
+
+    enum Source : uint8_t {
+        SOURCE_DEFAULTS,    // Kayıt yok (silinmiş sektör)
+        SOURCE_STORED,
+        SOURCE_INVALID      // CRC/düzen/aralık hatası, varsayılanlar kullanıldı
+    };
+
+private:
+    hal::BlockFile* storage = nullptr;
+
+    ParamSet shadow;                    // Düzenlenen (ağ geri çağrıları)
+    std::atomic<uint32_t> version;      // seqlock: tekken yayın yazılıyor
+    ParamSet published;                 // Okuyanların aldığı
+
+    Source source = SOURCE_DEFAULTS;
+    uint32_t revision = 0;              // Kalıcı yazım sayacı (kayıtta)
+    uint32_t bootWifiCrc = 0;           // Açılıştaki WiFi alanları
+    uint32_t loadUs = 0;
+    uint32_t saves = 0;
+    uint32_t saveErrors = 0;
+    volatile bool saveRequested = false;
+    const char* rejected = nullptr;     // Son reddedilen alan (yoksa nullptr)
+    volatile uint32_t changes = 0;      // Durum değişince artar (yayın olayı)
+
+    void publish();
+
+public:
+    ParamStore();
+
+    static void defaults(ParamSet& out);
+    static bool isValid(const ParamSet& set);
+
+    // Açılışta, okuyanlar bağlanmadan önce: kaydı yükler ve yayınlar.
+    // file nullptr ise varsayılanlarla çalışır, kaydedilemez.
+    void begin(hal::BlockFile* file);
+
+    // Gölgede tek alan: sayılar value ile, metinler text ile (ad/aralık
+    // hatasında false, gölge değişmez). Oranlar kablo ölçeğinde (0..1000).
+    bool set(const char* name, int32_t value, const char* text);
+    void apply();       // Gölgeyi yayınla (okuyanlar kendi sınırlarında alır)
+    void save();        // apply() + kalıcı yazım isteği
+    void revert();      // Gölge = yayındaki
+    void reset();       // Gölge = varsayılanlar (apply()/save() ile yayınlanır)
+
+    // Düşük öncelikli görev: istenmişse ve idle ise kaydı yazar
+    void poll(bool idle);
+
+    // lastVersion'dan sonra yayın olduysa out'a kopyalar ve true döner
+    bool take(ParamSet& out, uint32_t& lastVersion) const {
+        for (;;) {
+            uint32_t v1 = version.load(std::memory_order_acquire);
+            if (v1 == lastVersion) return false;
+            if (v1 & 1) continue; // Yazma sürüyor
+
+            ParamSet copy = published;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint32_t v2 = version.load(std::memory_order_relaxed);
+            if (v1 != v2) continue; // Okuma sırasında üzerine yazıldı
+
+            out = copy;
+            lastVersion = v1;
+            return true;
+        }
+    }
+
+    const ParamSet& getShadow() const { return shadow; }
+    Source getSource() const { return source; }
+    uint32_t getLoadUs() const { return loadUs; }
+    uint32_t getChanges() const { return changes; }
+    static const char* sourceName(Source value);
+
+    // WebSocket: {"type":"params","rev":..,"source":..,"dirty":..,
+    //  "save_pending":..,"restart":..,"rejected":..,"set":{gölge}}
+    // (şifre gönderilmez, yalnızca uzunluğu)
+    size_t writeEvent(char* buf, size_t size) const;
+
+    // {"rev":..,"source":..,"load_us":..,"saves":..,"save_errors":..}
+    size_t writeJson(char* buf, size_t size) const;
+};
+
+#endif
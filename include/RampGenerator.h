@@ -0,0 +1,137 @@
+#ifndef RAMP_GENERATOR_H
+#define RAMP_GENERATOR_H
+
+#include <stdint.h>
+
+// Teker başına ivme/jerk sınırlı hız rampası.
+//
+// Donanımdan bağımsızdır (saf hesap), kontrol tick'inde bir kez step()
+// çağrılır. Tüm hesap tamsayı Q8 sabit noktadadır (değer << 8), FPU'suz
+// Tensilica çekirdeğinde ucuzdur.
+//
+// - Hız büyüklüğü artarken accel, azalırken (sıfıra doğru) decel sınırı
+//   kullanılır. Yön değişimi önce sıfıra yavaşlar, sonra hızlanır.
+// - jerk > 0 ise ivmenin kendisi de sınırlanır (S-eğrisi); hedefe
+//   yaklaşırken ivme, aşma olmayacak şekilde erkenden düşürülür.
+// - jerk == 0 ise klasik trapez profil uygulanır.
+struct RampConfig {
+    uint16_t accelPerSec;   // PWM birimi / s
+    uint16_t decelPerSec;   // PWM birimi / s
+    uint32_t jerkPerSec2;   // PWM birimi / s^2, 0: sınırsız (trapez)
+};
+
+class RampGenerator {
+private:
+    int32_t velocity = 0;   // Q8
+    int32_t rate = 0;       // Q8 / tick (S-eğrisi için mevcut ivme)
+
+    int32_t accelStep = 0;  // Q8 / tick
+    int32_t decelStep = 0;  // Q8 / tick
+    int32_t jerkStep = 0;   // Q8 / tick^2
+
+    static int32_t perTick(uint32_t perSec, uint32_t tickHz) {
+        int32_t step = (int32_t)((perSec << 8) / tickHz);
+        return step > 0 ? step : 1;
+    }
+
+    static uint32_t isqrt(uint32_t x) {
+        uint32_t result = 0;
+        uint32_t bit = 1UL << 30;
+        while (bit > x) bit >>= 2;
+        while (bit) {
+            if (x >= result + bit) {
+                x -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return result;
+    }
+
+public:
+    void configure(const RampConfig& config, uint32_t tickHz) {
+        accelStep = perTick(config.accelPerSec, tickHz);
+        decelStep = perTick(config.decelPerSec, tickHz);
+        jerkStep = config.jerkPerSec2 ? perTick(config.jerkPerSec2, tickHz * tickHz) : 0;
+    }
+
+    // Bir tick ilerlet, yeni hızı (PWM birimi, işaretli) döndür
+    int16_t step(int16_t target) {
+        int32_t goal = (int32_t)target << 8;
+
+        // Sıfırın karşı tarafındaki hedefe önce sıfıra inerek gidilir
+        if ((velocity > 0 && goal < 0) || (velocity < 0 && goal > 0)) {
+            goal = 0;
+        }
+
+        int32_t err = goal - velocity;
+        if (err == 0) {
+            rate = 0;
+            return value();
+        }
+
+        bool slowingDown = (velocity > 0 && err < 0) || (velocity < 0 && err > 0);
+        int32_t limit = slowingDown ? decelStep : accelStep;
+        int32_t distance = err < 0 ? -err : err;
+
+        int32_t desired = distance < limit ? distance : limit;
+        if (jerkStep) {
+            // Aşmadan durabilmek için: rate^2 / (2 * jerk) <= kalan mesafe
+            int32_t brake = (int32_t)isqrt((uint32_t)(2 * jerkStep) * (uint32_t)distance);
+            if (brake < desired) desired = brake;
+            if (desired == 0) desired = 1;
+        }
+        if (err < 0) desired = -desired;
+
+        if (jerkStep) {
+            // İvme değişimini sınırla; hedef yönünün tersine ivme taşınmaz
+            if ((desired > 0 && rate < 0) || (desired < 0 && rate > 0)) rate = 0;
+            if (rate < desired) {
+                rate = (desired - rate > jerkStep) ? rate + jerkStep : desired;
+            } else if (rate > desired) {
+                rate = (rate - desired > jerkStep) ? rate - jerkStep : desired;
+            }
+        } else {
+            rate = desired;
+        }
+
+        velocity += rate;
+
+        // Hedef geçildiyse hedefe sabitle
+        if ((err > 0 && velocity >= goal) || (err < 0 && velocity <= goal)) {
+            velocity = goal;
+            rate = 0;
+        }
+        return value();
+    }
+
+    // Rampayı atla (acil durdurma): hız ve ivme anında ayarlanır
+    void reset(int16_t value = 0) {
+        velocity = (int32_t)value << 8;
+        rate = 0;
+    }
+
+    int16_t value() const {
+        // Sıfıra doğru yuvarla; kesirli hız PWM'e yansımaz
+        return (int16_t)(velocity >= 0 ? velocity >> 8 : -((-velocity) >> 8));
+    }
+};
+
+// Ölü bölge (deadband) telafisi: motorun kalkış eşiği altındaki PWM
+// değerleri tekeri döndürmez. Sert MIN_PWM kıstırması yerine sıfır olmayan
+// her komut [minPwm, maxPwm] aralığına doğrusal olarak eşlenir; böylece
+// rampa düşük hızlarda da sürekli ve monoton kalır.
+inline int16_t compensateDeadband(int16_t speed, int16_t minPwm, int16_t maxPwm) {
+    if (speed == 0) return 0;
+
+    int32_t magnitude = speed < 0 ? -(int32_t)speed : speed;
+    if (magnitude > maxPwm) magnitude = maxPwm;
+
+    int32_t out = minPwm + (magnitude * (maxPwm - minPwm) + maxPwm - 1) / maxPwm;
+    if (out > maxPwm) out = maxPwm;
+    return (int16_t)(speed < 0 ? -out : out);
+}
+
+#endif
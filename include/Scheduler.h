@@ -0,0 +1,83 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ControlTimer.h"
+
+// Dönüşlü (cooperative) görev zamanlayıcısı ve görev başına CPU muhasebesi.
+//
+// Bileşenler (motor tick'i, web, ses, WiFi, OTA, log) periyot ve öncelikle
+// kaydolur; loop() her geçişte runPass() çağırır, ardından yield() ile
+// WiFi yığınına zaman verir (sabit delay() yok). Bir geçişte zamanı gelen
+// görevler öncelik sırasıyla (büyük önce) çalışır. Görevler kesilmez:
+// uzun süren bir görev sonrakileri geciktirir, bu yüzden çalışma süresi
+// bütçeyi aşarsa "overrun" sayılır.
+//
+// Periyodik görevlerin zamanlaması ControlTimer'dır (kaçırılan periyotlar
+// telafi edilmez, "late" olarak sayılır); periyodu 0 olan görev her
+// geçişte çalışır. İstatistikler 1 sn'lik pencerelerle tutulur: döngü
+// frekansı, toplam yük ve görev başına CPU payı (binde).
+class Scheduler {
+public:
+    typedef void (*TaskFn)(uint32_t nowUs);
+
+    // main.cpp 10 görev kaydeder (batarya dahil); 2 yuva pay. /api/tasks
+    // tamponu bu sayıyla boyutlanır (görev başına ~190 bayt)
+    static const uint8_t MAX_TASKS = 12;
+    static const uint32_t WINDOW_US = 1000000;
+
+    struct Task {
+        const char* name = "";
+        TaskFn run = nullptr;
+        uint8_t priority = 0;
+        uint32_t budgetUs = 0;      // 0: sınırsız
+        ControlTimer timer;         // periyot 0 ise kullanılmaz
+
+        uint32_t runs = 0;
+        uint64_t busyUs = 0;
+        uint32_t maxUs = 0;
+        uint32_t overruns = 0;      // Çalışma süresi > budgetUs
+        uint32_t windowBusyUs = 0;
+        uint32_t lastWindowBusyUs = 0;
+    };
+
+private:
+    Task tasks[MAX_TASKS];
+    uint8_t count = 0;
+
+    uint32_t passes = 0;
+    uint32_t windowStart = 0;
+    uint32_t windowPasses = 0;
+    uint32_t windowBusyUs = 0;
+    bool windowStarted = false;
+
+    uint32_t loopHz = 0;        // Son pencerede geçiş sayısı
+    uint32_t loadPermille = 0;  // Son pencerede görevlerde geçen süre (binde)
+    uint32_t maxPassUs = 0;
+
+    void rollWindow(uint32_t nowUs);
+
+public:
+    // Görevi ekler; tablo doluysa false. Öncelik eşitse ekleme sırası korunur.
+    bool add(const char* name, TaskFn run, uint32_t periodUs, uint8_t priority,
+             uint32_t budgetUs = 0);
+
+    // Zamanı gelen görevleri öncelik sırasıyla bir kez çalıştırır
+    void runPass(uint32_t nowUs);
+
+    uint8_t size() const { return count; }
+    const Task& task(uint8_t index) const { return tasks[index]; }
+    uint32_t getLoopHz() const { return loopHz; }
+    uint32_t getLoadPermille() const { return loadPermille; }
+
+    // {"loop_hz":..,"load_pm":..,"pass_max_us":..}
+    size_t writeSummary(char* buf, size_t size) const;
+
+    // Özet + "tasks":[{"name":..,"prio":..,"period_us":..,"runs":..,
+    //  "avg_us":..,"max_us":..,"cpu_pm":..,"late":..,"overruns":..,
+    //  "jitter_max_us":..},...]
+    size_t writeJson(char* buf, size_t size) const;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef SETPOINT_MAILBOX_H
+#define SETPOINT_MAILBOX_H
+
+#include <stdint.h>
+#include <atomic>
+#include "LatencyStats.h"
+
+// Ağ callback'leri ile kontrol döngüsü arasındaki tek yuvalı posta kutusu.
+//
+// Yazan (WebSocket/HTTP handler) her zaman en son hedefi üzerine yazar,
+// okuyan (kontrol tick'i) yalnızca en güncel değeri görür. Kilitsizdir:
+// sürüm sayacı tek iken yazma sürüyor demektir (seqlock), okuyan yırtık
+// (torn) bir değer görürse tekrar dener. Tek yazan varsayılır.
+struct Setpoint {
+    int16_t left;
+    int16_t right;
+    bool deadband;        // Ölü bölge telafisi (joystick/kablo birimli komutlar)
+    LatencyTrace trace;   // Ölçülen komutlar için zaman damgaları
+};
+
+class SetpointMailbox {
+private:
+    std::atomic<uint32_t> version;
+    Setpoint slot;
+
+public:
+    SetpointMailbox() : version(0), slot() {}
+
+    void post(const Setpoint& value) {
+        uint32_t v = version.load(std::memory_order_relaxed);
+        version.store(v + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot = value;
+        std::atomic_thread_fence(std::memory_order_release);
+        version.store(v + 2, std::memory_order_relaxed);
+    }
+
+    void post(int16_t left, int16_t right) {
+        Setpoint value = {};
+        value.left = left;
+        value.right = right;
+        value.deadband = true;
+        post(value);
+    }
+
+    // lastVersion'dan sonra yeni bir değer yazıldıysa out'a kopyalar ve true döner
+    bool take(Setpoint& out, uint32_t& lastVersion) const {
+        for (;;) {
+            uint32_t v1 = version.load(std::memory_order_acquire);
+            if (v1 == lastVersion) return false;
+            if (v1 & 1) continue; // Yazma sürüyor
+
+            Setpoint copy = slot;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint32_t v2 = version.load(std::memory_order_relaxed);
+            if (v1 != v2) continue; // Okuma sırasında üzerine yazıldı
+
+            out = copy;
+            lastVersion = v1;
+            return true;
+        }
+    }
+};
+
+#endif
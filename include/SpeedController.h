@@ -0,0 +1,124 @@
+#ifndef SPEED_CONTROLLER_H
+#define SPEED_CONTROLLER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Teker hız kontrolü ayarları
+struct SpeedConfig {
+    uint16_t countsPerRev;      // Enkoder kenarı / teker turu
+    uint16_t maxCountsPerSec;   // PWM_MAX'taki hız; komut -> hedef hız ölçeği
+    uint16_t kp;                // PWM / tam ölçek hata
+    uint16_t ki;                // PWM / (tam ölçek hata * s)
+    uint16_t rateHz;            // update() frekansı
+};
+
+// Tek teker için sabit noktalı PI hız denetleyicisi (ileri besleme + düzeltme).
+//
+// Rampa çıkışı (±PWM_MAX) hem ileri besleme hem de hedef hızdır:
+// hedef = komut * maxCountsPerSec / PWM_MAX. Enkoder sayacından ölçülen
+// hızla fark PI'dan geçer, çıkan düzeltme komuta eklenir. Böylece enkoder
+// yokken ya da düzeltme sıfırken davranış açık çevrimle aynıdır; PI yalnızca
+// batarya, yük ve iki motor arasındaki farkı telafi eder.
+//
+// Hata Q15'tir (tam ölçek = maxCountsPerSec, ±32767'ye kırpılır); kp/ki en
+// fazla 65535 olduğundan çarpımlar int32'ye sığar. İntegral Q15 PWM
+// biriktirir; çıkış doyumdayken aynı yöne büyümez (anti-windup).
+// Hız iki güncelleme penceresinden, gerçek geçen süreyle ölçülür:
+// pencere düşük çözünürlüklü enkoderde niceleme gürültüsünü yarıya indirir,
+// ölçülen süre de zamanlayıcı gecikmesi ya da kaçırılan tick'lerde hızın
+// yanlı hesaplanmasını önler (integral nominal periyotla kalır).
+class SpeedController {
+private:
+    SpeedConfig config = { 420, 1500, 300, 4800, 50 };
+
+    int32_t counts[2] = { 0, 0 };   // Son iki güncellemedeki sayaç
+    uint32_t times[2] = { 0, 0 };   // ve zamanı (µs)
+    bool primed = false;
+    int32_t measured = 0;           // counts/s
+    int32_t target = 0;             // counts/s
+    int32_t integral = 0;           // Q15 PWM
+    int16_t correction = 0;         // PWM
+    uint32_t saturations = 0;
+
+    static int32_t clamp(int32_t v, int32_t limit) {
+        return v > limit ? limit : (v < -limit ? -limit : v);
+    }
+
+public:
+    void configure(const SpeedConfig& cfg) {
+        config = cfg;
+        if (config.maxCountsPerSec == 0) config.maxCountsPerSec = 1;
+        if (config.rateHz == 0) config.rateHz = 1;
+        integral = 0;
+        correction = 0;
+    }
+
+    const SpeedConfig& getConfig() const { return config; }
+
+    // Sabit aralıkla (config.rateHz) çağrılır. command: bu tick'in rampa
+    // çıkışı, count: enkoder sayacı, nowUs: sayacın okunduğu an
+    void update(int16_t command, int32_t count, uint32_t nowUs, int16_t pwmMax) {
+        if (!primed) {
+            counts[0] = counts[1] = count;
+            times[0] = times[1] = nowUs - 1000000UL / config.rateHz;
+            primed = true;
+        }
+        uint32_t elapsed = nowUs - times[0];
+        if (elapsed > 0) {
+            measured = (int32_t)((int64_t)(count - counts[0]) * 1000000 / elapsed);
+        }
+        counts[0] = counts[1];
+        counts[1] = count;
+        times[0] = times[1];
+        times[1] = nowUs;
+
+        if (command == 0) {
+            // Dururken düzeltme birikmesin (kalkışta sıçrama yapmasın)
+            target = 0;
+            integral = 0;
+            correction = 0;
+            return;
+        }
+
+        target = (int32_t)command * config.maxCountsPerSec / pwmMax;
+        int32_t error = clamp((target - measured) * 32768 / config.maxCountsPerSec, 32767);
+        int32_t p = (int32_t)(((int64_t)config.kp * error) >> 15);
+        int32_t limit = (int32_t)pwmMax << 15;
+        int32_t next = clamp(integral + (int32_t)config.ki * error / (int32_t)config.rateHz, limit);
+
+        // Çıkış doyumdaysa integral yalnızca doyumdan çıkaran yönde değişir
+        int32_t out = command + p + (next >> 15);
+        bool saturated = out > pwmMax || out < -pwmMax;
+        if (saturated) saturations++;
+        if (!saturated || (out > pwmMax) != (next > integral)) {
+            integral = next;
+        }
+        correction = (int16_t)clamp(p + (integral >> 15), pwmMax);
+    }
+
+    // Her kontrol tick'inde: rampa çıkışı + son düzeltme
+    int16_t apply(int16_t command, int16_t pwmMax) const {
+        if (command == 0) return 0;
+        int32_t out = clamp((int32_t)command + correction, pwmMax);
+        // Düzeltme yönü çeviremez (frenleme PI'ın işi değil)
+        if ((out ^ command) < 0) return 0;
+        return (int16_t)out;
+    }
+
+    void reset() {
+        primed = false;
+        integral = 0;
+        correction = 0;
+        measured = 0;
+        target = 0;
+    }
+
+    int32_t countsPerSec() const { return measured; }
+    int32_t rpm() const { return measured * 60 / (int32_t)config.countsPerRev; }
+    int32_t targetRpm() const { return target * 60 / (int32_t)config.countsPerRev; }
+    int16_t getCorrection() const { return correction; }
+    uint32_t getSaturations() const { return saturations; }
+};
+
+#endif
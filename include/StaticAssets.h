@@ -0,0 +1,57 @@
+#ifndef STATIC_ASSETS_H
+#define STATIC_ASSETS_H
+
+#include <ESPAsyncWebServer.h>
+
+// LittleFS'teki önceden sıkıştırılmış web varlıklarını sunar.
+//
+// tools/build_assets.py her dosyayı yalnızca .gz olarak yazar ve içerik
+// özetlerini /assets.idx manifestine koyar. Manifest açılışta bir kez
+// sabit boyutlu tabloya okunur; istek başına dosya sistemi taranmaz.
+// - Yanıtlar Content-Encoding: gzip ve manifestteki ETag ile gönderilir.
+// - js/css gibi HTML'den ?v=<özet> ile yüklenen dosyalar bir yıl
+//   (immutable) önbelleklenir; HTML her açılışta ETag ile doğrulanır.
+// - If-None-Match eşleşirse gövdesiz 304 döner.
+//
+// -DEMBED_WEB_UI ile aynı paket flash'a PROGMEM olarak gömülür
+// (include/WebAssetsEmbedded.h, derlemede üretilir) ve send_P ile
+// kopyasız sunulur; LittleFS hiç bağlanmaz, ayrı FS imajı gerekmez.
+struct EmbeddedAsset {
+    const char* path;
+    const char* contentType;
+    const char* etag;
+    const uint8_t* data;    // PROGMEM, gzip
+    uint32_t length;
+};
+
+class StaticAssetHandler : public AsyncWebHandler {
+private:
+    static const uint8_t MAX_ASSETS = 16;
+    static const uint8_t MAX_PATH = 24;
+
+    struct Asset {
+        char path[MAX_PATH];
+        char etag[11];          // "1a2b3c4d" (tırnaklarla)
+    };
+
+#ifndef EMBED_WEB_UI
+    Asset assets[MAX_ASSETS];
+    uint8_t count = 0;
+
+    const Asset* find(const char* path) const;
+#endif
+
+    static const char* contentType(const char* path);
+    static bool isDocument(const char* path);
+
+public:
+    // Manifesti oku; okunan varlık sayısını döner (0: manifest yok).
+    // Gömülü derlemede yalnızca gömülü varlık sayısını döner.
+    uint8_t begin(const char* manifestPath = "/assets.idx");
+
+    bool canHandle(AsyncWebServerRequest* request) override;
+    void handleRequest(AsyncWebServerRequest* request) override;
+    bool isRequestHandlerTrivial() override { return true; }
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef UDP_CONTROL_H
+#define UDP_CONTROL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Hal.h"
+#include "DriveProtocol.h"
+
+class CommandProcessor;
+
+// İsteğe bağlı UDP sürüş kanalı (WebSocket'in yanında).
+//
+// TCP'de kaybolan tek paket yeniden iletilene kadar sonraki tüm joystick
+// çerçevelerini bekletir (head-of-line blocking). UDP'de her datagram
+// bağımsızdır: kayıp paket yalnızca kendisidir, sonraki çerçeve hemen
+// işlenir. Datagramlar WebSocket ile aynı 12 byte'lık çerçeveyi taşır
+// (DriveProtocol, önünde oturum belirteci) ve aynı CommandProcessor yolundan,
+// aynı DriveInbox'tan (seq, en yenisi kazanır, bayat atma) geçer.
+// FLAG_ACK_REQUEST'li çerçeveye OP_ACK aynı uç noktaya döner (RTT yankısı).
+//
+// Oturum: GET /api/udp belirteç verir (yenisi eskisini geçersiz kılar).
+// Belirteci tutmayan datagramlar atılır; ACK'ler son geçerli datagramın
+// geldiği uç noktaya gider. Belirteç kimlik doğrulama değildir, ağdaki
+// başıboş/eski istemcilerin aracı sürmesini önler.
+//
+// Arayüz, telemetri ve manevra yüklemesi WebSocket'te kalır.
+class UdpControl {
+public:
+    // CommandProcessor'daki istemci kimliği (WebSocket slotlarından ayrı)
+    static const uint8_t CLIENT_ID = 0xFE;
+    static const uint8_t MAX_PER_POLL = 8;     // Geçiş başına datagram sınırı
+
+private:
+    CommandProcessor* processor;
+    hal::DatagramSocket* socket = nullptr;
+    uint16_t port;
+
+    volatile uint32_t token = 0;               // 0: oturum yok
+    hal::Endpoint peer = {};
+    bool hasPeer = false;
+    bool tracking = false;
+    uint16_t lastSeq = 0;
+
+    uint32_t received = 0;
+    uint32_t malformed = 0;     // Boyut/opcode geçersiz
+    uint32_t rejected = 0;      // Belirteç tutmuyor
+    uint32_t lost = 0;          // seq boşluklarından tahmin
+    uint32_t acks = 0;
+    uint32_t sendErrors = 0;
+
+public:
+    UdpControl(CommandProcessor* commandProcessor, uint16_t udpPort);
+
+    // Soketi açar; açılamazsa kanal kapalı kalır
+    bool begin();
+    bool isOpen() const { return socket != nullptr; }
+    uint16_t getPort() const { return port; }
+
+    // Yeni oturum belirteci (öncekini geçersiz kılar)
+    uint32_t openSession();
+    uint32_t getToken() const { return token; }
+
+    // Bekleyen datagramları CommandProcessor'a aktarır; ardından
+    // CommandProcessor::flush() en yenisini uygular
+    void poll();
+
+    // hal::Transport sahibi CLIENT_ID'li yanıtları buraya yönlendirir.
+    // Yalnızca çerçeve boyutunda ikili yanıt (OP_ACK) taşınır.
+    bool sendBinary(const uint8_t* data, size_t length);
+
+    // {"port":..,"session":..,"rx":..,"malformed":..,"rejected":..,"lost":..,
+    //  "acks":..,"send_errors":..}
+    size_t writeJson(char* buf, size_t size) const;
+};
+
+#endif
@@ -2,32 +2,105 @@
 #define WEB_SERVER_MANAGER_H
 
 #include <ESPAsyncWebServer.h>
-#include <WebSocketsServer.h>
-#include <ArduinoJson.h>
+#include "Hal.h"
 #include "MotorController.h"
 #include "AudioManager.h"
+#include "CommandProcessor.h"
+#include "StaticAssets.h"
+#include "WiFiManager.h"
+#include "Scheduler.h"
+#include "HeapMonitor.h"
+#include "DriveRecorder.h"
+#include "UdpControl.h"
+#include "BatteryMonitor.h"
+#include "ParamStore.h"
 
-class WebServerManager {
+// UDP sürüş kanalı portu; 0 kapatır (build_flags: -DUDP_CONTROL_PORT=0)
+#ifndef UDP_CONTROL_PORT
+#define UDP_CONTROL_PORT 4210
+#endif
+
+// HTTP ve WebSocket (/ws) tek AsyncWebServer üzerinde, port 80.
+// WebSocket çerçeveleri LwIP geri çağrısında CommandProcessor'a gider
+// (yoklama yok); sürüş çerçeveleri DriveInbox'ta birikir, loop()
+// geçişinin sonunda en yenisi uygulanır. Yanıtlar hal::Transport olarak
+// WebSocket'e yazılır; UdpControl::CLIENT_ID'ye gidenler UDP'ye.
+//
+// Gönderim kuyrukları sınırlıdır (WS_MAX_QUEUED_MESSAGES, platformio.ini):
+// kuyruğu dolu istemciye yanıt yazılmaz (sayılır). Telemetri istemci
+// başına tek bekleyen işaretidir; kuyruk boşalmadan yeni telemetri
+// gelirse eskisi atılır ve gönderim anında en güncel durum yazılır.
+class WebServerManager : public hal::Transport {
 private:
     AsyncWebServer* server;
-    WebSocketsServer* webSocket;
+    AsyncWebSocket* webSocket;
     MotorController* motor;
     AudioManager* audio;
+    WiFiManager* wifi;
+    Scheduler* scheduler;
+    HeapMonitor* heap;
+    DriveRecorder* recorder;
+    BatteryMonitor* battery;        // nullptr: A0 ölçümü kapalı
+    ParamStore* params;
+    CommandProcessor* processor;
+    UdpControl* udp = nullptr;
+    StaticAssetHandler assets;
+    
+    static const uint8_t MAX_WS_CLIENTS = 4;
+    static const uint32_t TELEMETRY_INTERVAL_MS = 1000;
+    
+    // Her istemciye periyodik ping (yükte gönderim anı); pong'dan RTT
+    // ölçülür, art arda PONG_MISS_LIMIT ping yanıtsız kalırsa bağlantı
+    // kapatılır (TCP zaman aşımını beklemeden onDisconnect -> stop)
+    static const uint32_t PING_INTERVAL_MS = 1000;
+    static const uint8_t PONG_MISS_LIMIT = 3;
+    
+    // CommandProcessor istemcileri slot numarasıyla (0..MAX_WS_CLIENTS-1) tanır
+    struct ClientLink {
+        uint32_t id;                // AsyncWebSocketClient::id(), 0: boş slot
+        uint32_t lastPongMs;
+        bool telemetryPending;
+        bool paramsPending;         // Parametre durumu (bağlanınca ve her değişimde)
+    };
+    ClientLink links[MAX_WS_CLIENTS] = {};
+    uint32_t lastPing = 0;
+    uint32_t lastTelemetry = 0;
+    uint32_t batteryVersion = 0;    // Son yayınlanan batarya durumu
+    uint32_t paramsChanges = 0;     // Son yayınlanan parametre durumu
     
-    const int webSocketPort = 81;
+    uint32_t sendDropped = 0;       // Kuyruk dolu, yazılmayan yanıt
+    uint32_t telemetryDropped = 0;  // Gönderilemeden yenisiyle değişen telemetri
+    uint32_t fragmented = 0;        // Parçalı çerçeve (desteklenmez, atılır)
     
-    void handleWebSocketMessage(uint8_t num, uint8_t* payload, size_t length);
     void handleRoot(AsyncWebServerRequest* request);
     void handleCommand(AsyncWebServerRequest* request);
     void handleNotFound(AsyncWebServerRequest* request);
+    void handleStats(AsyncWebServerRequest* request);
+    void handleTasks(AsyncWebServerRequest* request);
+    void handleHeap(AsyncWebServerRequest* request);
+    void handleRecord(AsyncWebServerRequest* request);
+    void handleUdp(AsyncWebServerRequest* request);
+    void onWebSocketEvent(AsyncWebSocketClient* client, AwsEventType type,
+                          void* arg, uint8_t* data, size_t length);
+    int8_t slotOf(uint32_t id) const;
+    AsyncWebSocketClient* clientAt(uint8_t slot);
+    void queueTelemetry();
+    void flushTelemetry();
+    void pingClients(uint32_t now);
+    void broadcastBattery();
+    void flushParams();
+    size_t writeStats(char* buf, size_t size);
     
 public:
-    WebServerManager(MotorController* motorController, AudioManager* audioManager);
+    WebServerManager(MotorController* motorController, AudioManager* audioManager, WiFiManager* wifiManager,
+                     Scheduler* taskScheduler, HeapMonitor* heapMonitor, DriveRecorder* driveRecorder,
+                     BatteryMonitor* batteryMonitor, ParamStore* paramStore);
     void begin();
     void loop();
     
-    // WebSocket event handler
-    static void onWebSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
+    // hal::Transport
+    bool sendText(uint8_t client, const char* data, size_t length) override;
+    bool sendBinary(uint8_t client, const uint8_t* data, size_t length) override;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -2,25 +2,85 @@
 #define WIFI_MANAGER_H
 
 #include <ESP8266WiFi.h>
-#include <ESPAsyncWebServer.h>
-#include <WebSocketsServer.h>
 
+// Engellemeyen WiFi bağlantı durum makinesi.
+//
+// Station modunda AP+STA birlikte çalışır: yedek AP (RC_Araba_AP) hep
+// açıktır, ev ağına bağlantı koparken/yeniden kurulurken AP üzerinden
+// sürüş kesilmez. Bağlantı olayları (GotIP/Disconnected) SDK'dan gelir;
+// işleyiciler yalnızca bayrak kurar, durum geçişleri loop()'ta yapılır.
+// loop() hiç beklemez (mikrosaniyeler); başarısız denemeler arasında
+// üstel geri çekilme (1 sn -> 30 sn) uygulanır. Uzun aralıklar, STA
+// taraması sırasında AP istemcilerinin yaşadığı kanal takılmalarını da
+// seyrekleştirir.
 class WiFiManager {
+public:
+    enum State : uint8_t {
+        IDLE,
+        AP_ONLY,        // Yalnızca Access Point (varsayılan)
+        CONNECTING,     // WiFi.begin() çağrıldı, IP bekleniyor
+        CONNECTED,      // STA IP aldı
+        BACKOFF         // Deneme başarısız, sonraki denemeyi bekliyor
+    };
+
 private:
-    const char* ssid = "RC_Araba_AP";
-    const char* password = "12345678";
-    
-    // Veya istasyon modu için:
-    // const char* ssid = "Ev_WIFI_Adi";
-    // const char* password = "Ev_WIFI_Sifresi";
-    
-    bool apMode = true; // true: Access Point, false: Station
-    
+    // AP adı ya da bağlanılacak ağ; açılışta ParamStore'dan (setCredentials)
+    char ssid[33] = "RC_Araba_AP";
+    char password[65] = "12345678";
+
+    // Station modunda da açık kalan yedek AP
+    const char* apSsid = "RC_Araba_AP";
+    const char* apPassword = "12345678";
+
+    bool apMode = true; // true: Access Point, false: Station (+ yedek AP)
+
+    static const uint32_t CONNECT_TIMEOUT_MS = 10000;
+    static const uint32_t BACKOFF_MIN_MS = 1000;
+    static const uint32_t BACKOFF_MAX_MS = 30000;
+
+    State state = IDLE;
+    uint32_t stateSince = 0;
+    uint32_t backoffMs = BACKOFF_MIN_MS;
+    uint32_t downSince = 0;     // STA bağlantısının koptuğu (ya da ilk denemenin başladığı) an
+
+    // SDK olay işleyicilerinden loop()'a
+    volatile bool gotIpEvent = false;
+    volatile bool disconnectEvent = false;
+    volatile uint8_t disconnectReason = 0;
+
+    // Kayıt tutulmadıkça işleyiciler silinir
+    WiFiEventHandler gotIpHandler;
+    WiFiEventHandler disconnectHandler;
+
+    // Metrikler
+    uint32_t attempts = 0;
+    uint32_t connects = 0;
+    uint32_t disconnects = 0;
+    uint32_t lastConnectMs = 0; // Kopuştan IP alınana kadar geçen süre
+    uint32_t maxConnectMs = 0;
+    uint8_t lastReason = 0;
+
+    void enter(State next, uint32_t nowMs);
+    void startAttempt(uint32_t nowMs);
+
 public:
     void begin();
+
+    // Her loop() geçişinde çağrılır; hiç beklemez
+    void loop(uint32_t nowMs);
+
     String getIPAddress();
     bool isConnected();
     void setMode(bool accessPointMode);
+    // begin()'den önce; değerler kopyalanır (uzun olan kırpılır)
+    void setCredentials(const char* networkSsid, const char* networkPassword);
+
+    State getState() const { return state; }
+    static const char* stateName(State s);
+
+    // {"state":"..","attempts":..,"connects":..,"disconnects":..,
+    //  "connect_ms":..,"connect_ms_max":..,"reason":..,"rssi":..}
+    size_t writeJson(char* buf, size_t size) const;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,32 +1,150 @@
 #include "AudioManager.h"
-#include <SoftwareSerial.h>
-#include <DFRobotDFPlayerMini.h>
+#include <stdio.h>
+#include "Log.h"
 
-static SoftwareSerial* dfSerial = nullptr;
-static DFRobotDFPlayerMini dfPlayer;
+using namespace DFPlayerProtocol;
 
 AudioManager::AudioManager(uint8_t rxPin, uint8_t txPin)
     : rxPin(rxPin), txPin(txPin) {}
 
 void AudioManager::begin() {
-    dfSerial = new SoftwareSerial(rxPin, txPin);
-    dfSerial->begin(9600);
+    port = &hal::softSerial(rxPin, txPin, 9600);
 
-    if (!dfPlayer.begin(*dfSerial)) {
-        Serial.println("DFPlayer başlatılamadı!");
-        ready = false;
-        return;
+    // Modülün açılmasını (EVT_ONLINE) beklemeden devam; loop() takip eder
+    requestReset(hal::millis());
+    LOG_BOOT("DFPlayer başlatılıyor (arka planda)\n");
+}
+
+void AudioManager::requestReset(uint32_t nowMs) {
+    head = tail = 0;
+    txOffset = 0;
+    state = STARTING;
+    stateSince = nowMs;
+    startAttempts++;
+    enqueue(CMD_RESET, 0, false);
+}
+
+void AudioManager::setParams(const ParamStore* store) {
+    params = store;
+    paramsVersion = 0;
+    ParamSet set;
+    if (params && params->take(set, paramsVersion)) {
+        volume = set.volume;
+    }
+}
+
+void AudioManager::loop(uint32_t nowUs) {
+    if (!port) return;
+
+    uint32_t nowMs = hal::millis();
+    receive();
+
+    ParamSet set;
+    if (params && params->take(set, paramsVersion) && set.volume != volume) {
+        volume = set.volume;
+        // Hazır değilse EVT_ONLINE'da yeni seviye gönderilir
+        if (state == READY) enqueue(CMD_VOLUME, volume, true);
+    }
+    transmit(nowUs);
+
+    if (state == STARTING && nowMs - stateSince >= START_TIMEOUT_MS) {
+        if (startAttempts < START_RETRIES) {
+            requestReset(nowMs);
+        } else {
+            // Modül sonradan açılırsa EVT_ONLINE ile yine hazır olur
+            state = OFFLINE;
+            LOG_W("DFPlayer yanıt vermedi (%u deneme)\n", startAttempts);
+        }
+    }
+}
+
+bool AudioManager::enqueue(uint8_t command, uint16_t param, bool feedback) {
+    uint8_t next = (tail + 1) & (QUEUE_SIZE - 1);
+    if (next == head) {
+        dropped++;
+        return false;
+    }
+
+    Packet packet;
+    packet.command = command;
+    packet.feedback = feedback ? 1 : 0;
+    packet.param = param;
+    encode(packet, queue[tail]);
+    tail = next;
+    return true;
+}
+
+void AudioManager::transmit(uint32_t nowUs) {
+    if (head == tail) return;
+    if (nowUs - lastTxUs < TX_BYTE_GAP_US) return;
+
+    uint32_t start = hal::micros();
+    for (uint8_t i = 0; i < AUDIO_TX_BYTES_PER_PASS && head != tail; i++) {
+        port->write(queue[head][txOffset++]);
+        if (txOffset == PACKET_SIZE) {
+            txOffset = 0;
+            head = (head + 1) & (QUEUE_SIZE - 1);
+            sent++;
+        }
+    }
+    txBlock.record(hal::micros() - start);
+    lastTxUs = nowUs;
+}
+
+void AudioManager::receive() {
+    // Geçiş başına sınırlı: modül gürültü basarsa döngü takılmasın
+    for (uint8_t i = 0; i < PACKET_SIZE * 2; i++) {
+        int value = port->read();
+        if (value < 0) return;
+
+        Packet packet;
+        if (parser.push((uint8_t)value, packet)) {
+            handlePacket(packet);
+        }
     }
+}
 
-    dfPlayer.volume(20); // 0-30
-    dfPlayer.EQ(DFPLAYER_EQ_NORMAL);
-    ready = true;
-    Serial.println("DFPlayer hazır");
+void AudioManager::handlePacket(const Packet& packet) {
+    switch (packet.command) {
+        case EVT_ONLINE:
+            // Açılış ya da modülün kendiliğinden resetlenmesi: ayarları yeniden uygula
+            if (state != READY) {
+                LOG_I("DFPlayer hazır (cihaz maskesi %u)\n", packet.param);
+            }
+            state = READY;
+            playing = false;
+            enqueue(CMD_VOLUME, volume, true);
+            enqueue(CMD_EQ, 0, true);
+            break;
+
+        case EVT_ACK:
+            acks++;
+            break;
+
+        case EVT_ERROR:
+            errors++;
+            if (packet.param == ERROR_BUSY) {
+                LOG_D("DFPlayer meşgul\n");
+            } else {
+                LOG_W("DFPlayer hata kodu %u\n", packet.param);
+            }
+            break;
+
+        case EVT_TRACK_DONE:
+        case EVT_TRACK_DONE_U:
+            playing = false;
+            break;
+
+        default:
+            break;
+    }
 }
 
 void AudioManager::playTrack(uint16_t track) {
-    if (!ready) return;
-    dfPlayer.play(track);
+    if (!isReady()) return;
+    if (enqueue(CMD_PLAY_TRACK, track, true)) {
+        playing = true;
+    }
 }
 
 void AudioManager::playHorn() {
@@ -38,7 +156,7 @@ void AudioManager::playSiren() {
 }
 
 void AudioManager::playNextSong() {
-    if (!ready) return;
+    if (!isReady()) return;
 
     if (currentSong < songMin || currentSong >= songMax) {
         currentSong = songMin;
@@ -46,10 +164,27 @@ void AudioManager::playNextSong() {
         currentSong++;
     }
 
-    dfPlayer.play(currentSong);
+    playTrack(currentSong);
 }
 
 void AudioManager::stop() {
-    if (!ready) return;
-    dfPlayer.stop();
+    if (!isReady()) return;
+    enqueue(CMD_STOP, 0, true);
+    playing = false;
+}
+
+size_t AudioManager::writeJson(char* buf, size_t size) const {
+    if (size == 0) return 0;
+    static const char* const names[] = { "offline", "starting", "ready" };
+    uint8_t queued = (uint8_t)((tail - head) & (QUEUE_SIZE - 1));
+    int n = snprintf(buf, size,
+                     "{\"state\":\"%s\",\"playing\":%u,\"queued\":%u,\"sent\":%u,\"dropped\":%u,"
+                     "\"acks\":%u,\"errors\":%u,\"rx_errors\":%u,"
+                     "\"tx_block_p50\":%u,\"tx_block_p99\":%u,\"tx_block_max\":%u}",
+                     names[state], (unsigned)playing, (unsigned)queued, (unsigned)sent,
+                     (unsigned)dropped, (unsigned)acks, (unsigned)errors,
+                     (unsigned)parser.getErrors(), (unsigned)txBlock.percentile(50),
+                     (unsigned)txBlock.percentile(99), (unsigned)txBlock.max());
+    if (n < 0) return 0;
+    return (size_t)n < size ? (size_t)n : size - 1;
 }
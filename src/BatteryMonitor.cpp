@@ -0,0 +1,121 @@
+#include "BatteryMonitor.h"
+#include <stdio.h>
+#include "Hal.h"
+#include "Log.h"
+
+void BatteryMonitor::poll(uint32_t nowMs) {
+    (void)nowMs;
+    uint32_t sum = 0;
+    uint16_t minimum = 0xFFFF;
+    for (uint8_t i = 0; i < OVERSAMPLE; i++) {
+        uint16_t raw = hal::analogRead();
+        sum += raw;
+        if (raw < minimum) minimum = raw;
+    }
+    update(sum, minimum, OVERSAMPLE);
+}
+
+void BatteryMonitor::update(uint32_t sum, uint16_t minimum, uint8_t count) {
+    if (count == 0) return;
+    lastMv = (uint16_t)((sum * config.fullScaleMv + 1023u * count / 2) / (1023u * count));
+    dipMv = toMv(minimum);
+
+    if (!primed) {
+        filteredQ4 = (uint32_t)lastMv << 4;
+        primed = true;
+    } else {
+        // filtered += (örnek - filtered) / 2^FILTER_SHIFT
+        int32_t delta = ((int32_t)lastMv << 4) - (int32_t)filteredQ4;
+        filteredQ4 = (uint32_t)((int32_t)filteredQ4 + (delta >> FILTER_SHIFT));
+    }
+    uint16_t mv = getMillivolts();
+
+    // Durum (filtrelenmiş, histerezisli)
+    bool wasLow = state == LOW_VOLTAGE || state == CRITICAL;
+    if (mv < config.absentMv) {
+        setState(ABSENT);
+    } else if (mv < config.criticalMv ||
+               (state == CRITICAL && mv < config.criticalMv + HYSTERESIS_MV)) {
+        setState(CRITICAL);
+    } else if (mv < config.lowMv || (wasLow && mv < config.lowMv + HYSTERESIS_MV)) {
+        setState(LOW_VOLTAGE);
+    } else {
+        setState(NORMAL);
+    }
+
+    if (state == ABSENT) {
+        scaleQ12 = 4096;
+        pwmLimit = 255;
+        guarding = false;
+        return;
+    }
+    if (mv < minMv) minMv = mv;
+
+    // Çökme koruması: anlık en düşük okuma
+    if (dipMv < config.criticalMv) {
+        if (!guarding) {
+            guarding = true;
+            brownoutEvents++;
+            version++;
+            LOG_W("Batarya çöküşü: %u mV, PWM tavanı düşürülüyor\n", (unsigned)dipMv);
+        }
+        pwmLimit -= LIMIT_STEP_DOWN;
+        if (pwmLimit < LIMIT_MIN) pwmLimit = LIMIT_MIN;
+    } else if (dipMv >= config.criticalMv + HYSTERESIS_MV && pwmLimit < 255) {
+        pwmLimit += LIMIT_STEP_UP;
+        if (pwmLimit >= 255) {
+            pwmLimit = 255;
+            guarding = false;
+            version++;
+        }
+    }
+
+    // Koruma sürerken telafi duty'yi artırmaz (çöken bataryadan daha çok
+    // akım çekmek çöküşü derinleştirir)
+    uint32_t scale = mv ? ((uint32_t)config.nominalMv << 12) / mv : SCALE_MAX;
+    if (scale < SCALE_MIN) scale = SCALE_MIN;
+    if (scale > SCALE_MAX) scale = SCALE_MAX;
+    if (guarding && scale > 4096) scale = 4096;
+    scaleQ12 = (uint16_t)scale;
+}
+
+void BatteryMonitor::setState(State next) {
+    if (next == state) return;
+    if (next == LOW_VOLTAGE || next == CRITICAL) {
+        if (state != LOW_VOLTAGE && state != CRITICAL) lowEvents++;
+        LOG_W("Batarya düşük: %u mV (durum %u)\n", (unsigned)getMillivolts(), (unsigned)next);
+    }
+    state = next;
+    version++;
+}
+
+const char* BatteryMonitor::stateName(State value) {
+    switch (value) {
+        case NORMAL: return "ok";
+        case LOW_VOLTAGE: return "low";
+        case CRITICAL: return "critical";
+        default: return "absent";
+    }
+}
+
+size_t BatteryMonitor::writeJson(char* buf, size_t size) const {
+    if (size == 0) return 0;
+    int n = snprintf(buf, size,
+                     "{\"state\":\"%s\",\"mv\":%u,\"sample_mv\":%u,\"dip_mv\":%u,\"min_mv\":%u,"
+                     "\"scale_pct\":%u,\"pwm_limit\":%d,\"low_events\":%u,\"brownout_events\":%u}",
+                     stateName(state), (unsigned)getMillivolts(), (unsigned)lastMv, (unsigned)dipMv,
+                     minMv == 0xFFFF ? 0u : (unsigned)minMv, (unsigned)((scaleQ12 * 100u + 2048) >> 12),
+                     (int)pwmLimit, (unsigned)lowEvents, (unsigned)brownoutEvents);
+    if (n < 0) return 0;
+    return (size_t)n < size ? (size_t)n : size - 1;
+}
+
+size_t BatteryMonitor::writeEvent(char* buf, size_t size) const {
+    if (size == 0) return 0;
+    int n = snprintf(buf, size,
+                     "{\"type\":\"battery\",\"state\":\"%s\",\"mv\":%u,\"pwm_limit\":%d,\"guard\":%s}",
+                     stateName(state), (unsigned)getMillivolts(), (int)pwmLimit,
+                     guarding ? "true" : "false");
+    if (n < 0) return 0;
+    return (size_t)n < size ? (size_t)n : size - 1;
+}
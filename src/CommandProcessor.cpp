@@ -0,0 +1,350 @@
+#include "CommandProcessor.h"
+#include "Log.h"
+#include <ArduinoJson.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+CommandProcessor::CommandProcessor(MotorController* motorController, AudioManager* audioManager,
+                                   hal::Transport* transport)
+    : motor(motorController), audio(audioManager), transport(transport) {
+    motor->setLatencyStats(&latency);
+}
+
+void CommandProcessor::recordImmediate(LatencyTrace& trace, uint8_t type) {
+    trace.type = type;
+    trace.dispatchCycles = hal::cycleCount();
+    latency.record(trace, trace.dispatchCycles);
+}
+
+uint32_t CommandProcessor::droppedFrames() const {
+    return inbox.getSuperseded() + inbox.getReordered() + inbox.getStale();
+}
+
+void CommandProcessor::flush() {
+    DriveProtocol::Frame frame;
+    LatencyTrace trace;
+    if (inbox.take(frame, trace)) {
+        motor->traceNext(trace);
+        if (frame.opcode == DriveProtocol::OP_MIX) {
+            motor->drive(frame.left, frame.right);
+        } else {
+            motor->smoothTurn(frame.left, frame.right);
+        }
+    }
+    
+    if (motor->getManeuver().getVersion() != maneuverVersion) {
+        sendManeuverProgress();
+    }
+}
+
+void CommandProcessor::sendManeuverProgress() {
+    // Arada birden çok segment geçtiyse yalnızca son durum gider
+    const ManeuverRunner& maneuver = motor->getManeuver();
+    maneuverVersion = maneuver.getVersion();
+    
+    char buf[160];
+    size_t n = maneuver.writeProgress(buf, sizeof(buf));
+    if (n > 0) {
+        transport->sendText(maneuverClient, buf, n);
+    }
+}
+
+void CommandProcessor::onSession(uint8_t client) {
+    inbox.reset(client);
+}
+
+void CommandProcessor::onPong(uint8_t client, uint32_t rttMs) {
+    (void)client;
+    motor->getWatchdog().rttSample(rttMs);
+}
+
+void CommandProcessor::onConnect(uint8_t client) {
+    LOG_I("[%u] Bağlantı kuruldu\n", client);
+    inbox.reset(client);
+    // Güvenlik için motoru durdur
+    motor->stop();
+    
+    // İstemciye hoşgeldin mesajı gönder
+    static const char welcome[] = "{\"type\":\"welcome\",\"message\":\"RC Araba'ya hoş geldiniz!\"}";
+    transport->sendText(client, welcome, sizeof(welcome) - 1);
+}
+
+void CommandProcessor::onDisconnect(uint8_t client) {
+    LOG_I("[%u] Bağlantı kesildi\n", client);
+    if (client == driveClient) driveClient = NO_CLIENT;
+    inbox.reset(client);
+    motor->stop(); // Güvenlik için motorları durdur
+}
+
+const CommandProcessor::Binding CommandProcessor::HANDLERS[] = {
+    /* FORWARD */        { [](CommandProcessor& p, const CommandArgs&) { p.motor->forward(); }, CMD_MOVE },
+    /* BACKWARD */       { [](CommandProcessor& p, const CommandArgs&) { p.motor->backward(); }, CMD_MOVE },
+    /* TURN_LEFT */      { [](CommandProcessor& p, const CommandArgs&) { p.motor->turnLeft(); }, CMD_MOVE },
+    /* TURN_RIGHT */     { [](CommandProcessor& p, const CommandArgs&) { p.motor->turnRight(); }, CMD_MOVE },
+    /* FORWARD_LEFT */   { [](CommandProcessor& p, const CommandArgs&) { p.motor->forwardLeft(); }, CMD_MOVE },
+    /* FORWARD_RIGHT */  { [](CommandProcessor& p, const CommandArgs&) { p.motor->forwardRight(); }, CMD_MOVE },
+    /* BACKWARD_LEFT */  { [](CommandProcessor& p, const CommandArgs&) { p.motor->backwardLeft(); }, CMD_MOVE },
+    /* BACKWARD_RIGHT */ { [](CommandProcessor& p, const CommandArgs&) { p.motor->backwardRight(); }, CMD_MOVE },
+    /* PIVOT_LEFT */     { [](CommandProcessor& p, const CommandArgs&) { p.motor->pivotLeft(); }, CMD_MOVE },
+    /* PIVOT_RIGHT */    { [](CommandProcessor& p, const CommandArgs&) { p.motor->pivotRight(); }, CMD_MOVE },
+    /* STOP */           { [](CommandProcessor& p, const CommandArgs&) { p.motor->stop(); }, CMD_MOVE },
+    /* SET_SPEED */      { [](CommandProcessor& p, const CommandArgs& a) { p.motor->setSpeed(a.value); }, CMD_SPEED },
+    /* DRIVE */          { [](CommandProcessor& p, const CommandArgs& a) {
+                             LOG_D("Custom komut ALINDI: left=%d, right=%d\n", a.left, a.right);
+                             p.motor->smoothTurn(a.left, a.right);
+                         }, CMD_DRIVE_JSON },
+    /* DRIVE_MIXED */    { [](CommandProcessor& p, const CommandArgs& a) { p.motor->drive(a.throttle, a.steer); }, CMD_DRIVE_JSON },
+    /* SET_MIX_MODE */   { [](CommandProcessor& p, const CommandArgs& a) {
+                             p.motor->setMixMode((DriveMixer::Mode)a.value);
+                         }, CMD_NONE },
+    /* SET_CURVE */      { [](CommandProcessor& p, const CommandArgs& a) {
+                             p.motor->setCurve((DriveMixer::Curve)a.value);
+                         }, CMD_NONE },
+    /* MOVE */           { nullptr, CMD_NONE },
+    /* SOUND */          { nullptr, CMD_NONE },
+    /* HORN */           { [](CommandProcessor& p, const CommandArgs&) { p.audio->playHorn(); }, CMD_SOUND },
+    /* SIREN */          { [](CommandProcessor& p, const CommandArgs&) { p.audio->playSiren(); }, CMD_SOUND },
+    /* SONG_NEXT */      { [](CommandProcessor& p, const CommandArgs&) { p.audio->playNextSong(); }, CMD_SOUND },
+    /* SOUND_STOP */     { [](CommandProcessor& p, const CommandArgs&) { p.audio->stop(); }, CMD_SOUND },
+    /* PARAM_SET */      { [](CommandProcessor& p, const CommandArgs& a) {
+                             if (p.params) p.params->set(a.name, a.value, a.text);
+                         }, CMD_NONE },
+    /* PARAMS */         { nullptr, CMD_NONE },
+    /* PARAMS_APPLY */   { [](CommandProcessor& p, const CommandArgs&) { if (p.params) p.params->apply(); }, CMD_NONE },
+    /* PARAMS_SAVE */    { [](CommandProcessor& p, const CommandArgs&) { if (p.params) p.params->save(); }, CMD_NONE },
+    /* PARAMS_REVERT */  { [](CommandProcessor& p, const CommandArgs&) { if (p.params) p.params->revert(); }, CMD_NONE },
+    /* PARAMS_DEFAULTS */{ [](CommandProcessor& p, const CommandArgs&) { if (p.params) p.params->reset(); }, CMD_NONE },
+    /* KEEPALIVE */      { [](CommandProcessor& p, const CommandArgs& a) {
+                             if (a.client == p.driveClient) p.motor->feedWatchdog();
+                         }, CMD_NONE },
+};
+
+void CommandProcessor::execute(CommandRegistry::CommandId id, const CommandArgs& args, LatencyTrace& trace) {
+    static_assert(sizeof(HANDLERS) / sizeof(HANDLERS[0]) == CommandRegistry::COMMAND_COUNT,
+                  "Her CommandId için bir işleyici olmalı");
+    
+    const Binding& binding = HANDLERS[id];
+    if (!binding.handler) return;
+    
+    trace.type = binding.traceType;
+    if (binding.traceType == CMD_MOVE || binding.traceType == CMD_DRIVE_JSON) {
+        // Motor komutu: gecikme pin yazımında kaydedilir
+        driveClient = args.client;
+        motor->feedWatchdog();
+        motor->traceNext(trace);
+        binding.handler(*this, args);
+    } else {
+        binding.handler(*this, args);
+        recordImmediate(trace, binding.traceType);
+    }
+}
+
+bool CommandProcessor::handleControl(const char* command, uint32_t rxCycles) {
+    // "F", "S", "SPD:200" ...: token ':' öncesi, varsa argüman sonrası
+    const char* colon = strchr(command, ':');
+    size_t length = colon ? (size_t)(colon - command) : strlen(command);
+    
+    const CommandRegistry::Entry* entry = CommandRegistry::find(CommandRegistry::COMMANDS, command, length);
+    if (!entry) return false;
+    
+    CommandArgs args = {};
+    args.client = HTTP_CLIENT;
+    if (entry->args == CommandRegistry::ARG_VALUE) {
+        if (!colon) return false;
+        args.value = atoi(colon + 1);
+    } else if (entry->args != CommandRegistry::ARG_NONE || colon) {
+        return false;   // HTTP'de JSON alanı isteyen komut yok
+    }
+    
+    LatencyTrace trace = { CMD_NONE, rxCycles, hal::cycleCount(), 0 };
+    execute(entry->id, args, trace);
+    motor->cancelTrace();
+    return true;
+}
+
+void CommandProcessor::handleText(uint8_t client, uint8_t* payload, size_t length, uint32_t rxCycles) {
+    // Yerinde (zero-copy) ayrıştırma: char* girdide ArduinoJson dizgeleri
+    // kopyalamaz, payload içine işaret eder (sonlandırıcılar payload'a
+    // yazılır). Havuzda yalnızca üye düğümleri durur: 8 üye ~128 bayt, yığında.
+    StaticJsonDocument<128> doc;
+    deserializeJson(doc, (char*)payload, length);
+    
+    const char* cmd = doc["cmd"] | "";
+    LatencyTrace trace = { CMD_NONE, rxCycles, hal::cycleCount(), 0 };
+    
+    const CommandRegistry::Entry* entry = CommandRegistry::find(CommandRegistry::COMMANDS, cmd, strlen(cmd));
+    CommandArgs args = {};
+    args.client = client;
+    
+    if (entry) {
+        switch (entry->args) {
+            case CommandRegistry::ARG_NONE:
+                break;
+                
+            case CommandRegistry::ARG_VALUE:
+                args.value = doc["value"] | 0;
+                break;
+                
+            case CommandRegistry::ARG_LEFT_RIGHT:
+                args.left = doc["left"] | 0;
+                args.right = doc["right"] | 0;
+                break;
+                
+            case CommandRegistry::ARG_THROTTLE_STEER:
+                args.throttle = doc["throttle"] | 0;
+                args.steer = doc["steer"] | 0;
+                break;
+                
+            case CommandRegistry::ARG_DIRECTION: {
+                const char* direction = doc["direction"] | "";
+                entry = CommandRegistry::find(CommandRegistry::COMMANDS, direction, strlen(direction));
+                if (entry && entry->args != CommandRegistry::ARG_NONE) entry = nullptr;
+                break;
+            }
+                
+            case CommandRegistry::ARG_ACTION: {
+                if (!audio || !audio->isReady()) {
+                    LOG_W("DFPlayer hazır değil\n");
+                    recordImmediate(trace, CMD_SOUND);
+                    entry = nullptr;
+                    break;
+                }
+                const char* action = doc["action"] | "";
+                entry = CommandRegistry::find(CommandRegistry::SOUND_ACTIONS, action, strlen(action));
+                break;
+            }
+                
+            case CommandRegistry::ARG_PARAM:
+                // Metin değer (SSID, şifre) payload içine işaret eder; set() kopyalar
+                args.name = doc["name"] | "";
+                args.text = doc["value"] | (const char*)nullptr;
+                args.value = doc["value"] | 0;
+                break;
+                
+            case CommandRegistry::ARG_PARAM_ACTION: {
+                const char* action = doc["action"] | "";
+                entry = CommandRegistry::find(CommandRegistry::PARAM_ACTIONS, action, strlen(action));
+                break;
+            }
+        }
+    }
+    
+    if (entry) {
+        execute(entry->id, args, trace);
+    }
+    motor->cancelTrace();
+    
+    // Geri bildirim gönder (yığındaki tampondan, JsonDocument'siz)
+    char buf[48];
+    int n = snprintf(buf, sizeof(buf), "{\"status\":\"ok\",\"speed\":%d}", motor->getCurrentSpeed());
+    if (n > 0) {
+        transport->sendText(client, buf, (size_t)n);
+    }
+}
+
+void CommandProcessor::sendAck(uint8_t client, const DriveProtocol::Frame& frame) {
+    // Yığındaki (stack) tampondan gönderilir
+    DriveProtocol::Frame ack;
+    ack.opcode = DriveProtocol::OP_ACK;
+    ack.flags = motor->getWatchdog().hasFault() ? DriveProtocol::FLAG_FAULT : 0;
+    ack.seq = frame.seq;
+    ack.left = (int16_t)motor->getCurrentSpeed();
+    ack.right = (int16_t)(droppedFrames() & 0x7FFF);
+    ack.stamp = frame.stamp;
+    
+    uint8_t buf[DriveProtocol::FRAME_SIZE];
+    DriveProtocol::encode(ack, buf);
+    transport->sendBinary(client, buf, sizeof(buf));
+}
+
+void CommandProcessor::handleManeuver(uint8_t client, const uint8_t* payload, size_t length) {
+    using namespace DriveProtocol;
+    
+    uint8_t count = length >= MANEUVER_HEADER_SIZE ? payload[4] : 0;
+    bool ok = count > 0 && count <= ManeuverRunner::MAX_SEGMENTS &&
+              length == MANEUVER_HEADER_SIZE + count * MANEUVER_SEGMENT_SIZE;
+    
+    if (ok) {
+        ManeuverSegment segments[ManeuverRunner::MAX_SEGMENTS];
+        const uint8_t* p = payload + MANEUVER_HEADER_SIZE;
+        for (uint8_t i = 0; i < count; i++, p += MANEUVER_SEGMENT_SIZE) {
+            segments[i].kind = p[0];
+            segments[i].a = (int16_t)readU16(p + 1);
+            segments[i].b = (int16_t)readU16(p + 3);
+            segments[i].durationMs = readU16(p + 5);
+        }
+        ok = motor->getManeuver().stage(segments, count, payload[5]);
+    }
+    
+    if (!ok) {
+        LOG_W("[%u] Geçersiz manevra (%u byte)\n", client, (unsigned)length);
+        static const char rejected[] = "{\"type\":\"maneuver\",\"state\":\"rejected\"}";
+        transport->sendText(client, rejected, sizeof(rejected) - 1);
+        return;
+    }
+    
+    LOG_I("[%u] Manevra yüklendi: %u segment, %u tekrar\n", client, count, payload[5]);
+    maneuverClient = client;
+    driveClient = client;
+    // Aynı geçişte bekleyen joystick çerçevesi manevrayı hemen kesmesin
+    inbox.discard();
+    motor->feedWatchdog();
+    
+    if (payload[1] & FLAG_ACK_REQUEST) {
+        Frame frame = {};
+        frame.seq = readU16(payload + 2);
+        sendAck(client, frame);
+    }
+}
+
+void CommandProcessor::handleBinary(uint8_t client, const uint8_t* payload, size_t length, uint32_t rxCycles) {
+    if (length > 0 && payload[0] == DriveProtocol::OP_MANEUVER) {
+        handleManeuver(client, payload, length);
+        return;
+    }
+    
+    // Sabit düzenli ikili çerçeve - tahsis yok, kopya yok
+    DriveProtocol::Frame frame;
+    if (!DriveProtocol::decode(payload, length, frame)) {
+        return;
+    }
+    LatencyTrace trace = { CMD_DRIVE_BINARY, rxCycles, hal::cycleCount(), 0 };
+    DriveInbox::Verdict verdict = inbox.observe(client, frame, hal::millis());
+    
+    switch (frame.opcode) {
+        case DriveProtocol::OP_DRIVE:
+        case DriveProtocol::OP_MIX:
+            // Hemen uygulanmaz: geçişin sonunda yalnızca en yenisi (flush)
+            if (verdict == DriveInbox::FRESH) {
+                driveClient = client;
+                motor->feedWatchdog();
+                inbox.offer(frame, trace);
+            }
+            break;
+        case DriveProtocol::OP_STOP:
+            // Durdurma eski/bayat olsa bile uygulanır
+            inbox.discard();
+            driveClient = client;
+            motor->feedWatchdog();
+            motor->traceNext(trace);
+            motor->stop();
+            break;
+        case DriveProtocol::OP_SPEED:
+            motor->setSpeed(frame.left);
+            recordImmediate(trace, CMD_SPEED);
+            break;
+        case DriveProtocol::OP_KEEPALIVE:
+            // Bağlantı canlılığı: sürücü istemcinin bekçisini besler
+            // (bayat/sırasız değilse); istenirse aşağıda ACK ile RTT ölçülür
+            if (verdict == DriveInbox::FRESH && client == driveClient) {
+                motor->feedWatchdog();
+            }
+            break;
+    }
+    
+    // ACK sadece istenirse
+    if (frame.flags & DriveProtocol::FLAG_ACK_REQUEST) {
+        sendAck(client, frame);
+    }
+}
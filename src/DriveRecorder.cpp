@@ -0,0 +1,307 @@
+#include "DriveRecorder.h"
+#include <stdio.h>
+#include <string.h>
+#include "MotorController.h"
+#include "Log.h"
+
+using namespace DriveLog;
+
+DriveRecorder::DriveRecorder(MotorController* motorController)
+    : motor(motorController) {}
+
+void DriveRecorder::begin() {
+    file = hal::blockFile(PATH, BLOCK_SIZE, BLOCK_COUNT);
+    if (!file) {
+        LOG_BOOT("Sürüş kaydı: dosya sistemi yok, kapalı\n");
+        return;
+    }
+
+    // Son oturum: en büyük seq'li geçerli blok
+    bool found = false;
+    uint32_t maxSeq = 0;
+    uint8_t raw[HEADER_SIZE];
+    for (uint16_t i = 0; i < BLOCK_COUNT; i++) {
+        Header header;
+        if (!file->read(i, raw, sizeof(raw)) || !readHeader(raw, header)) continue;
+        if (!found || (int32_t)(header.seq - maxSeq) > 0) {
+            found = true;
+            maxSeq = header.seq;
+            session = header.session;
+        }
+    }
+    nextSeq = found ? maxSeq + 1 : 0;
+    state = IDLE;
+    LOG_BOOT("Sürüş kaydı: %s, son oturum %u\n", PATH, (unsigned)session);
+}
+
+bool DriveRecorder::scanSession(uint16_t wanted, uint32_t& minSeq, uint32_t& maxSeq) {
+    bool found = false;
+    uint8_t raw[HEADER_SIZE];
+    for (uint16_t i = 0; i < BLOCK_COUNT; i++) {
+        Header header;
+        if (!file->read(i, raw, sizeof(raw)) || !readHeader(raw, header)) continue;
+        if (header.session != wanted) continue;
+        if (!found || (int32_t)(header.seq - minSeq) < 0) minSeq = header.seq;
+        if (!found || (int32_t)(header.seq - maxSeq) > 0) maxSeq = header.seq;
+        found = true;
+    }
+    return found;
+}
+
+void DriveRecorder::requestReplay(uint8_t speed) {
+    if (speed < 1) speed = 1;
+    if (speed > MAX_REPLAY_SPEED) speed = MAX_REPLAY_SPEED;
+    requestedSpeed = speed;
+    request = REQ_REPLAY;
+}
+
+void DriveRecorder::poll(uint32_t nowMs) {
+    if (state == UNAVAILABLE) return;
+
+    uint8_t req = request;
+    request = REQ_NONE;
+    switch (req) {
+        case REQ_START:
+            if (state == REPLAYING) finishReplay();
+            if (state == IDLE) startRecording(nowMs);
+            break;
+        case REQ_STOP:
+            if (state == RECORDING) stopRecording();
+            if (state == REPLAYING) finishReplay();
+            break;
+        case REQ_REPLAY:
+            if (state == RECORDING) stopRecording();
+            // Kuyruktaki bloklar yazılmadan son oturum eksik okunur
+            if (queueCount == 0) {
+                startReplay(nowMs, requestedSpeed);
+            } else {
+                request = REQ_REPLAY;
+            }
+            break;
+        default:
+            break;
+    }
+
+    // Geçiş başına en fazla bir flash yazımı
+    if (queueCount > 0) {
+        writeQueued();
+    } else if (state == RECORDING && activeDirty && nowMs - lastFlushMs >= FLUSH_INTERVAL_MS) {
+        flushPartial(nowMs);
+    }
+
+    if (state == REPLAYING) {
+        stepReplay(nowMs);
+    }
+}
+
+void DriveRecorder::end() {
+    if (state == UNAVAILABLE) return;
+    if (state == RECORDING) stopRecording();
+    if (state == REPLAYING) finishReplay();
+
+    // Loop durmak üzere: kuyruktaki bloklar poll() beklenmeden yazılır
+    while (queueCount > 0) {
+        writeQueued();
+    }
+    file->close();
+    file = nullptr;
+    state = UNAVAILABLE;
+    request = REQ_NONE;
+    LOG_I("Sürüş kaydı kapatıldı\n");
+}
+
+// ---------------------------------------------------------------------------
+// Kayıt
+
+void DriveRecorder::startRecording(uint32_t nowMs) {
+    session++;
+    sessionStartMs = nowMs;
+    lastFlushMs = nowMs;
+    records = 0;
+    droppedBlocks = 0;
+    activeDirty = false;
+
+    Record start = { 0, 0, 0, 0 };
+    writer.begin(active, session, nextSeq++, start);
+    state = RECORDING;
+    LOG_I("Sürüş kaydı başladı (oturum %u)\n", (unsigned)session);
+}
+
+void DriveRecorder::stopRecording() {
+    // Son kısmi blok kuyruğa; kalan yazımlar sonraki poll()'larda
+    if (!writer.empty()) {
+        rotateBlock();
+    }
+    activeDirty = false;
+    state = IDLE;
+    LOG_I("Sürüş kaydı bitti (%u kayıt)\n", (unsigned)records);
+}
+
+void DriveRecorder::rotateBlock() {
+    writer.seal();
+    if (queueCount < QUEUE_BLOCKS) {
+        uint8_t tail = (uint8_t)((queueHead + queueCount) % QUEUE_BLOCKS);
+        memcpy(queue[tail], active, BLOCK_SIZE);
+        queueCount++;
+    } else {
+        droppedBlocks++;
+    }
+    Record last = writer.lastRecord();
+    writer.begin(active, session, nextSeq++, last);
+    activeDirty = false;
+}
+
+void DriveRecorder::writeQueued() {
+    if (writeBlock(queue[queueHead], BLOCK_SIZE)) {
+        blocksWritten++;
+    }
+    queueHead = (uint8_t)((queueHead + 1) % QUEUE_BLOCKS);
+    queueCount--;
+}
+
+bool DriveRecorder::writeBlock(const uint8_t* block, size_t length) {
+    Header header;
+    if (!readHeader(block, header)) return false;
+
+    uint32_t start = hal::micros();
+    bool ok = file->write(slotOf(header.seq), block, length);
+    writeUs.record(hal::micros() - start);
+    if (!ok) writeErrors++;
+    return ok;
+}
+
+void DriveRecorder::flushPartial(uint32_t nowMs) {
+    // Aynı yuva blok dolunca tam hâliyle yeniden yazılır
+    writer.seal();
+    writeBlock(active, writer.size());
+    lastFlushMs = nowMs;
+    activeDirty = false;
+}
+
+void DriveRecorder::onApplied(int16_t left, int16_t right, uint8_t source) {
+    if (state == REPLAYING) {
+        if (applying) return;
+        // Canlı komut oynatmayı geçersiz kılar
+        replayAborts++;
+        hasPending = false;
+        state = IDLE;
+        LOG_W("Oynatma canlı komutla kesildi\n");
+        return;
+    }
+    if (state != RECORDING) return;
+
+    Record record;
+    record.t = hal::millis() - sessionStartMs;
+    record.left = left;
+    record.right = right;
+    record.source = source;
+    if (!writer.append(record)) {
+        rotateBlock();
+        writer.append(record);
+    }
+    records++;
+    activeDirty = true;
+}
+
+// ---------------------------------------------------------------------------
+// Oynatma
+
+void DriveRecorder::startReplay(uint32_t nowMs, uint8_t speed) {
+    if (!scanSession(session, replaySeq, replayEndSeq)) {
+        LOG_W("Oynatılacak kayıt yok\n");
+        return;
+    }
+
+    replaySpeed = speed;
+    replayed = 0;
+    hasPending = false;
+    if (!loadReplayBlock() || !fetchReplay()) {
+        LOG_W("Kayıt bloğu okunamadı\n");
+        return;
+    }
+    replayT0 = pending.t;
+    replayBaseMs = nowMs;
+    state = REPLAYING;
+    LOG_I("Oynatma: oturum %u, %ux\n", (unsigned)session, (unsigned)speed);
+}
+
+bool DriveRecorder::loadReplayBlock() {
+    Header header;
+    while ((int32_t)(replaySeq - replayEndSeq) <= 0) {
+        if (file->read(slotOf(replaySeq), active, BLOCK_SIZE) &&
+            reader.begin(active, header) && header.session == session && header.seq == replaySeq) {
+            return true;
+        }
+        // Atılmış (kuyruk dolu) blok: sonrakinden devam
+        replaySeq++;
+    }
+    return false;
+}
+
+bool DriveRecorder::fetchReplay() {
+    while (!reader.next(pending)) {
+        replaySeq++;
+        if (!loadReplayBlock()) {
+            hasPending = false;
+            return false;
+        }
+    }
+    hasPending = true;
+    return true;
+}
+
+void DriveRecorder::stepReplay(uint32_t nowMs) {
+    uint32_t elapsed = (nowMs - replayBaseMs) * replaySpeed;
+    while (hasPending && elapsed >= pending.t - replayT0) {
+        applying = true;
+        if (pending.source == SOURCE_STOP) {
+            motor->stop();
+        } else {
+            // Sabit komutlar (move) kaydedildikleri gibi telafisiz PWM'dir
+            motor->setTarget(pending.left, pending.right, pending.source != CMD_MOVE);
+        }
+        applying = false;
+        replayed++;
+        fetchReplay();
+    }
+
+    if (!hasPending) {
+        finishReplay();
+        return;
+    }
+    motor->feedWatchdog();
+}
+
+void DriveRecorder::finishReplay() {
+    applying = true;
+    motor->setTarget(0, 0);
+    applying = false;
+    hasPending = false;
+    state = IDLE;
+    LOG_I("Oynatma bitti (%u kayıt)\n", (unsigned)replayed);
+}
+
+// ---------------------------------------------------------------------------
+
+const char* DriveRecorder::stateName(State s) {
+    switch (s) {
+        case IDLE: return "idle";
+        case RECORDING: return "recording";
+        case REPLAYING: return "replaying";
+        default: return "unavailable";
+    }
+}
+
+size_t DriveRecorder::writeJson(char* buf, size_t size) const {
+    if (size == 0) return 0;
+    int n = snprintf(buf, size,
+                     "{\"state\":\"%s\",\"session\":%u,\"records\":%u,\"blocks\":%u,\"dropped\":%u,"
+                     "\"write_errors\":%u,\"write_p99_us\":%u,\"write_max_us\":%u,"
+                     "\"replay_speed\":%u,\"replayed\":%u,\"replay_aborts\":%u}",
+                     stateName(state), (unsigned)session, (unsigned)records,
+                     (unsigned)blocksWritten, (unsigned)droppedBlocks, (unsigned)writeErrors,
+                     (unsigned)writeUs.percentile(99), (unsigned)writeUs.max(),
+                     (unsigned)replaySpeed, (unsigned)replayed, (unsigned)replayAborts);
+    if (n < 0) return 0;
+    return (size_t)n < size ? (size_t)n : size - 1;
+}
@@ -0,0 +1,21 @@
+#include "Esp8266GpioPort.h"
+#include <Arduino.h>
+
+void Esp8266GpioPort::configureOutput(uint8_t pin) {
+    pinMode(pin, OUTPUT);
+}
+
+void Esp8266GpioPort::writeMasks(uint32_t setMask, uint32_t clearMask) {
+    // Tek register yazımıyla birden çok pin (GPIO0..15)
+    if (setMask) GPOS = setMask;
+    if (clearMask) GPOC = clearMask;
+}
+
+void Esp8266GpioPort::writeGpio16(bool high) {
+    if (high) GP16O |= 1;
+    else GP16O &= ~1;
+}
+
+void Esp8266GpioPort::writePwm(uint8_t pin, uint16_t duty) {
+    analogWrite(pin, duty);
+}
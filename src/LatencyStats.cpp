@@ -0,0 +1,77 @@
+#include "LatencyStats.h"
+#include "Hal.h"
+#include <stdio.h>
+
+void LatencyStats::addStage(Stage& stage, uint32_t us) {
+    stage.count++;
+    stage.sumUs += us;
+    if (us > stage.maxUs) stage.maxUs = us;
+}
+
+const char* LatencyStats::typeName(uint8_t type) {
+    switch (type) {
+        case CMD_DRIVE_BINARY: return "drive_bin";
+        case CMD_DRIVE_JSON: return "drive_json";
+        case CMD_MOVE: return "move";
+        case CMD_SPEED: return "speed";
+        case CMD_SOUND: return "sound";
+        default: return "none";
+    }
+}
+
+void LatencyStats::record(const LatencyTrace& trace, uint32_t applyCycles) {
+    if (trace.type == CMD_NONE || trace.type >= CMD_TYPE_COUNT) return;
+
+    uint32_t perUs = hal::cyclesPerMicro();
+    PerType& t = types[trace.type];
+
+    // Cycle farkları işaretsiz çıkarma ile taşmaya (wrap) dayanıklıdır
+    t.total.record((applyCycles - trace.rxCycles) / perUs);
+    addStage(t.parse, (trace.parseCycles - trace.rxCycles) / perUs);
+    addStage(t.dispatch, (trace.dispatchCycles - trace.parseCycles) / perUs);
+    addStage(t.apply, (applyCycles - trace.dispatchCycles) / perUs);
+}
+
+void LatencyStats::reset() {
+    for (uint8_t i = 0; i < CMD_TYPE_COUNT; i++) {
+        types[i].total.reset();
+        types[i].parse = Stage{0, 0, 0};
+        types[i].dispatch = Stage{0, 0, 0};
+        types[i].apply = Stage{0, 0, 0};
+    }
+}
+
+size_t LatencyStats::writeJson(char* buf, size_t size) const {
+    if (size == 0) return 0;
+
+    size_t len = 0;
+    bool first = true;
+    int n = snprintf(buf, size, "{");
+    if (n > 0) len += n;
+
+    for (uint8_t i = CMD_NONE + 1; i < CMD_TYPE_COUNT && len < size; i++) {
+        const PerType& t = types[i];
+        if (t.total.count() == 0) continue;
+
+        n = snprintf(buf + len, size - len,
+                     "%s\"%s\":{\"n\":%u,\"p50\":%u,\"p99\":%u,\"max\":%u,"
+                     "\"parse\":%u,\"dispatch\":%u,\"apply\":%u,\"apply_max\":%u}",
+                     first ? "" : ",", typeName(i),
+                     (unsigned)t.total.count(),
+                     (unsigned)t.total.percentile(50),
+                     (unsigned)t.total.percentile(99),
+                     (unsigned)t.total.max(),
+                     (unsigned)(t.parse.count ? t.parse.sumUs / t.parse.count : 0),
+                     (unsigned)(t.dispatch.count ? t.dispatch.sumUs / t.dispatch.count : 0),
+                     (unsigned)(t.apply.count ? t.apply.sumUs / t.apply.count : 0),
+                     (unsigned)t.apply.maxUs);
+        if (n > 0) len += n;
+        first = false;
+    }
+
+    if (len < size) {
+        n = snprintf(buf + len, size - len, "}");
+        if (n > 0) len += n;
+    }
+    return len < size ? len : size - 1;
+}
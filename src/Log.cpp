@@ -0,0 +1,88 @@
+#include "Log.h"
+#include "Hal.h"
+#include <atomic>
+#include <stdio.h>
+
+namespace Log {
+
+#if LOG_LEVEL > LOG_LEVEL_NONE
+
+static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE 2'nin kuvveti olmalı");
+
+static Record ring[LOG_RING_SIZE];
+static std::atomic<uint16_t> head(0);   // Sıradaki yazma konumu
+static std::atomic<uint16_t> tail(0);   // Sıradaki okuma konumu
+static uint32_t droppedCount = 0;
+
+static const char levelChar[] = { '-', 'E', 'W', 'I', 'D' };
+
+void pushRecord(uint8_t level, const char* fmt, const int32_t* args, uint8_t count) {
+    uint16_t h = head.load(std::memory_order_relaxed);
+    uint16_t next = (h + 1) & (LOG_RING_SIZE - 1);
+    if (next == tail.load(std::memory_order_acquire)) {
+        droppedCount++; // Tampon dolu: en yeni kayıt düşer, üretici beklemez
+        return;
+    }
+
+    Record& r = ring[h];
+    r.ms = hal::millis();
+    r.fmt = fmt;
+    r.level = level;
+    for (uint8_t i = 0; i < MAX_ARGS; i++) {
+        r.args[i] = i < count ? args[i] : 0;
+    }
+    head.store(next, std::memory_order_release);
+}
+
+size_t drain(size_t maxRecords) {
+    size_t written = 0;
+    char line[160];
+
+    while (written < maxRecords) {
+        uint16_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) break;
+
+        const Record& r = ring[t];
+        int n = snprintf(line, sizeof(line), "[%lu %c] ", (unsigned long)r.ms,
+                         levelChar[r.level < sizeof(levelChar) ? r.level : 0]);
+        if (n < 0) n = 0;
+        int m = snprintf(line + n, sizeof(line) - n, r.fmt,
+                         r.args[0], r.args[1], r.args[2], r.args[3]);
+        if (m > 0) n += m;
+        if (n >= (int)sizeof(line)) n = sizeof(line) - 1;
+
+        // UART FIFO'da yer yoksa sonraki loop() geçişine bırak
+        if ((size_t)n > hal::logWritable()) break;
+
+        hal::logWrite(line, (size_t)n);
+        tail.store((t + 1) & (LOG_RING_SIZE - 1), std::memory_order_release);
+        written++;
+    }
+
+    if (droppedCount && written < maxRecords && hal::logWritable() > 40) {
+        int n = snprintf(line, sizeof(line), "[log] %lu kayıt düştü\n", (unsigned long)droppedCount);
+        if (n > 0) hal::logWrite(line, (size_t)n);
+        droppedCount = 0;
+    }
+    return written;
+}
+
+uint32_t dropped() {
+    return droppedCount;
+}
+
+#else
+
+void pushRecord(uint8_t, const char*, const int32_t*, uint8_t) {}
+
+size_t drain(size_t) {
+    return 0;
+}
+
+uint32_t dropped() {
+    return 0;
+}
+
+#endif
+
+}
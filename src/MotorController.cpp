@@ -1,29 +1,35 @@
 #include "MotorController.h"
+#include <stdio.h>
+#include "Hal.h"
+#include "Log.h"
+#include "DriveRecorder.h"
+#include "BatteryMonitor.h"
 
-MotorController::MotorController(uint8_t pwma, uint8_t ain1, uint8_t ain2,
+static int clampSpeed(int value, int limit) {
+    if (value < -limit) return -limit;
+    if (value > limit) return limit;
+    return value;
+}
+
+MotorController::MotorController(GpioPort& port,
+                               uint8_t pwma, uint8_t ain1, uint8_t ain2,
                                uint8_t pwmb, uint8_t bin1, uint8_t bin2,
-                               uint8_t stby) {
-    PWMA = pwma;
-    AIN1 = ain1;
-    AIN2 = ain2;
-    PWMB = pwmb;
-    BIN1 = bin1;
-    BIN2 = bin2;
-    STBY = stby;
+                               uint8_t stby)
+    : driver(port, pwma, ain1, ain2, pwmb, bin1, bin2, stby) {
     currentSpeed = 150; // Varsayılan hız
+    
+    // Varsayılan rampa: 0 -> tam hız ~0.5 s, tam hız -> 0 ~0.25 s
+    RampConfig ramp;
+    ramp.accelPerSec = 510;
+    ramp.decelPerSec = 1020;
+    ramp.jerkPerSec2 = 4000;
+    setRamp(ramp);
 }
 
 void MotorController::begin() {
-    pinMode(PWMA, OUTPUT);
-    pinMode(AIN1, OUTPUT);
-    pinMode(AIN2, OUTPUT);
-    pinMode(PWMB, OUTPUT);
-    pinMode(BIN1, OUTPUT);
-    pinMode(BIN2, OUTPUT);
-    pinMode(STBY, OUTPUT);
-    
-    digitalWrite(STBY, HIGH); // STBY'yi HIGH yap (aktif)
-    stop(); // Başlangıçta motorlar durdurulur
+    // Pin modları, STBY aktif ve motorlar durdurulmuş olarak başlar
+    driver.begin();
+    stop();
 }
 
 void MotorController::setSpeed(int speed) {
@@ -32,219 +38,318 @@ void MotorController::setSpeed(int speed) {
     currentSpeed = speed;
 }
 
-void MotorController::forward() {
-    digitalWrite(STBY, HIGH);
-    
-    // Sol motor ileri
-    digitalWrite(AIN1, HIGH);
-    digitalWrite(AIN2, LOW);
-    analogWrite(PWMA, currentSpeed);
+void MotorController::setRamp(const RampConfig& config) {
+    // Hız durumu korunur: sürüş sırasında yalnızca adımlar değişir
+    rampConfig = config;
+    leftRamp.configure(config, CONTROL_HZ);
+    rightRamp.configure(config, CONTROL_HZ);
+}
+
+void MotorController::setDeadband(int minimumPwm) {
+    if (minimumPwm < 0) minimumPwm = 0;
+    if (minimumPwm > PWM_MAX) minimumPwm = PWM_MAX;
+    minPwm = minimumPwm;
+}
+
+void MotorController::setParams(const ParamStore* store) {
+    params = store;
+    paramsVersion = 0;
+    if (params && params->take(activeParams, paramsVersion)) {
+        applyParams(activeParams);
+    }
+}
+
+void MotorController::applyParams(const ParamSet& set) {
+    // Varsayılan hız yalnızca değiştiyse uygulanır; kaydırıcıyla seçilen
+    // hız başka bir alanın düzenlenmesiyle ezilmez
+    if (set.speed != defaultSpeed) {
+        defaultSpeed = set.speed;
+        setSpeed(set.speed);
+    }
+    setDeadband(set.minPwm);
+    turnRatio = set.turnRatio;
+    curveRatio = set.curveRatio;
     
-    // Sağ motor ileri
-    digitalWrite(BIN1, HIGH);
-    digitalWrite(BIN2, LOW);
-    analogWrite(PWMB, currentSpeed);
+    RampConfig ramp = rampConfig;
+    ramp.accelPerSec = set.accelPerSec;
+    ramp.decelPerSec = set.decelPerSec;
+    setRamp(ramp);
 }
 
-void MotorController::backward() {
-    digitalWrite(STBY, HIGH);
+void MotorController::setLatencyStats(LatencyStats* stats) {
+    latencyStats = stats;
+}
+
+void MotorController::traceNext(const LatencyTrace& trace) {
+    pendingTrace = trace;
+}
+
+void MotorController::setTarget(int leftSpeed, int rightSpeed, bool deadband) {
+    // PWM aralığı dışındaki hedefler rampayı boşuna uzatmasın
+    Setpoint sp;
+    sp.left = (int16_t)clampSpeed(leftSpeed, PWM_MAX);
+    sp.right = (int16_t)clampSpeed(rightSpeed, PWM_MAX);
+    sp.deadband = deadband;
+    sp.trace = pendingTrace;
+    if (sp.trace.type != CMD_NONE) {
+        sp.trace.dispatchCycles = hal::cycleCount();
+        pendingTrace.type = CMD_NONE;
+    }
+    target.post(sp);
     
-    // Sol motor geri
-    digitalWrite(AIN1, LOW);
-    digitalWrite(AIN2, HIGH);
-    analogWrite(PWMA, currentSpeed);
+    // Telafisiz hedef sabit komuttur; oynatma bunu kaynaktan ayırt eder
+    if (recorder) {
+        recorder->onApplied(sp.left, sp.right, deadband ? sp.trace.type : (uint8_t)CMD_MOVE);
+    }
+}
+
+void MotorController::feedWatchdog() {
+    watchdog.feed(hal::millis());
+}
+
+void MotorController::setGoal(int16_t left, int16_t right) {
+    goal.left = left;
+    goal.right = right;
+    goal.deadband = true;
+    goal.trace.type = CMD_NONE;
     
-    // Sağ motor geri
-    digitalWrite(BIN1, LOW);
-    digitalWrite(BIN2, HIGH);
-    analogWrite(PWMB, currentSpeed);
+    if (recorder) {
+        recorder->onApplied(left, right, CMD_NONE);
+    }
 }
 
-void MotorController::turnLeft() {
-    digitalWrite(STBY, HIGH);
+void MotorController::applySegment(const ManeuverSegment& segment) {
+    int16_t left;
+    int16_t right;
+    if (segment.kind == ManeuverRunner::CURVATURE) {
+        DriveMixer::curvature(q15::fromWire(segment.a), q15::fromWire(segment.b), left, right);
+    } else {
+        left = q15::fromWire(segment.a);
+        right = q15::fromWire(segment.b);
+    }
+    setGoal(q15::scale(left, PWM_MAX), q15::scale(right, PWM_MAX));
+}
+
+void MotorController::tick() {
+    uint32_t now = hal::millis();
+    
+    // Parametreler tick sınırında bütün set olarak değişir (yırtık okuma yok)
+    if (params && params->take(activeParams, paramsVersion)) {
+        applyParams(activeParams);
+    }
+    
+    bool fresh = target.take(goal, targetVersion);
+    
+    // Manevra hedefleri posta kutusundan geçmez; oradan gelen her hedef
+    // (durdurma dahil) elle komuttur ve manevrayı keser
+    if (fresh && maneuver.isRunning()) {
+        maneuver.abort();
+    }
+    switch (maneuver.step(now)) {
+        case ManeuverRunner::EVENT_SEGMENT:
+            applySegment(maneuver.current());
+            break;
+        case ManeuverRunner::EVENT_DONE:
+            setGoal(0, 0);  // Decel rampasıyla durur
+            break;
+        default:
+            break;
+    }
+    if (maneuver.isRunning()) {
+        watchdog.feed(now);
+    }
+    
+    // Bağlantı sessizleşti: ani fren yerine decel rampasıyla sıfıra in
+    if (watchdog.poll(now, goal.left != 0 || goal.right != 0)) {
+        LOG_W("Watchdog: %u ms komut yok, duruluyor\n", watchdog.timeoutMs());
+        goal.left = 0;
+        goal.right = 0;
+        goal.trace.type = CMD_NONE;
+        pendingTrace.type = CMD_NONE;
+        setTarget(0, 0);
+    }
+    
+    int16_t leftCommand = leftRamp.step(goal.left);
+    int16_t rightCommand = rightRamp.step(goal.right);
+    
+    // Kapalı çevrim: rampa çıkışı hedef hızdır, PI düzeltmesi ölü bölge
+    // telafisinden önce eklenir (telafi eşiği yine kalkışı garanti eder)
+    if (leftEncoder && rightEncoder) {
+        if (++speedPhase >= SPEED_DIVIDER) {
+            speedPhase = 0;
+            uint32_t nowUs = hal::micros();
+            leftSpeed.update(leftCommand, leftEncoder->count(), nowUs, PWM_MAX);
+            rightSpeed.update(rightCommand, rightEncoder->count(), nowUs, PWM_MAX);
+        }
+        leftCommand = leftSpeed.apply(leftCommand, PWM_MAX);
+        rightCommand = rightSpeed.apply(rightCommand, PWM_MAX);
+        // Tek kanallı enkoder sayım yönünü sürülen yönden alır
+        if (leftCommand) leftEncoder->setDirection(leftCommand < 0 ? -1 : 1);
+        if (rightCommand) rightEncoder->setDirection(rightCommand < 0 ? -1 : 1);
+    }
+    
+    // Sabit komutların hızı zaten PWM'dir (forward() 150 -> 150); telafi
+    // yalnızca joystick/kablo birimli hedeflere
+    int16_t left = leftCommand;
+    int16_t right = rightCommand;
+    if (goal.deadband) {
+        left = compensateDeadband(leftCommand, minPwm, PWM_MAX);
+        right = compensateDeadband(rightCommand, minPwm, PWM_MAX);
+    }
+    
+    // Boşalan bataryada aynı ortalama motor gerilimi (kalkış eşiği dahil);
+    // çöküş algılandıysa akımı sınırlayan PWM tavanı
+    if (battery) {
+        left = battery->apply(left, PWM_MAX);
+        right = battery->apply(right, PWM_MAX);
+    }
+    appliedLeft = left;
+    appliedRight = right;
     
-    // Sol motor geri
-    digitalWrite(AIN1, LOW);
-    digitalWrite(AIN2, HIGH);
-    analogWrite(PWMA, currentSpeed * 0.7);
+    // Sürücü değişmeyen çıkışları kendisi atlar
+    driver.apply(left, right);
     
-    // Sağ motor ileri
-    digitalWrite(BIN1, HIGH);
-    digitalWrite(BIN2, LOW);
-    analogWrite(PWMB, currentSpeed);
+    if (fresh && goal.trace.type != CMD_NONE && latencyStats) {
+        latencyStats->record(goal.trace, hal::cycleCount());
+    }
 }
 
-void MotorController::turnRight() {
-    digitalWrite(STBY, HIGH);
-    
-    // Sol motor ileri
-    digitalWrite(AIN1, HIGH);
-    digitalWrite(AIN2, LOW);
-    analogWrite(PWMA, currentSpeed);
+void MotorController::setEncoders(hal::Encoder* left, hal::Encoder* right, const SpeedConfig& config) {
+    SpeedConfig speed = config;
+    speed.rateHz = SPEED_HZ;
+    leftSpeed.configure(speed);
+    rightSpeed.configure(speed);
+    leftSpeed.reset();
+    rightSpeed.reset();
+    speedPhase = 0;
+    leftEncoder = left;
+    rightEncoder = right;
     
-    // Sağ motor geri
-    digitalWrite(BIN1, LOW);
-    digitalWrite(BIN2, HIGH);
-    analogWrite(PWMB, currentSpeed * 0.7);
+    if (isClosedLoop()) {
+        LOG_BOOT("Hız kontrolü: kapalı çevrim, %u kenar/tur, %u Hz\n",
+                 (unsigned)speed.countsPerRev, (unsigned)speed.rateHz);
+    } else {
+        LOG_BOOT("Hız kontrolü: açık çevrim (enkoder yok)\n");
+    }
+}
+
+size_t MotorController::writeWheelsJson(char* buf, size_t size) const {
+    if (size == 0) return 0;
+    int n = snprintf(buf, size,
+                     "{\"closed_loop\":%s,\"rpm\":[%d,%d],\"target_rpm\":[%d,%d],"
+                     "\"trim\":[%d,%d],\"pwm\":[%d,%d],\"sat\":%u}",
+                     isClosedLoop() ? "true" : "false",
+                     (int)leftSpeed.rpm(), (int)rightSpeed.rpm(),
+                     (int)leftSpeed.targetRpm(), (int)rightSpeed.targetRpm(),
+                     (int)leftSpeed.getCorrection(), (int)rightSpeed.getCorrection(),
+                     (int)appliedLeft, (int)appliedRight,
+                     (unsigned)(leftSpeed.getSaturations() + rightSpeed.getSaturations()));
+    if (n < 0) return 0;
+    return (size_t)n < size ? (size_t)n : size - 1;
+}
+
+// Sabit komutlar: sol/sağ Q15, dış teker tam ölçek. Dönüş ve kavisli
+// sürüşte iç teker oranı canlı parametredir (turn_ratio, curve_ratio).
+void MotorController::applyMix(int16_t left, int16_t right, int16_t full) {
+    setTarget(q15::scale(left, full), q15::scale(right, full));
+}
+
+void MotorController::preset(int16_t left, int16_t right) {
+    // Eski analogWrite(currentSpeed * 0.7) ile birebir: sıfıra doğru
+    // kırpılır (komut başına tek bölme, tick yolunda değil)
+    setTarget((int32_t)left * currentSpeed / q15::ONE,
+              (int32_t)right * currentSpeed / q15::ONE, false);
+}
+
+void MotorController::forward() {
+    preset(q15::ONE, q15::ONE);
+}
+
+void MotorController::backward() {
+    preset(-q15::ONE, -q15::ONE);
+}
+
+void MotorController::turnLeft() {
+    // Sol motor turn_ratio (0.7) geri, sağ motor tam hız ileri
+    preset(-turnRatio, q15::ONE);
+}
+
+void MotorController::turnRight() {
+    // Sol motor tam hız ileri, sağ motor turn_ratio (0.7) geri
+    preset(q15::ONE, -turnRatio);
 }
 
 void MotorController::forwardLeft() {
-    digitalWrite(STBY, HIGH);
-    
-    // Sol motor yavaş ileri
-    digitalWrite(AIN1, HIGH);
-    digitalWrite(AIN2, LOW);
-    analogWrite(PWMA, currentSpeed * 0.5);
-    
-    // Sağ motor tam hız ileri
-    digitalWrite(BIN1, HIGH);
-    digitalWrite(BIN2, LOW);
-    analogWrite(PWMB, currentSpeed);
+    // Sol motor curve_ratio (yarım) hız ileri, sağ motor tam hız ileri
+    preset(curveRatio, q15::ONE);
 }
 
 void MotorController::forwardRight() {
-    digitalWrite(STBY, HIGH);
-    
-    // Sol motor tam hız ileri
-    digitalWrite(AIN1, HIGH);
-    digitalWrite(AIN2, LOW);
-    analogWrite(PWMA, currentSpeed);
-    
-    // Sağ motor yavaş ileri
-    digitalWrite(BIN1, HIGH);
-    digitalWrite(BIN2, LOW);
-    analogWrite(PWMB, currentSpeed * 0.5);
+    // Sol motor tam hız ileri, sağ motor curve_ratio (yarım) hız ileri
+    preset(q15::ONE, curveRatio);
 }
 
 void MotorController::backwardLeft() {
-    digitalWrite(STBY, HIGH);
-    
-    // Sol motor yavaş geri
-    digitalWrite(AIN1, LOW);
-    digitalWrite(AIN2, HIGH);
-    analogWrite(PWMA, currentSpeed * 0.5);
-    
-    // Sağ motor tam hız geri
-    digitalWrite(BIN1, LOW);
-    digitalWrite(BIN2, HIGH);
-    analogWrite(PWMB, currentSpeed);
+    // Sol motor curve_ratio (yarım) hız geri, sağ motor tam hız geri
+    preset(-curveRatio, -q15::ONE);
 }
 
 void MotorController::backwardRight() {
-    digitalWrite(STBY, HIGH);
-    
-    // Sol motor tam hız geri
-    digitalWrite(AIN1, LOW);
-    digitalWrite(AIN2, HIGH);
-    analogWrite(PWMA, currentSpeed);
-    
-    // Sağ motor yavaş geri
-    digitalWrite(BIN1, LOW);
-    digitalWrite(BIN2, HIGH);
-    analogWrite(PWMB, currentSpeed * 0.5);
+    // Sol motor tam hız geri, sağ motor curve_ratio (yarım) hız geri
+    preset(-q15::ONE, -curveRatio);
 }
 
 void MotorController::stop() {
-    digitalWrite(AIN1, LOW);
-    digitalWrite(AIN2, LOW);
-    digitalWrite(BIN1, LOW);
-    digitalWrite(BIN2, LOW);
-    analogWrite(PWMA, 0);
-    analogWrite(PWMB, 0);
+    // Güvenlik: hedefi ve rampaları sıfırla, tick'i beklemeden pinleri
+    // hemen bırak (OTA gibi loop()'un durduğu durumlarda da motorlar durmalı)
+    LatencyTrace trace = pendingTrace;
+    pendingTrace.type = CMD_NONE;
+    
+    Setpoint sp = {};
+    target.post(sp);
+    leftRamp.reset();
+    rightRamp.reset();
+    driver.release();
+    
+    if (recorder) {
+        recorder->onApplied(0, 0, DriveLog::SOURCE_STOP);
+    }
+    
+    if (trace.type != CMD_NONE && latencyStats) {
+        trace.dispatchCycles = hal::cycleCount();
+        latencyStats->record(trace, trace.dispatchCycles);
+    }
 }
 
 void MotorController::pivotLeft() {
-    digitalWrite(STBY, HIGH);
-    
-    // Sol motor geri
-    digitalWrite(AIN1, LOW);
-    digitalWrite(AIN2, HIGH);
-    analogWrite(PWMA, currentSpeed);
-    
-    // Sağ motor ileri
-    digitalWrite(BIN1, HIGH);
-    digitalWrite(BIN2, LOW);
-    analogWrite(PWMB, currentSpeed);
+    // Sol motor geri, sağ motor ileri
+    preset(-q15::ONE, q15::ONE);
 }
 
 void MotorController::pivotRight() {
-    digitalWrite(STBY, HIGH);
-    
-    // Sol motor ileri
-    digitalWrite(AIN1, HIGH);
-    digitalWrite(AIN2, LOW);
-    analogWrite(PWMA, currentSpeed);
-    
-    // Sağ motor geri
-    digitalWrite(BIN1, LOW);
-    digitalWrite(BIN2, HIGH);
-    analogWrite(PWMB, currentSpeed);
+    // Sol motor ileri, sağ motor geri
+    preset(q15::ONE, -q15::ONE);
 }
 
 void MotorController::smoothTurn(int leftSpeed, int rightSpeed) {
-    Serial.printf("smoothTurn çalıştırılıyor: leftSpeed=%d, rightSpeed=%d\n", leftSpeed, rightSpeed);
-    digitalWrite(STBY, HIGH);
-    
-    // Minimum PWM eşiği (butonlar 150 ile çalışıyor)
-    const int MIN_PWM = 150;
-    
-    // Sol motor
-    if (leftSpeed == 0) {
-        // Tam dur
-        digitalWrite(AIN1, LOW);
-        digitalWrite(AIN2, LOW);
-        analogWrite(PWMA, 0);
-        Serial.println("Sol motor DUR");
-    } else if (leftSpeed > 0) {
-        Serial.println("Sol motor ileri");
-        digitalWrite(AIN1, HIGH);
-        digitalWrite(AIN2, LOW);
-        // Minimum eşiği uygula
-        int pwm = abs(leftSpeed);
-        if (pwm < MIN_PWM) pwm = MIN_PWM;
-        analogWrite(PWMA, pwm);
-        Serial.printf("  PWM: %d\n", pwm);
-    } else {
-        Serial.println("Sol motor geri");
-        digitalWrite(AIN1, LOW);
-        digitalWrite(AIN2, HIGH);
-        // Minimum eşiği uygula
-        int pwm = abs(leftSpeed);
-        if (pwm < MIN_PWM) pwm = MIN_PWM;
-        analogWrite(PWMA, pwm);
-        Serial.printf("  PWM: %d\n", pwm);
-    }
-    
-    // Sağ motor
-    if (rightSpeed == 0) {
-        // Tam dur
-        digitalWrite(BIN1, LOW);
-        digitalWrite(BIN2, LOW);
-        analogWrite(PWMB, 0);
-        Serial.println("Sağ motor DUR");
-    } else if (rightSpeed > 0) {
-        Serial.println("Sağ motor ileri");
-        digitalWrite(BIN1, HIGH);
-        digitalWrite(BIN2, LOW);
-        // Minimum eşiği uygula
-        int pwm = abs(rightSpeed);
-        if (pwm < MIN_PWM) pwm = MIN_PWM;
-        analogWrite(PWMB, pwm);
-        Serial.printf("  PWM: %d\n", pwm);
-    } else {
-        Serial.println("Sağ motor geri");
-        digitalWrite(BIN1, LOW);
-        digitalWrite(BIN2, HIGH);
-        // Minimum eşiği uygula
-        int pwm = abs(rightSpeed);
-        if (pwm < MIN_PWM) pwm = MIN_PWM;
-        analogWrite(PWMB, pwm);
-        Serial.printf("  PWM: %d\n", pwm);
-    }
+    LOG_D("smoothTurn: leftSpeed=%d, rightSpeed=%d\n", leftSpeed, rightSpeed);
     
-    Serial.println("smoothTurn tamamlandı");
+    // Kalkış eşiği (eski MIN_PWM kıstırması) artık tick'teki ölü bölge
+    // telafisiyle uygulanır; hız rampası da tick'te işler
+    int16_t left = DriveMixer::shape(mixer.getCurve(), q15::fromWire(leftSpeed));
+    int16_t right = DriveMixer::shape(mixer.getCurve(), q15::fromWire(rightSpeed));
+    applyMix(left, right, PWM_MAX);
+}
+
+void MotorController::drive(int throttle, int steer) {
+    LOG_D("drive: throttle=%d, steer=%d\n", throttle, steer);
+    
+    int16_t left;
+    int16_t right;
+    mixer.mix(q15::fromWire(throttle), q15::fromWire(steer), left, right);
+    applyMix(left, right, PWM_MAX);
 }
 
 int MotorController::getCurrentSpeed() {
     return currentSpeed;
-}
\ No newline at end of file
+}
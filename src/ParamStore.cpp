@@ -0,0 +1,338 @@
+#include "ParamStore.h"
+#include <stdio.h>
+#include <string.h>
+#include "DriveMixer.h"
+#include "Log.h"
+
+static_assert(sizeof(ParamSet) == 110, "ParamSet düzeni değişti: LAYOUT artırılmalı");
+
+namespace {
+
+// Kayıt başlığı (kayıtta ParamSet'ten önce)
+struct Header {
+    uint32_t magic;
+    uint16_t layout;
+    uint16_t length;
+    uint32_t revision;
+    uint32_t crc;       // Başlığın ilk 12 baytı + ParamSet
+};
+static_assert(sizeof(Header) == ParamStore::HEADER_SIZE, "Başlık 16 bayt olmalı");
+
+enum Kind : uint8_t {
+    U8,
+    U16,
+    RATIO,  // Q15, kabloda 0..1000
+    TEXT
+};
+
+// Düzenlenebilir alanlar (ad sırasıyla; JSON çıktısı da bu sırada)
+struct Field {
+    const char* name;
+    Kind kind;
+    uint8_t offset;
+    uint16_t min;       // TEXT: en kısa
+    uint16_t max;       // TEXT: en uzun
+};
+
+const Field FIELDS[] = {
+    { "accel",       U16,   offsetof(ParamSet, accelPerSec), 50, 5000 },
+    { "curve_ratio", RATIO, offsetof(ParamSet, curveRatio),  0,  1000 },
+    { "decel",       U16,   offsetof(ParamSet, decelPerSec), 50, 5000 },
+    { "min_pwm",     U8,    offsetof(ParamSet, minPwm),      0,  255 },
+    { "password",    TEXT,  offsetof(ParamSet, password),    0,  63 },
+    { "speed",       U8,    offsetof(ParamSet, speed),       0,  255 },
+    { "ssid",        TEXT,  offsetof(ParamSet, ssid),        1,  32 },
+    { "station",     U8,    offsetof(ParamSet, stationMode), 0,  1 },
+    { "turn_ratio",  RATIO, offsetof(ParamSet, turnRatio),   0,  1000 },
+    { "volume",      U8,    offsetof(ParamSet, volume),      0,  30 },
+};
+
+const size_t FIELD_COUNT = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+const Field* findField(const char* name) {
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+        if (strcmp(FIELDS[i].name, name) == 0) return &FIELDS[i];
+    }
+    return nullptr;
+}
+
+int32_t readField(const ParamSet& set, const Field& field) {
+    const uint8_t* p = (const uint8_t*)&set + field.offset;
+    switch (field.kind) {
+        case U8: return *p;
+        case U16: { uint16_t v; memcpy(&v, p, sizeof(v)); return v; }
+        case RATIO: { int16_t v; memcpy(&v, p, sizeof(v)); return q15::scale(v, q15::WIRE_MAX); }
+        default: return (int32_t)strlen((const char*)p);
+    }
+}
+
+// Metin JSON'a kaçışsız yazılabilmeli: kontrol karakteri, '"' ve '\' yok
+// (UTF-8 baytları serbest); WPA2 şifresi boş ya da en az 8 karakter
+bool textValid(const Field& field, const char* text) {
+    size_t length = strlen(text);
+    if (length < field.min || length > field.max) return false;
+    if (field.offset == offsetof(ParamSet, password) && length > 0 && length < 8) return false;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t c = (uint8_t)text[i];
+        if (c < 0x20 || c == '"' || c == '\\') return false;
+    }
+    return true;
+}
+
+uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0) {
+    crc = ~crc;
+    while (length--) {
+        crc ^= *data++;
+        for (uint8_t k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+uint32_t wifiCrc(const ParamSet& set) {
+    uint32_t crc = crc32(&set.stationMode, 1);
+    crc = crc32((const uint8_t*)set.ssid, sizeof(set.ssid), crc);
+    return crc32((const uint8_t*)set.password, sizeof(set.password), crc);
+}
+
+}
+
+ParamStore::ParamStore() : version(0) {
+    defaults(shadow);
+    published = shadow;
+}
+
+void ParamStore::defaults(ParamSet& out) {
+    // Dizgelerin kullanılmayan baytları da sıfır: kayıt ve karşılaştırma bayt bayt
+    memset(&out, 0, sizeof(out));
+    out.speed = 150;
+    out.minPwm = 150;
+    out.accelPerSec = 510;      // 0 -> tam hız ~0.5 s
+    out.decelPerSec = 1020;     // tam hız -> 0 ~0.25 s
+    out.turnRatio = q15::Q(0.7);
+    out.curveRatio = q15::Q(0.5);
+    out.volume = 20;
+    out.stationMode = 0;
+    strcpy(out.ssid, "RC_Araba_AP");
+    strcpy(out.password, "12345678");
+}
+
+bool ParamStore::isValid(const ParamSet& set) {
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+        const Field& field = FIELDS[i];
+        if (field.kind == TEXT) {
+            const char* text = (const char*)&set + field.offset;
+            if (memchr(text, 0, field.max + 1) == nullptr || !textValid(field, text)) return false;
+        } else {
+            int32_t v = readField(set, field);
+            if (v < field.min || v > field.max) return false;
+        }
+    }
+    return true;
+}
+
+void ParamStore::begin(hal::BlockFile* file) {
+    storage = file;
+    uint32_t start = hal::micros();
+
+    uint8_t record[RECORD_SIZE];
+    Header header;
+    ParamSet loaded;
+    source = SOURCE_DEFAULTS;
+    if (storage && storage->read(0, record, sizeof(record))) {
+        memcpy(&header, record, sizeof(header));
+        memcpy(&loaded, record + HEADER_SIZE, sizeof(loaded));
+        if (header.magic == MAGIC) {
+            uint32_t crc = crc32(record, HEADER_SIZE - sizeof(header.crc));
+            crc = crc32(record + HEADER_SIZE, sizeof(loaded), crc);
+            bool ok = header.layout == LAYOUT && header.length == sizeof(ParamSet) &&
+                      header.crc == crc && isValid(loaded);
+            source = ok ? SOURCE_STORED : SOURCE_INVALID;
+        } else if (header.magic != 0xFFFFFFFF) {
+            source = SOURCE_INVALID;
+        }
+    }
+
+    if (source == SOURCE_STORED) {
+        shadow = loaded;
+        revision = header.revision;
+    } else {
+        defaults(shadow);
+        // Bozuk kaydın sayacı korunmaz; sonraki kayıt 1'den başlar
+        revision = 0;
+    }
+    publish();
+    bootWifiCrc = wifiCrc(shadow);
+    loadUs = hal::micros() - start;
+
+    if (source == SOURCE_INVALID) {
+        LOG_W("Parametre kaydı geçersiz, varsayılanlar yüklendi\n");
+    }
+    LOG_BOOT("Parametreler: %s, kayıt %u (%u µs)\n", sourceName(source),
+             (unsigned)revision, (unsigned)loadUs);
+}
+
+void ParamStore::publish() {
+    uint32_t v = version.load(std::memory_order_relaxed);
+    version.store(v + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    published = shadow;
+    std::atomic_thread_fence(std::memory_order_release);
+    version.store(v + 2, std::memory_order_relaxed);
+}
+
+bool ParamStore::set(const char* name, int32_t value, const char* text) {
+    const Field* field = name ? findField(name) : nullptr;
+    bool ok = field != nullptr;
+    if (ok && field->kind == TEXT) {
+        ok = text && textValid(*field, text);
+    } else if (ok) {
+        ok = !text && value >= field->min && value <= field->max;
+    }
+
+    changes++;
+    if (!ok) {
+        rejected = field ? field->name : "unknown";
+        return false;
+    }
+    rejected = nullptr;
+
+    uint8_t* p = (uint8_t*)&shadow + field->offset;
+    switch (field->kind) {
+        case U8:
+            *p = (uint8_t)value;
+            break;
+        case U16: {
+            uint16_t v = (uint16_t)value;
+            memcpy(p, &v, sizeof(v));
+            break;
+        }
+        case RATIO: {
+            int16_t v = q15::fromWire(value);
+            memcpy(p, &v, sizeof(v));
+            break;
+        }
+        case TEXT:
+            // Kalan baytlar sıfır (strncpy doldurur)
+            strncpy((char*)p, text, field->max + 1);
+            break;
+    }
+    return true;
+}
+
+void ParamStore::apply() {
+    publish();
+    rejected = nullptr;
+    changes++;
+}
+
+void ParamStore::save() {
+    apply();
+    if (storage) saveRequested = true;
+}
+
+void ParamStore::revert() {
+    shadow = published;
+    rejected = nullptr;
+    changes++;
+}
+
+void ParamStore::reset() {
+    defaults(shadow);
+    rejected = nullptr;
+    changes++;
+}
+
+void ParamStore::poll(bool idle) {
+    if (!saveRequested || !idle) return;
+    saveRequested = false;
+
+    ParamSet set;
+    uint32_t seen = 0;
+    take(set, seen);
+
+    uint8_t record[RECORD_SIZE];
+    Header header;
+    header.magic = MAGIC;
+    header.layout = LAYOUT;
+    header.length = sizeof(ParamSet);
+    header.revision = revision + 1;
+    memcpy(record, &header, sizeof(header));
+    memcpy(record + HEADER_SIZE, &set, sizeof(set));
+    header.crc = crc32(record, HEADER_SIZE - sizeof(header.crc));
+    header.crc = crc32(record + HEADER_SIZE, sizeof(set), header.crc);
+    memcpy(record, &header, sizeof(header));
+
+    if (storage->write(0, record, sizeof(record))) {
+        revision = header.revision;
+        source = SOURCE_STORED;
+        saves++;
+        LOG_I("Parametreler kaydedildi (kayıt %u)\n", (unsigned)revision);
+    } else {
+        saveErrors++;
+        LOG_W("Parametre kaydı yazılamadı\n");
+    }
+    changes++;
+}
+
+const char* ParamStore::sourceName(Source value) {
+    switch (value) {
+        case SOURCE_STORED: return "stored";
+        case SOURCE_INVALID: return "invalid";
+        default: return "defaults";
+    }
+}
+
+size_t ParamStore::writeEvent(char* buf, size_t size) const {
+    if (size == 0) return 0;
+    ParamSet active;
+    uint32_t seen = 0;
+    take(active, seen);
+
+    int n = snprintf(buf, size,
+                     "{\"type\":\"params\",\"rev\":%u,\"source\":\"%s\",\"dirty\":%s,"
+                     "\"save_pending\":%s,\"restart\":%s,\"rejected\":",
+                     (unsigned)revision, sourceName(source),
+                     memcmp(&shadow, &active, sizeof(active)) != 0 ? "true" : "false",
+                     saveRequested ? "true" : "false",
+                     wifiCrc(active) != bootWifiCrc ? "true" : "false");
+    if (n < 0) return 0;
+    size_t len = (size_t)n < size ? (size_t)n : size - 1;
+
+    n = rejected ? snprintf(buf + len, size - len, "\"%s\",\"set\":{", rejected)
+                 : snprintf(buf + len, size - len, "null,\"set\":{");
+    if (n < 0) return len;
+    len += (size_t)n < size - len ? (size_t)n : size - len - 1;
+
+    for (size_t i = 0; i < FIELD_COUNT && len < size - 1; i++) {
+        const Field& field = FIELDS[i];
+        const char* separator = i ? "," : "";
+        if (field.offset == offsetof(ParamSet, password)) {
+            n = snprintf(buf + len, size - len, "%s\"password_len\":%d", separator,
+                         (int)readField(shadow, field));
+        } else if (field.kind == TEXT) {
+            n = snprintf(buf + len, size - len, "%s\"%s\":\"%s\"", separator, field.name,
+                         (const char*)&shadow + field.offset);
+        } else {
+            n = snprintf(buf + len, size - len, "%s\"%s\":%d", separator, field.name,
+                         (int)readField(shadow, field));
+        }
+        if (n < 0) return len;
+        len += (size_t)n < size - len ? (size_t)n : size - len - 1;
+    }
+
+    n = snprintf(buf + len, size - len, "}}");
+    if (n < 0) return len;
+    return len + ((size_t)n < size - len ? (size_t)n : size - len - 1);
+}
+
+size_t ParamStore::writeJson(char* buf, size_t size) const {
+    if (size == 0) return 0;
+    int n = snprintf(buf, size,
+                     "{\"rev\":%u,\"source\":\"%s\",\"load_us\":%u,\"saves\":%u,\"save_errors\":%u}",
+                     (unsigned)revision, sourceName(source), (unsigned)loadUs,
+                     (unsigned)saves, (unsigned)saveErrors);
+    if (n < 0) return 0;
+    return (size_t)n < size ? (size_t)n : size - 1;
+}
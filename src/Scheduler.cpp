@@ -0,0 +1,117 @@
+#include "Scheduler.h"
+#include <stdio.h>
+#include "Hal.h"
+
+bool Scheduler::add(const char* name, TaskFn run, uint32_t periodUs, uint8_t priority,
+                    uint32_t budgetUs) {
+    if (count >= MAX_TASKS || run == nullptr) return false;
+
+    // Öncelik sırasını koru (büyük önce, eşitse ekleme sırası)
+    uint8_t index = count;
+    while (index > 0 && tasks[index - 1].priority < priority) {
+        tasks[index] = tasks[index - 1];
+        index--;
+    }
+
+    Task task;
+    task.name = name;
+    task.run = run;
+    task.priority = priority;
+    task.budgetUs = budgetUs;
+    task.timer = ControlTimer(periodUs);
+    tasks[index] = task;
+    count++;
+    return true;
+}
+
+void Scheduler::rollWindow(uint32_t nowUs) {
+    if (!windowStarted) {
+        windowStarted = true;
+        windowStart = nowUs;
+        return;
+    }
+
+    uint32_t elapsed = nowUs - windowStart;
+    if (elapsed < WINDOW_US) return;
+
+    loopHz = (uint32_t)((uint64_t)windowPasses * 1000000UL / elapsed);
+    loadPermille = (uint32_t)((uint64_t)windowBusyUs * 1000 / elapsed);
+    for (uint8_t i = 0; i < count; i++) {
+        tasks[i].lastWindowBusyUs = tasks[i].windowBusyUs;
+        tasks[i].windowBusyUs = 0;
+    }
+    windowStart = nowUs;
+    windowPasses = 0;
+    windowBusyUs = 0;
+}
+
+void Scheduler::runPass(uint32_t nowUs) {
+    rollWindow(nowUs);
+    passes++;
+    windowPasses++;
+
+    uint32_t passStart = hal::micros();
+    for (uint8_t i = 0; i < count; i++) {
+        Task& task = tasks[i];
+        if (task.timer.getPeriodUs() != 0 && !task.timer.poll(nowUs)) continue;
+
+        uint32_t start = hal::micros();
+        task.run(start);
+        uint32_t spent = hal::micros() - start;
+
+        task.runs++;
+        task.busyUs += spent;
+        task.windowBusyUs += spent;
+        windowBusyUs += spent;
+        if (spent > task.maxUs) task.maxUs = spent;
+        if (task.budgetUs && spent > task.budgetUs) task.overruns++;
+    }
+
+    uint32_t passUs = hal::micros() - passStart;
+    if (passUs > maxPassUs) maxPassUs = passUs;
+}
+
+size_t Scheduler::writeSummary(char* buf, size_t size) const {
+    if (size == 0) return 0;
+    int n = snprintf(buf, size, "{\"loop_hz\":%u,\"load_pm\":%u,\"pass_max_us\":%u}",
+                     (unsigned)loopHz, (unsigned)loadPermille, (unsigned)maxPassUs);
+    if (n < 0) return 0;
+    return (size_t)n < size ? (size_t)n : size - 1;
+}
+
+size_t Scheduler::writeJson(char* buf, size_t size) const {
+    if (size < 2) return 0;
+
+    // Özetin kapanış parantezi yerine görev dizisi eklenir
+    size_t n = writeSummary(buf, size);
+    if (n == 0 || n + 12 >= size) return n;
+    n--;
+    n += snprintf(buf + n, size - n, ",\"tasks\":[");
+
+    for (uint8_t i = 0; i < count && n + 2 < size; i++) {
+        const Task& task = tasks[i];
+        int written = snprintf(buf + n, size - n,
+                               "%s{\"name\":\"%s\",\"prio\":%u,\"period_us\":%u,\"runs\":%u,"
+                               "\"avg_us\":%u,\"max_us\":%u,\"cpu_pm\":%u,\"late\":%u,"
+                               "\"overruns\":%u,\"jitter_max_us\":%u}",
+                               i ? "," : "", task.name, (unsigned)task.priority,
+                               (unsigned)task.timer.getPeriodUs(), (unsigned)task.runs,
+                               (unsigned)(task.runs ? task.busyUs / task.runs : 0),
+                               (unsigned)task.maxUs,
+                               (unsigned)((uint64_t)task.lastWindowBusyUs * 1000 / WINDOW_US),
+                               (unsigned)task.timer.getMissedTicks(), (unsigned)task.overruns,
+                               (unsigned)task.timer.getMaxJitterUs());
+        if (written < 0 || (size_t)written >= size - n) {
+            n = size - 1;
+            break;
+        }
+        n += (size_t)written;
+    }
+
+    if (n + 2 < size) {
+        buf[n++] = ']';
+        buf[n++] = '}';
+        buf[n] = '\0';
+    }
+    return n;
+}
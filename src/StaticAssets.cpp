@@ -0,0 +1,156 @@
+#include "StaticAssets.h"
+#include <LittleFS.h>
+#include <string.h>
+#include "Log.h"
+
+#ifdef EMBED_WEB_UI
+#include "WebAssetsEmbedded.h"
+#endif
+
+// HTML'den sürümlü (?v=) yüklenenler: içerik değişince URL de değişir
+static const char CACHE_IMMUTABLE[] = "public, max-age=31536000, immutable";
+// HTML: her açılışta doğrula, değişmediyse 304
+static const char CACHE_REVALIDATE[] = "no-cache";
+
+#ifdef EMBED_WEB_UI
+
+static const EmbeddedAsset* findEmbedded(const char* path) {
+    for (uint8_t i = 0; i < EMBEDDED_ASSET_COUNT; i++) {
+        if (strcmp(EMBEDDED_ASSETS[i].path, path) == 0) return &EMBEDDED_ASSETS[i];
+    }
+    return nullptr;
+}
+
+uint8_t StaticAssetHandler::begin(const char* manifestPath) {
+    (void)manifestPath;
+    LOG_BOOT("%u gömülü varlık (PROGMEM)\n", EMBEDDED_ASSET_COUNT);
+    return EMBEDDED_ASSET_COUNT;
+}
+
+bool StaticAssetHandler::canHandle(AsyncWebServerRequest* request) {
+    if (request->method() != HTTP_GET && request->method() != HTTP_HEAD) return false;
+    if (!findEmbedded(request->url().c_str())) return false;
+
+    request->addInterestingHeader("If-None-Match");
+    return true;
+}
+
+void StaticAssetHandler::handleRequest(AsyncWebServerRequest* request) {
+    const EmbeddedAsset* asset = findEmbedded(request->url().c_str());
+    if (!asset) {
+        request->send(404);
+        return;
+    }
+
+    const char* cacheControl = isDocument(asset->path) ? CACHE_REVALIDATE : CACHE_IMMUTABLE;
+
+    AsyncWebServerResponse* response;
+    AsyncWebHeader* match = request->getHeader("If-None-Match");
+    if (match && strcmp(match->value().c_str(), asset->etag) == 0) {
+        response = request->beginResponse(304);
+    } else {
+        // Flash'tan parça parça okunur; RAM'e kopya alınmaz
+        response = request->beginResponse_P(200, asset->contentType, asset->data, asset->length);
+        response->addHeader("Content-Encoding", "gzip");
+    }
+    response->addHeader("ETag", asset->etag);
+    response->addHeader("Cache-Control", cacheControl);
+    request->send(response);
+}
+
+#else
+
+uint8_t StaticAssetHandler::begin(const char* manifestPath) {
+    count = 0;
+
+    File manifest = LittleFS.open(manifestPath, "r");
+    if (!manifest) {
+        LOG_BOOT("Varlık manifesti bulunamadı: %s\n", manifestPath);
+        return 0;
+    }
+
+    // Satır biçimi: "/script.js 1a2b3c4d"
+    char line[MAX_PATH + 12];
+    while (manifest.available() && count < MAX_ASSETS) {
+        size_t n = manifest.readBytesUntil('\n', line, sizeof(line) - 1);
+        line[n] = '\0';
+
+        char* space = strchr(line, ' ');
+        if (!space || space - line >= MAX_PATH || strlen(space + 1) != 8) continue;
+        *space = '\0';
+
+        Asset& a = assets[count++];
+        strcpy(a.path, line);
+        a.etag[0] = '"';
+        memcpy(a.etag + 1, space + 1, 8);
+        a.etag[9] = '"';
+        a.etag[10] = '\0';
+    }
+    manifest.close();
+
+    LOG_BOOT("%u sıkıştırılmış varlık yüklendi\n", count);
+    return count;
+}
+
+const StaticAssetHandler::Asset* StaticAssetHandler::find(const char* path) const {
+    for (uint8_t i = 0; i < count; i++) {
+        if (strcmp(assets[i].path, path) == 0) return &assets[i];
+    }
+    return nullptr;
+}
+
+bool StaticAssetHandler::canHandle(AsyncWebServerRequest* request) {
+    if (request->method() != HTTP_GET && request->method() != HTTP_HEAD) return false;
+    if (!find(request->url().c_str())) return false;
+
+    // ESPAsyncWebServer yalnızca istenen başlıkları saklar
+    request->addInterestingHeader("If-None-Match");
+    return true;
+}
+
+void StaticAssetHandler::handleRequest(AsyncWebServerRequest* request) {
+    const Asset* asset = find(request->url().c_str());
+    if (!asset) {
+        request->send(404);
+        return;
+    }
+
+    const char* cacheControl = isDocument(asset->path) ? CACHE_REVALIDATE : CACHE_IMMUTABLE;
+
+    AsyncWebHeader* match = request->getHeader("If-None-Match");
+    if (match && strcmp(match->value().c_str(), asset->etag) == 0) {
+        AsyncWebServerResponse* response = request->beginResponse(304);
+        response->addHeader("ETag", asset->etag);
+        response->addHeader("Cache-Control", cacheControl);
+        request->send(response);
+        return;
+    }
+
+    // Düz dosya yoksa AsyncFileResponse <yol>.gz'yi açar ve
+    // Content-Encoding: gzip başlığını kendisi ekler
+    AsyncWebServerResponse* response =
+        request->beginResponse(LittleFS, asset->path, contentType(asset->path));
+    response->addHeader("ETag", asset->etag);
+    response->addHeader("Cache-Control", cacheControl);
+    request->send(response);
+}
+
+#endif
+
+const char* StaticAssetHandler::contentType(const char* path) {
+    const char* ext = strrchr(path, '.');
+    if (!ext) return "application/octet-stream";
+    if (strcmp(ext, ".html") == 0) return "text/html";
+    if (strcmp(ext, ".js") == 0) return "application/javascript";
+    if (strcmp(ext, ".css") == 0) return "text/css";
+    if (strcmp(ext, ".ico") == 0) return "image/x-icon";
+    if (strcmp(ext, ".png") == 0) return "image/png";
+    if (strcmp(ext, ".svg") == 0) return "image/svg+xml";
+    if (strcmp(ext, ".json") == 0) return "application/json";
+    return "application/octet-stream";
+}
+
+bool StaticAssetHandler::isDocument(const char* path) {
+    const char* ext = strrchr(path, '.');
+    return ext && strcmp(ext, ".html") == 0;
+}
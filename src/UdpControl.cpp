@@ -0,0 +1,98 @@
+#include "UdpControl.h"
+#include <stdio.h>
+#include <string.h>
+#include "CommandProcessor.h"
+#include "Log.h"
+
+using namespace DriveProtocol;
+
+UdpControl::UdpControl(CommandProcessor* commandProcessor, uint16_t udpPort)
+    : processor(commandProcessor), port(udpPort) {}
+
+bool UdpControl::begin() {
+    socket = hal::udpSocket(port);
+    if (!socket) {
+        LOG_BOOT("UDP kontrol portu %u açılamadı\n", (unsigned)port);
+        return false;
+    }
+    LOG_BOOT("UDP kontrol: port %u (oturum: GET /api/udp)\n", (unsigned)port);
+    return true;
+}
+
+uint32_t UdpControl::openSession() {
+    uint32_t value;
+    do {
+        value = hal::random32();
+    } while (value == 0 || value == token);
+    token = value;
+    hasPeer = false;
+    tracking = false;
+    processor->onSession(CLIENT_ID);
+    return value;
+}
+
+void UdpControl::poll() {
+    if (!socket) return;
+
+    for (uint8_t i = 0; i < MAX_PER_POLL; i++) {
+        uint8_t buf[UDP_PACKET_SIZE];
+        hal::Endpoint from;
+        int length = socket->receive(buf, sizeof(buf), from);
+        if (length == 0) break;
+        uint32_t rx = hal::cycleCount();
+        received++;
+
+        // Manevra yüklemesi (değişken boyut) yalnızca WebSocket'ten
+        if (length != (int)UDP_PACKET_SIZE || buf[UDP_TOKEN_SIZE] == OP_MANEUVER) {
+            malformed++;
+            continue;
+        }
+        uint32_t current = token;
+        if (current == 0 || readU32(buf) != current) {
+            rejected++;
+            continue;
+        }
+
+        // Kayıp tahmini: ileri seq boşlukları (sırasız/tekrarı DriveInbox sayar)
+        uint16_t seq = readU16(buf + UDP_TOKEN_SIZE + 2);
+        if (tracking) {
+            uint16_t gap = (uint16_t)(seq - lastSeq);
+            if (gap > 1 && gap < 0x8000) lost += gap - 1u;
+            if (gap != 0 && gap < 0x8000) lastSeq = seq;
+        } else {
+            tracking = true;
+            lastSeq = seq;
+        }
+
+        // İstemci adres/port değiştirebilir (NAT, yeniden başlatma)
+        peer = from;
+        hasPeer = true;
+        processor->handleBinary(CLIENT_ID, buf + UDP_TOKEN_SIZE, FRAME_SIZE, rx);
+    }
+}
+
+bool UdpControl::sendBinary(const uint8_t* data, size_t length) {
+    if (!socket || !hasPeer || length != FRAME_SIZE) return false;
+
+    uint8_t buf[UDP_PACKET_SIZE];
+    writeU32(buf, token);
+    memcpy(buf + UDP_TOKEN_SIZE, data, FRAME_SIZE);
+    if (!socket->send(peer, buf, sizeof(buf))) {
+        sendErrors++;
+        return false;
+    }
+    acks++;
+    return true;
+}
+
+size_t UdpControl::writeJson(char* buf, size_t size) const {
+    if (size == 0) return 0;
+    int n = snprintf(buf, size,
+                     "{\"port\":%u,\"session\":%s,\"rx\":%u,\"malformed\":%u,\"rejected\":%u,"
+                     "\"lost\":%u,\"acks\":%u,\"send_errors\":%u}",
+                     (unsigned)port, token ? "true" : "false", (unsigned)received,
+                     (unsigned)malformed, (unsigned)rejected, (unsigned)lost,
+                     (unsigned)acks, (unsigned)sendErrors);
+    if (n < 0) return 0;
+    return (size_t)n < size ? (size_t)n : size - 1;
+}
@@ -1,35 +1,96 @@
 #include "WebServerManager.h"
 #include <LittleFS.h>
+#include "Log.h"
 
-// Static pointer for WebSocket callback
-static WebServerManager* instance = nullptr;
+// Telemetri, /api/stats (~1,7 KB), /api/heap (~1,4 KB) ve /api/tasks
+// (görev başına ~190 bayt) gövdeleri için ortak tampon: loop yığını 4 KB,
+// async TCP bağlamınınki daha da küçük. İkisi de loop() ile sırayla
+// (eşzamanlı değil) çalıştığından paylaşılabilir. Dolu görev tablosu da
+// kesilmeden sığar.
+static char statsBuffer[128 + Scheduler::MAX_TASKS * 190];
 
-WebServerManager::WebServerManager(MotorController* motorController, AudioManager* audioManager) {
+WebServerManager::WebServerManager(MotorController* motorController, AudioManager* audioManager, WiFiManager* wifiManager,
+                                   Scheduler* taskScheduler, HeapMonitor* heapMonitor,
+                                   DriveRecorder* driveRecorder, BatteryMonitor* batteryMonitor,
+                                   ParamStore* paramStore) {
     motor = motorController;
     audio = audioManager;
+    wifi = wifiManager;
+    scheduler = taskScheduler;
+    heap = heapMonitor;
+    recorder = driveRecorder;
+    battery = batteryMonitor;
+    params = paramStore;
     server = new AsyncWebServer(80);
-    webSocket = new WebSocketsServer(webSocketPort);
-    
-    instance = this; // Set static instance
+    webSocket = new AsyncWebSocket("/ws");
+    processor = new CommandProcessor(motor, audio, this);
+    processor->setParams(params);
 }
 
 void WebServerManager::begin() {
-    // WebSocket başlat
-    webSocket->begin();
-    webSocket->onEvent(onWebSocketEvent);
+    // WebSocket: catch-all statik işleyicilerden önce eklenmeli
+    webSocket->onEvent([this](AsyncWebSocket* ws, AsyncWebSocketClient* client, AwsEventType type,
+                              void* arg, uint8_t* data, size_t length) {
+        (void)ws;
+        onWebSocketEvent(client, type, arg, data, length);
+    });
+    server->addHandler(webSocket);
     
     // Root sayfası
     server->on("/", HTTP_GET, [this](AsyncWebServerRequest* request) {
         handleRoot(request);
     });
     
-    // Komut endpoint'i
+    // Komut endpoint'i. Her sürüş komutu bekçiyi besler: araç hareket
+    // hâlindeyken istemci komutu (ya da cmd=ka) 250 ms'de bir tekrarlamalı
     server->on("/control", HTTP_GET, [this](AsyncWebServerRequest* request) {
         handleCommand(request);
     });
     
-    // Statik dosyalar (SPIFFS'den)
+    // Gecikme istatistikleri (komut tipi başına p50/p99/max, µs)
+    server->on("/api/stats", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleStats(request);
+    });
+    
+    // loop() görevleri: görev başına çalışma süresi, CPU payı, gecikme/aşım
+    server->on("/api/tasks", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleTasks(request);
+    });
+    
+    // Boş heap, en büyük blok, parçalanma ve 5 dk'lık aralıklarla geçmişi
+    server->on("/api/heap", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleHeap(request);
+    });
+    
+    // Sürüş kaydı: durum; ?action=start|stop|replay[&speed=1..16]
+    server->on("/api/record", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleRecord(request);
+    });
+    
+    // Kayıt dosyasının kendisi (tools/drive_replay.cpp ile çözülür). Kayıt
+    // sürerken son FLUSH_INTERVAL_MS eksik olabilir; önce action=stop
+    server->on(DriveRecorder::PATH, HTTP_GET, [](AsyncWebServerRequest* request) {
+        request->send(LittleFS, DriveRecorder::PATH, "application/octet-stream", true);
+    });
+    
+    // UDP sürüş kanalı: port + oturum belirteci; ?new=1 yenisini verir
+    server->on("/api/udp", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleUdp(request);
+    });
+    
+    // Sıkıştırılmış, önbelleklenebilir varlıklar (tools/build_assets.py)
+    assets.begin();
+    server->addHandler(&assets);
+    
+    // Sayfalar favicon istemeden duramıyor; 404 yolu yerine boş yanıt
+    server->on("/favicon.ico", HTTP_GET, [](AsyncWebServerRequest* request) {
+        request->send(204);
+    });
+    
+#ifndef EMBED_WEB_UI
+    // Manifestte olmayan dosyalar (SPIFFS'den)
     server->serveStatic("/", LittleFS, "/").setDefaultFile("index.html");
+#endif
     
     // 404 handler
     server->onNotFound([this](AsyncWebServerRequest* request) {
@@ -39,12 +100,263 @@ void WebServerManager::begin() {
     // Server'ı başlat
     server->begin();
     
-    Serial.println("HTTP server başlatıldı");
-    Serial.println("WebSocket server başlatıldı (port: " + String(webSocketPort) + ")");
+#if UDP_CONTROL_PORT
+    udp = new UdpControl(processor, UDP_CONTROL_PORT);
+    if (!udp->begin()) {
+        delete udp;
+        udp = nullptr;
+    }
+#endif
+    
+    LOG_BOOT("HTTP server başlatıldı (port 80, WebSocket: /ws)\n");
 }
 
 void WebServerManager::loop() {
-    webSocket->loop();
+    // WebSocket çerçeveleri LwIP geri çağrısında gelen kutusuna düştü,
+    // UDP datagramları burada alınır; bu geçişte biriken sürüş
+    // çerçevelerinden yalnızca en yenisi motora gider
+    if (udp) {
+        udp->poll();
+    }
+    processor->flush();
+    
+    uint32_t now = millis();
+    if (now - lastPing >= PING_INTERVAL_MS) {
+        lastPing = now;
+        pingClients(now);
+    }
+    
+    // Düşük gerilim / çöküş koruması değişti: tüm istemcilere olay
+    if (battery && battery->getVersion() != batteryVersion) {
+        batteryVersion = battery->getVersion();
+        broadcastBattery();
+    }
+    
+    // Parametre düzenlemesi/yayını/kaydı: tüm istemciler güncel gölgeyi görür
+    if (params && params->getChanges() != paramsChanges) {
+        paramsChanges = params->getChanges();
+        for (uint8_t i = 0; i < MAX_WS_CLIENTS; i++) {
+            if (links[i].id != 0) links[i].paramsPending = true;
+        }
+    }
+    flushParams();
+    
+    // Periyodik telemetri: istemci başına bekleyen işaret, kuyruğu
+    // uygun olan istemciye en güncel durum yazılır
+    if (now - lastTelemetry >= TELEMETRY_INTERVAL_MS) {
+        lastTelemetry = now;
+        queueTelemetry();
+    }
+    flushTelemetry();
+}
+
+// "latency":{...},"drive":{...},"watchdog":{...},"wifi":{...},"audio":{...},"ws":{...},"sched":{...},"heap":{...},"maneuver":{...},"wheels":{...},"battery":{...},"params":{...},"udp":{...} gövdesini yazar (süslü parantezler çağıranda)
+size_t WebServerManager::writeStats(char* buf, size_t size) {
+    size_t n = snprintf(buf, size, "\"latency\":");
+    n += processor->getLatencyStats().writeJson(buf + n, size - n);
+    if (n + 10 < size) {
+        n += snprintf(buf + n, size - n, ",\"drive\":");
+        n += processor->getDriveInbox().writeJson(buf + n, size - n);
+    }
+    if (n + 13 < size) {
+        n += snprintf(buf + n, size - n, ",\"watchdog\":");
+        n += motor->getWatchdog().writeJson(buf + n, size - n);
+    }
+    if (n + 9 < size) {
+        n += snprintf(buf + n, size - n, ",\"wifi\":");
+        n += wifi->writeJson(buf + n, size - n);
+    }
+    if (n + 10 < size) {
+        n += snprintf(buf + n, size - n, ",\"audio\":");
+        n += audio->writeJson(buf + n, size - n);
+    }
+    if (n + 108 < size) {
+        // En fazla 107 bayt (4 x 10 haneli sayı); yine de diğer writeJson'lar
+        // gibi kesilmiş uzunlukla ilerler, n tamponu aşmaz
+        int ws = snprintf(buf + n, size - n,
+                          ",\"ws\":{\"clients\":%u,\"tx_dropped\":%u,\"telemetry_dropped\":%u,\"fragmented\":%u}",
+                          (unsigned)webSocket->count(), (unsigned)sendDropped,
+                          (unsigned)telemetryDropped, (unsigned)fragmented);
+        if (ws > 0) n += (size_t)ws < size - n ? (size_t)ws : size - n - 1;
+    }
+    if (n + 10 < size) {
+        n += snprintf(buf + n, size - n, ",\"sched\":");
+        n += scheduler->writeSummary(buf + n, size - n);
+    }
+    if (n + 9 < size) {
+        n += snprintf(buf + n, size - n, ",\"heap\":");
+        n += heap->writeSummary(buf + n, size - n);
+    }
+    if (n + 13 < size) {
+        n += snprintf(buf + n, size - n, ",\"maneuver\":");
+        n += motor->getManeuver().writeSummary(buf + n, size - n);
+    }
+    if (n + 11 < size) {
+        n += snprintf(buf + n, size - n, ",\"wheels\":");
+        n += motor->writeWheelsJson(buf + n, size - n);
+    }
+    if (battery && n + 12 < size) {
+        n += snprintf(buf + n, size - n, ",\"battery\":");
+        n += battery->writeJson(buf + n, size - n);
+    }
+    if (params && n + 11 < size) {
+        n += snprintf(buf + n, size - n, ",\"params\":");
+        n += params->writeJson(buf + n, size - n);
+    }
+    if (udp && n + 8 < size) {
+        n += snprintf(buf + n, size - n, ",\"udp\":");
+        n += udp->writeJson(buf + n, size - n);
+    }
+    return n;
+}
+
+int8_t WebServerManager::slotOf(uint32_t id) const {
+    for (uint8_t i = 0; i < MAX_WS_CLIENTS; i++) {
+        if (links[i].id == id) return (int8_t)i;
+    }
+    return -1;
+}
+
+AsyncWebSocketClient* WebServerManager::clientAt(uint8_t slot) {
+    if (slot >= MAX_WS_CLIENTS || links[slot].id == 0) return nullptr;
+    AsyncWebSocketClient* client = webSocket->client(links[slot].id);
+    return client && client->status() == WS_CONNECTED ? client : nullptr;
+}
+
+void WebServerManager::pingClients(uint32_t now) {
+    for (uint8_t i = 0; i < MAX_WS_CLIENTS; i++) {
+        AsyncWebSocketClient* client = clientAt(i);
+        if (!client) continue;
+        
+        if (now - links[i].lastPongMs > PING_INTERVAL_MS * PONG_MISS_LIMIT) {
+            LOG_W("[%u] Pong yok, bağlantı kapatılıyor\n", i);
+            client->close();
+            continue;
+        }
+        
+        // Pong yükü aynen döner: RTT için istemci başına durum gerekmez
+        uint8_t stamp[4];
+        DriveProtocol::writeU32(stamp, now);
+        client->ping(stamp, sizeof(stamp));
+    }
+}
+
+void WebServerManager::broadcastBattery() {
+    char buf[112];
+    size_t n = battery->writeEvent(buf, sizeof(buf));
+    for (uint8_t i = 0; i < MAX_WS_CLIENTS; i++) {
+        if (links[i].id != 0) sendText(i, buf, n);
+    }
+}
+
+void WebServerManager::flushParams() {
+    char buf[384];
+    size_t n = 0;
+    for (uint8_t i = 0; i < MAX_WS_CLIENTS; i++) {
+        if (!links[i].paramsPending) continue;
+        AsyncWebSocketClient* client = clientAt(i);
+        if (!client || !params) {
+            links[i].paramsPending = false;
+            continue;
+        }
+        if (!client->canSend()) continue;
+        
+        if (n == 0) n = params->writeEvent(buf, sizeof(buf));
+        client->text(buf, n);
+        links[i].paramsPending = false;
+    }
+}
+
+void WebServerManager::queueTelemetry() {
+    for (uint8_t i = 0; i < MAX_WS_CLIENTS; i++) {
+        if (links[i].id == 0) continue;
+        // Önceki hâlâ gönderilemediyse eskisi atılır, yenisi bekler
+        if (links[i].telemetryPending) telemetryDropped++;
+        links[i].telemetryPending = true;
+    }
+}
+
+void WebServerManager::flushTelemetry() {
+    char* buf = statsBuffer;
+    const size_t size = sizeof(statsBuffer);
+    size_t n = 0;
+    
+    for (uint8_t i = 0; i < MAX_WS_CLIENTS; i++) {
+        if (!links[i].telemetryPending) continue;
+        AsyncWebSocketClient* client = clientAt(i);
+        if (!client) {
+            links[i].telemetryPending = false;
+            continue;
+        }
+        if (!client->canSend()) continue;
+        
+        // Geçiş başına bir kez, gönderim anındaki durumla biçimlendir
+        if (n == 0) {
+            n = snprintf(buf, size, "{\"type\":\"telemetry\",");
+            n += writeStats(buf + n, size - n - 1);
+            buf[n++] = '}';
+        }
+        client->text(buf, n);
+        links[i].telemetryPending = false;
+    }
+}
+
+void WebServerManager::handleStats(AsyncWebServerRequest* request) {
+    char* buf = statsBuffer;
+    buf[0] = '{';
+    size_t n = 1 + writeStats(buf + 1, sizeof(statsBuffer) - 2);
+    buf[n++] = '}';
+    buf[n] = '\0';
+    request->send(200, "application/json", buf);
+}
+
+void WebServerManager::handleTasks(AsyncWebServerRequest* request) {
+    scheduler->writeJson(statsBuffer, sizeof(statsBuffer));
+    request->send(200, "application/json", statsBuffer);
+}
+
+void WebServerManager::handleHeap(AsyncWebServerRequest* request) {
+    heap->writeJson(statsBuffer, sizeof(statsBuffer), millis());
+    request->send(200, "application/json", statsBuffer);
+}
+
+void WebServerManager::handleRecord(AsyncWebServerRequest* request) {
+    // İstek yalnızca bırakılır; dosya işlemleri recorder görevinde
+    if (request->hasParam("action")) {
+        const String& action = request->getParam("action")->value();
+        if (action == "start") {
+            recorder->requestStart();
+        } else if (action == "stop") {
+            recorder->requestStop();
+        } else if (action == "replay") {
+            int speed = request->hasParam("speed") ? request->getParam("speed")->value().toInt() : 1;
+            recorder->requestReplay((uint8_t)(speed < 1 ? 1 : (speed > 255 ? 255 : speed)));
+        } else {
+            request->send(400, "text/plain", "Bad Request");
+            return;
+        }
+    }
+    
+    char buf[320];
+    recorder->writeJson(buf, sizeof(buf));
+    request->send(200, "application/json", buf);
+}
+
+void WebServerManager::handleUdp(AsyncWebServerRequest* request) {
+    if (!udp) {
+        request->send(404, "application/json", "{\"error\":\"udp kapalı\"}");
+        return;
+    }
+    if (request->hasParam("new") || udp->getToken() == 0) {
+        udp->openSession();
+    }
+    
+    char buf[256];
+    int n = snprintf(buf, sizeof(buf), "{\"token\":%u,\"stats\":", (unsigned)udp->getToken());
+    size_t length = (size_t)n + udp->writeJson(buf + n, sizeof(buf) - n - 1);
+    buf[length++] = '}';
+    buf[length] = '\0';
+    request->send(200, "application/json", buf);
 }
 
 void WebServerManager::handleRoot(AsyncWebServerRequest* request) {
@@ -53,24 +365,8 @@ void WebServerManager::handleRoot(AsyncWebServerRequest* request) {
 
 void WebServerManager::handleCommand(AsyncWebServerRequest* request) {
     if (request->hasParam("cmd")) {
-        String command = request->getParam("cmd")->value();
-        
-        if (command == "F") motor->forward();
-        else if (command == "B") motor->backward();
-        else if (command == "L") motor->turnLeft();
-        else if (command == "R") motor->turnRight();
-        else if (command == "FL") motor->forwardLeft();
-        else if (command == "FR") motor->forwardRight();
-        else if (command == "BL") motor->backwardLeft();
-        else if (command == "BR") motor->backwardRight();
-        else if (command == "S") motor->stop();
-        else if (command == "PL") motor->pivotLeft();
-        else if (command == "PR") motor->pivotRight();
-        else if (command.startsWith("SPD:")) {
-            int speed = command.substring(4).toInt();
-            motor->setSpeed(speed);
-        }
-        
+        uint32_t rx = hal::cycleCount();
+        processor->handleControl(request->getParam("cmd")->value().c_str(), rx);
         request->send(200, "text/plain", "OK");
     } else {
         request->send(400, "text/plain", "Bad Request");
@@ -78,121 +374,107 @@ void WebServerManager::handleCommand(AsyncWebServerRequest* request) {
 }
 
 void WebServerManager::handleNotFound(AsyncWebServerRequest* request) {
-    String message = "File Not Found\n\n";
-    message += "URI: ";
-    message += request->url();
-    message += "\nMethod: ";
-    message += (request->method() == HTTP_GET) ? "GET" : "POST";
-    message += "\nArguments: ";
-    message += request->args();
-    message += "\n";
+    // Yığındaki tampona tek seferde; url()/argName()/arg() kopyalanmaz
+    // (const String&). Sığmayan argümanlar kesilir.
+    char message[320];
+    int n = snprintf(message, sizeof(message), "File Not Found\n\nURI: %s\nMethod: %s\nArguments: %u\n",
+                     request->url().c_str(), (request->method() == HTTP_GET) ? "GET" : "POST",
+                     (unsigned)request->args());
+    size_t length = n < 0 ? 0 : ((size_t)n < sizeof(message) ? (size_t)n : sizeof(message) - 1);
     
-    for (size_t i = 0; i < request->args(); i++) {
-        message += " " + request->argName(i) + ": " + request->arg(i) + "\n";
+    for (size_t i = 0; i < request->args() && length + 1 < sizeof(message); i++) {
+        n = snprintf(message + length, sizeof(message) - length, " %s: %s\n",
+                     request->argName(i).c_str(), request->arg(i).c_str());
+        if (n < 0) break;
+        length += (size_t)n < sizeof(message) - length ? (size_t)n : sizeof(message) - length - 1;
     }
+    message[length] = '\0';
     
     request->send(404, "text/plain", message);
 }
 
-void WebServerManager::handleWebSocketMessage(uint8_t num, uint8_t* payload, size_t length) {
-    String message = String((char*)payload).substring(0, length);
-    
-    StaticJsonDocument<256> doc;
-    deserializeJson(doc, message);
+bool WebServerManager::sendText(uint8_t client, const char* data, size_t length) {
+    // UDP kanalı yalnızca ikili çerçeve taşır
+    if (client == UdpControl::CLIENT_ID) return false;
     
-    String cmd = doc["cmd"];
-    int value = doc["value"] | 0;
-    
-    if (cmd == "move") {
-        String direction = doc["direction"];
-        
-        if (direction == "forward") motor->forward();
-        else if (direction == "backward") motor->backward();
-        else if (direction == "left") motor->turnLeft();
-        else if (direction == "right") motor->turnRight();
-        else if (direction == "stop") {
-            // Güvenlik için birkaç kez stop çağrısı yap
-            motor->stop();
-            delay(10);
-            motor->stop();
-        }
-        else if (direction == "forward_left") motor->forwardLeft();
-        else if (direction == "forward_right") motor->forwardRight();
-        else if (direction == "backward_left") motor->backwardLeft();
-        else if (direction == "backward_right") motor->backwardRight();
-        
-    } else if (cmd == "speed") {
-        motor->setSpeed(value);
-        
-    } else if (cmd == "custom") {
-        int leftSpeed = doc["left"] | 0;
-        int rightSpeed = doc["right"] | 0;
-        Serial.printf("Custom komut ALINDI: left=%d, right=%d\n", leftSpeed, rightSpeed);
-        Serial.println("smoothTurn çağrılıyor...");
-        motor->smoothTurn(leftSpeed, rightSpeed);
-        Serial.println("smoothTurn tamamlandı");
-    } else if (cmd == "sound") {
-        String action = doc["action"] | "";
-        if (!audio || !audio->isReady()) {
-            Serial.println("DFPlayer hazır değil");
-        } else if (action == "horn") {
-            audio->playHorn();
-        } else if (action == "siren") {
-            audio->playSiren();
-        } else if (action == "song_next") {
-            audio->playNextSong();
-        } else if (action == "stop") {
-            audio->stop();
-        }
+    AsyncWebSocketClient* c = clientAt(client);
+    if (!c || !c->canSend()) {
+        sendDropped++;
+        return false;
+    }
+    c->text(data, length);
+    return true;
+}
+
+bool WebServerManager::sendBinary(uint8_t client, const uint8_t* data, size_t length) {
+    if (client == UdpControl::CLIENT_ID) {
+        return udp && udp->sendBinary(data, length);
     }
     
-    // Geri bildirim gönder
-    StaticJsonDocument<100> response;
-    response["status"] = "ok";
-    response["speed"] = motor->getCurrentSpeed();
-    
-    String responseStr;
-    serializeJson(response, responseStr);
-    webSocket->sendTXT(num, responseStr);
+    AsyncWebSocketClient* c = clientAt(client);
+    if (!c || !c->canSend()) {
+        sendDropped++;
+        return false;
+    }
+    c->binary((const char*)data, length);
+    return true;
 }
 
-void WebServerManager::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length) {
-    if (!instance) return;
+void WebServerManager::onWebSocketEvent(AsyncWebSocketClient* client, AwsEventType type,
+                                        void* arg, uint8_t* data, size_t length) {
+    // Gecikme ölçümünün başlangıç noktası
+    uint32_t rx = hal::cycleCount();
+    int8_t slot = slotOf(client->id());
     
-    switch(type) {
-        case WStype_DISCONNECTED:
-            Serial.printf("[%u] Bağlantı kesildi\n", num);
-            instance->motor->stop(); // Güvenlik için motorları durdur
+    switch (type) {
+        case WS_EVT_CONNECT:
+            slot = slotOf(0);
+            if (slot < 0) {
+                LOG_W("WebSocket istemci sınırı (%u) dolu\n", MAX_WS_CLIENTS);
+                client->close();
+                return;
+            }
+            links[slot].id = client->id();
+            links[slot].lastPongMs = millis();
+            links[slot].telemetryPending = false;
+            links[slot].paramsPending = true;
+            processor->onConnect(slot);
             break;
             
-        case WStype_CONNECTED:
-            {
-                Serial.printf("[%u] Bağlantı kuruldu\n", num);
-                // Güvenlik için motoru durdur
-                instance->motor->stop();
-                
-                // İstemciye hoşgeldin mesajı gönder
-                String welcome = "{\"type\":\"welcome\",\"message\":\"RC Araba'ya hoş geldiniz!\"}";
-                instance->webSocket->sendTXT(num, welcome);
-            }
+        case WS_EVT_DISCONNECT:
+            if (slot < 0) return;
+            links[slot].id = 0;
+            links[slot].telemetryPending = false;
+            links[slot].paramsPending = false;
+            processor->onDisconnect(slot);
             break;
             
-        case WStype_TEXT:
-            instance->handleWebSocketMessage(num, payload, length);
+        case WS_EVT_PONG:
+            if (slot >= 0 && length == 4) {
+                uint32_t now = millis();
+                links[slot].lastPongMs = now;
+                processor->onPong(slot, now - DriveProtocol::readU32(data));
+            }
             break;
             
-        case WStype_ERROR:
-            Serial.printf("[%u] WebSocket hatası\n", num);
+        case WS_EVT_DATA: {
+            if (slot < 0) return;
+            // Komutlar tek parça küçük çerçevelerdir; parçalılar desteklenmez
+            AwsFrameInfo* info = (AwsFrameInfo*)arg;
+            if (!info->final || info->index != 0 || info->len != length) {
+                fragmented++;
+                return;
+            }
+            if (info->opcode == WS_TEXT) {
+                processor->handleText(slot, data, length, rx);
+            } else if (info->opcode == WS_BINARY) {
+                processor->handleBinary(slot, data, length, rx);
+            }
             break;
+        }
             
-        case WStype_FRAGMENT_TEXT_START:
-        case WStype_FRAGMENT_BIN_START:
-        case WStype_FRAGMENT_FIN:
-        case WStype_BIN:
-        case WStype_FRAGMENT:
-        case WStype_PING:
-        case WStype_PONG:
-            // Diğer mesaj türleri - şimdilik ignore et
+        case WS_EVT_ERROR:
+            LOG_W("[%d] WebSocket hatası\n", slot);
             break;
     }
-}
\ No newline at end of file
+}
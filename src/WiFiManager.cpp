@@ -1,50 +1,125 @@
 #include "WiFiManager.h"
+#include "Log.h"
 
 void WiFiManager::begin() {
-    Serial.begin(115200);
-    Serial.println("\n\nRC Araba Başlatılıyor...");
-    
+    // Serial setup()'ta açıldı; yeniden begin() GPIO3'ü UART RX'e geri alırdı
+    LOG_BOOT("\n\nRC Araba Başlatılıyor...\n");
+
+    uint32_t now = millis();
+
     if (apMode) {
         // Access Point modu
-        Serial.println("Access Point modu başlatılıyor...");
+        LOG_BOOT("Access Point modu başlatılıyor...\n");
+        WiFi.mode(WIFI_AP);
         WiFi.softAP(ssid, password);
-        
-        Serial.print("AP SSID: ");
-        Serial.println(ssid);
-        Serial.print("AP IP Adresi: ");
-        Serial.println(WiFi.softAPIP());
-    } else {
-        // Station modu (ev WiFi'sine bağlan)
-        Serial.println("Station modu başlatılıyor...");
-        WiFi.begin(ssid, password);
-        
-        Serial.print("WiFi'ye bağlanıyor: ");
-        Serial.println(ssid);
-        
-        int attempts = 0;
-        while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-            delay(500);
-            Serial.print(".");
-            attempts++;
+
+        LOG_BOOT("AP SSID: %s\n", ssid);
+        LOG_BOOT("AP IP Adresi: %s\n", WiFi.softAPIP().toString().c_str());
+        enter(AP_ONLY, now);
+        return;
+    }
+
+    // Station modu (ev WiFi'sine bağlan) - yedek AP baştan açık
+    LOG_BOOT("Station modu başlatılıyor (AP+STA)...\n");
+    WiFi.mode(WIFI_AP_STA);
+    WiFi.softAP(apSsid, apPassword);
+    LOG_BOOT("Yedek AP: %s (%s)\n", apSsid, WiFi.softAPIP().toString().c_str());
+
+    // Yeniden bağlanma kararlarını SDK değil durum makinesi verir
+    WiFi.setAutoReconnect(false);
+
+    gotIpHandler = WiFi.onStationModeGotIP([this](const WiFiEventStationModeGotIP&) {
+        gotIpEvent = true;
+    });
+    disconnectHandler = WiFi.onStationModeDisconnected([this](const WiFiEventStationModeDisconnected& event) {
+        disconnectReason = (uint8_t)event.reason;
+        disconnectEvent = true;
+    });
+
+    LOG_BOOT("WiFi'ye bağlanıyor: %s\n", ssid);
+    downSince = now;
+    startAttempt(now);
+}
+
+void WiFiManager::loop(uint32_t nowMs) {
+    if (state == AP_ONLY || state == IDLE) return;
+
+    if (gotIpEvent) {
+        gotIpEvent = false;
+        disconnectEvent = false;
+
+        lastConnectMs = nowMs - downSince;
+        if (lastConnectMs > maxConnectMs) maxConnectMs = lastConnectMs;
+        connects++;
+        backoffMs = BACKOFF_MIN_MS;
+        enter(CONNECTED, nowMs);
+
+        IPAddress ip = WiFi.localIP();
+        LOG_I("WiFi'ye bağlandı: %u.%u.%u.%u\n", ip[0], ip[1], ip[2], ip[3]);
+        LOG_I("WiFi bağlanma süresi %u ms (%u deneme)\n", (unsigned)lastConnectMs, (unsigned)attempts);
+        return;
+    }
+
+    if (disconnectEvent) {
+        disconnectEvent = false;
+        lastReason = disconnectReason;
+
+        if (state == CONNECTED) {
+            disconnects++;
+            downSince = nowMs;
+            LOG_W("WiFi bağlantısı kesildi (sebep %u), AP üzerinden devam\n", lastReason);
+            // Kopuş sonrası ilk deneme hemen
+            startAttempt(nowMs);
+            return;
         }
-        
-        if (WiFi.status() == WL_CONNECTED) {
-            Serial.println("\nWiFi'ye bağlandı!");
-            Serial.print("IP Adresi: ");
-            Serial.println(WiFi.localIP());
-        } else {
-            Serial.println("\nWiFi bağlantısı başarısız! AP moduna geçiliyor...");
-            apMode = true;
-            WiFi.softAP("RC_Araba_AP", "12345678");
+        if (state == CONNECTING) {
+            // Deneme reddedildi (yanlış şifre, ağ yok...): zaman aşımını bekleme
+            enter(BACKOFF, nowMs);
+            return;
         }
     }
+
+    switch (state) {
+        case CONNECTING:
+            if (nowMs - stateSince >= CONNECT_TIMEOUT_MS) {
+                LOG_W("WiFi bağlantı denemesi zaman aşımı\n");
+                WiFi.disconnect();
+                enter(BACKOFF, nowMs);
+            }
+            break;
+
+        case BACKOFF:
+            if (nowMs - stateSince >= backoffMs) {
+                backoffMs = backoffMs * 2 < BACKOFF_MAX_MS ? backoffMs * 2 : BACKOFF_MAX_MS;
+                startAttempt(nowMs);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void WiFiManager::startAttempt(uint32_t nowMs) {
+    attempts++;
+    disconnectEvent = false;
+    WiFi.begin(ssid, password);     // Engellemez; sonuç olay olarak gelir
+    enter(CONNECTING, nowMs);
+}
+
+void WiFiManager::enter(State next, uint32_t nowMs) {
+    if (next == BACKOFF) {
+        LOG_D("WiFi: %u ms sonra yeniden denenecek\n", (unsigned)backoffMs);
+    }
+    state = next;
+    stateSince = nowMs;
 }
 
 String WiFiManager::getIPAddress() {
-    if (apMode) {
-        return WiFi.softAPIP().toString();
-    } else {
+    if (state == CONNECTED) {
         return WiFi.localIP().toString();
+    } else {
+        return WiFi.softAPIP().toString();
     }
 }
 
@@ -52,10 +127,39 @@ bool WiFiManager::isConnected() {
     if (apMode) {
         return true; // AP her zaman "bağlı"
     } else {
-        return WiFi.status() == WL_CONNECTED;
+        return state == CONNECTED;
     }
 }
 
 void WiFiManager::setMode(bool accessPointMode) {
     apMode = accessPointMode;
-}
\ No newline at end of file
+}
+
+void WiFiManager::setCredentials(const char* networkSsid, const char* networkPassword) {
+    snprintf(ssid, sizeof(ssid), "%s", networkSsid);
+    snprintf(password, sizeof(password), "%s", networkPassword);
+}
+
+const char* WiFiManager::stateName(State s) {
+    switch (s) {
+        case IDLE:       return "idle";
+        case AP_ONLY:    return "ap";
+        case CONNECTING: return "connecting";
+        case CONNECTED:  return "connected";
+        case BACKOFF:    return "backoff";
+    }
+    return "?";
+}
+
+size_t WiFiManager::writeJson(char* buf, size_t size) const {
+    if (size == 0) return 0;
+    int rssi = state == CONNECTED ? (int)WiFi.RSSI() : 0;
+    int n = snprintf(buf, size,
+                     "{\"state\":\"%s\",\"attempts\":%u,\"connects\":%u,\"disconnects\":%u,"
+                     "\"connect_ms\":%u,\"connect_ms_max\":%u,\"reason\":%u,\"rssi\":%d}",
+                     stateName(state), (unsigned)attempts, (unsigned)connects,
+                     (unsigned)disconnects, (unsigned)lastConnectMs, (unsigned)maxConnectMs,
+                     (unsigned)lastReason, rssi);
+    if (n < 0) return 0;
+    return (size_t)n < size ? (size_t)n : size - 1;
+}
@@ -0,0 +1,306 @@
+#include "Hal.h"
+#include "Esp8266GpioPort.h"
+#include <Arduino.h>
+#include <SoftwareSerial.h>
+#include <LittleFS.h>
+#include <EEPROM.h>
+#include <WiFiUdp.h>
+#include <stdarg.h>
+
+namespace hal {
+
+uint32_t millis() {
+    return ::millis();
+}
+
+uint32_t micros() {
+    return ::micros();
+}
+
+uint32_t cycleCount() {
+    return ESP.getCycleCount();
+}
+
+uint32_t cyclesPerMicro() {
+    return ESP.getCpuFreqMHz();
+}
+
+void logf(const char* fmt, ...) {
+    char buf[160];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n <= 0) return;
+    if (n >= (int)sizeof(buf)) n = sizeof(buf) - 1;
+    Serial.write((const uint8_t*)buf, n);
+}
+
+void logWrite(const char* data, size_t length) {
+    Serial.write((const uint8_t*)data, length);
+}
+
+size_t logWritable() {
+    return Serial.availableForWrite();
+}
+
+GpioPort& gpio() {
+    static Esp8266GpioPort port;
+    return port;
+}
+
+HeapInfo heap() {
+    HeapInfo info;
+    info.freeBytes = ESP.getFreeHeap();
+    info.maxBlock = ESP.getMaxFreeBlockSize();
+    info.fragmentation = ESP.getHeapFragmentation();
+    return info;
+}
+
+uint16_t analogRead() {
+    return (uint16_t)::analogRead(A0);
+}
+
+uint32_t random32() {
+    return RANDOM_REG32;
+}
+
+// Enkoder kesmeleri: durum sabit dizide (kesme rutini sanal çağrı ya da
+// işaretçi takibi yapmasın), rutinler IRAM'de (flash önbelleği dışında da
+// çalışabilmeli). A'nın her iki kenarı sayılır; çift kanalda yön A ile B'nin
+// karşılaştırmasından gelir (ters sayarsa A/B kabloları değiştirilir).
+namespace {
+
+struct EncoderState {
+    volatile int32_t count;
+    volatile int8_t direction;
+    uint32_t maskA;
+    uint32_t maskB;     // 0: tek kanal
+};
+
+EncoderState encoderStates[2];
+
+inline void __attribute__((always_inline)) countEdge(EncoderState& state) {
+    if (state.maskB) {
+        uint32_t in = GPI;
+        bool a = (in & state.maskA) != 0;
+        bool b = (in & state.maskB) != 0;
+        state.count += (a != b) ? 1 : -1;
+    } else {
+        state.count += state.direction;
+    }
+}
+
+void IRAM_ATTR onLeftEncoderEdge() {
+    countEdge(encoderStates[0]);
+}
+
+void IRAM_ATTR onRightEncoderEdge() {
+    countEdge(encoderStates[1]);
+}
+
+}
+
+class IsrEncoder : public Encoder {
+private:
+    EncoderState& state;
+
+public:
+    explicit IsrEncoder(EncoderState& encoderState) : state(encoderState) {}
+
+    int32_t count() override {
+        return state.count;
+    }
+
+    void setDirection(int8_t sign) override {
+        state.direction = sign < 0 ? -1 : 1;
+    }
+};
+
+Encoder* encoder(uint8_t index, int8_t pinA, int8_t pinB) {
+    static IsrEncoder* instances[2] = { nullptr, nullptr };
+    if (index >= 2 || pinA < 0 || pinA > 15 || pinB > 15) return nullptr;
+    if (instances[index]) return instances[index];
+
+    EncoderState& state = encoderStates[index];
+    state.count = 0;
+    state.direction = 1;
+    state.maskA = 1UL << pinA;
+    state.maskB = pinB >= 0 ? 1UL << pinB : 0;
+
+    pinMode(pinA, INPUT_PULLUP);
+    if (pinB >= 0) pinMode(pinB, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(pinA),
+                    index == 0 ? onLeftEncoderEdge : onRightEncoderEdge, CHANGE);
+
+    instances[index] = new IsrEncoder(state);
+    return instances[index];
+}
+
+class SoftSerialPort : public SerialPort {
+private:
+    SoftwareSerial serial;
+
+public:
+    SoftSerialPort(uint8_t rxPin, uint8_t txPin, uint32_t baud) : serial(rxPin, txPin) {
+        serial.begin(baud);
+    }
+
+    int read() override {
+        return serial.read();
+    }
+
+    size_t write(uint8_t value) override {
+        return serial.write(value);
+    }
+};
+
+SerialPort& softSerial(uint8_t rxPin, uint8_t txPin, uint32_t baud) {
+    static SoftSerialPort port(rxPin, txPin, baud);
+    return port;
+}
+
+class LittleFsBlockFile : public BlockFile {
+private:
+    File file;
+    size_t blockSize;
+    uint16_t blocks;
+
+public:
+    LittleFsBlockFile(File handle, size_t size, uint16_t count)
+        : file(handle), blockSize(size), blocks(count) {}
+
+    uint16_t blockCount() const override {
+        return blocks;
+    }
+
+    bool read(uint16_t index, uint8_t* data, size_t length) override {
+        if (index >= blocks || length > blockSize) return false;
+        if (!file.seek((uint32_t)index * blockSize, SeekSet)) return false;
+        return file.read(data, length) == length;
+    }
+
+    bool write(uint16_t index, const uint8_t* data, size_t length) override {
+        if (index >= blocks || length > blockSize) return false;
+        if (!file.seek((uint32_t)index * blockSize, SeekSet)) return false;
+        bool ok = file.write(data, length) == length;
+        file.flush();   // Meta veriyi işle: güç kesilirse en fazla bu blok kaybolur
+        return ok;
+    }
+
+    void close() override {
+        file.close();
+    }
+};
+
+BlockFile* blockFile(const char* path, size_t blockSize, uint16_t blockCount) {
+    static LittleFsBlockFile* instance = nullptr;
+    if (instance) return instance;
+
+#ifdef EMBED_WEB_UI
+    // Gömülü arayüzde LittleFS hiç bağlanmaz: begin() imajı olmayan bölümü
+    // biçimlendirirdi. Kayıt kapalı kalır (UNAVAILABLE)
+    (void)path;
+    (void)blockSize;
+    (void)blockCount;
+    return nullptr;
+#else
+    // setup() bağladı; tekrar çağrı zararsız
+    if (!LittleFS.begin()) return nullptr;
+
+    size_t total = blockSize * blockCount;
+    File file = LittleFS.open(path, LittleFS.exists(path) ? "r+" : "w+");
+    if (!file) return nullptr;
+
+    if (file.size() < total) {
+        // Boş bloklar 0xFF (geçersiz başlık); bir kez, açılışta
+        uint8_t erased[64];
+        memset(erased, 0xFF, sizeof(erased));
+        file.seek(file.size(), SeekSet);
+        for (size_t n = file.size(); n < total; n += sizeof(erased)) {
+            file.write(erased, total - n < sizeof(erased) ? total - n : sizeof(erased));
+        }
+        file.flush();
+    }
+
+    instance = new LittleFsBlockFile(file, blockSize, blockCount);
+    return instance;
+#endif
+}
+
+class EepromBlockFile : public BlockFile {
+private:
+    size_t blockSize;
+
+public:
+    explicit EepromBlockFile(size_t size) : blockSize(size) {}
+
+    uint16_t blockCount() const override {
+        return 1;
+    }
+
+    bool read(uint16_t index, uint8_t* data, size_t length) override {
+        if (index != 0 || length > blockSize) return false;
+        memcpy(data, EEPROM.getConstDataPtr(), length);
+        return true;
+    }
+
+    bool write(uint16_t index, const uint8_t* data, size_t length) override {
+        if (index != 0 || length > blockSize) return false;
+        memcpy(EEPROM.getDataPtr(), data, length);  // getDataPtr() kirli işaretler
+        return EEPROM.commit();
+    }
+};
+
+BlockFile* configSector(size_t size) {
+    static EepromBlockFile* instance = nullptr;
+    if (instance) return instance;
+
+    // Sektörün ilk size baytı RAM'e okunur (bir kez, açılışta)
+    EEPROM.begin(size);
+    instance = new EepromBlockFile(size);
+    return instance;
+}
+
+class WiFiDatagramSocket : public DatagramSocket {
+private:
+    WiFiUDP udp;
+
+public:
+    bool begin(uint16_t port) {
+        return udp.begin(port) == 1;
+    }
+
+    int receive(uint8_t* buf, size_t size, Endpoint& from) override {
+        int length = udp.parsePacket();
+        if (length <= 0) return 0;
+        from.address = (uint32_t)udp.remoteIP();
+        from.port = udp.remotePort();
+        if ((size_t)length > size) {
+            udp.flush();
+            return -1;
+        }
+        return udp.read(buf, (size_t)length);
+    }
+
+    bool send(const Endpoint& to, const uint8_t* data, size_t length) override {
+        if (!udp.beginPacket(IPAddress(to.address), to.port)) return false;
+        udp.write(data, length);
+        return udp.endPacket() == 1;
+    }
+};
+
+DatagramSocket* udpSocket(uint16_t port) {
+    static WiFiDatagramSocket* instance = nullptr;
+    if (instance) return instance;
+
+    WiFiDatagramSocket* socket = new WiFiDatagramSocket();
+    if (!socket->begin(port)) {
+        delete socket;
+        return nullptr;
+    }
+    instance = socket;
+    return instance;
+}
+
+}
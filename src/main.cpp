@@ -1,13 +1,19 @@
 #include <Arduino.h>
 #include <LittleFS.h>
 #include <ESP8266WiFi.h>
-#include <WiFiUdp.h>
 #include <ArduinoOTA.h>
 
 #include "MotorController.h"
 #include "WiFiManager.h"
 #include "WebServerManager.h"
 #include "AudioManager.h"
+#include "Scheduler.h"
+#include "HeapMonitor.h"
+#include "DriveRecorder.h"
+#include "BatteryMonitor.h"
+#include "ParamStore.h"
+#include "Hal.h"
+#include "Log.h"
 
 // Pin Tanımlamaları - TB6612FNG için
 #define PWMA D1  // GPIO5 - Sol motor PWM
@@ -24,11 +30,52 @@
 #define DFPLAYER_RX D5  // ESP RX (DFPlayer TX)
 #define DFPLAYER_TX D6  // ESP TX (DFPlayer RX)
 
+// Teker enkoderleri (isteğe bağlı, build_flags ile): tanımlı değilse
+// motorlar açık çevrim sürülür. Tüm D pinleri dolu olduğundan adaylar
+// GPIO3 (RX; Serial aşağıda yalnızca TX'e geçer, konsol çıktısı sürer) ve
+// DIO flash kipinde GPIO10'dur. GPIO1 UART0 TX'tir: Serial ve LOG_BOOT
+// pini sürer, enkoder olarak kullanılamaz. _B tanımlı değilse tek
+// kanallı (hall) enkoder.
+#ifndef ENCODER_LEFT_B
+#define ENCODER_LEFT_B -1
+#endif
+#ifndef ENCODER_RIGHT_B
+#define ENCODER_RIGHT_B -1
+#endif
+#if ENCODER_LEFT_A == 1 || ENCODER_RIGHT_A == 1 || ENCODER_LEFT_B == 1 || ENCODER_RIGHT_B == 1
+#error "GPIO1 (UART0 TX) seri konsolla çakışır; enkoder için GPIO3/GPIO10 kullanın"
+#endif
+#if ENCODER_LEFT_A == 3 || ENCODER_RIGHT_A == 3 || ENCODER_LEFT_B == 3 || ENCODER_RIGHT_B == 3
+#define SERIAL_PINS SERIAL_TX_ONLY     // RX (GPIO3) enkodere kalır
+#else
+#define SERIAL_PINS SERIAL_FULL
+#endif
+#ifndef ENCODER_COUNTS_PER_REV
+#define ENCODER_COUNTS_PER_REV 420  // N20 hall: 7 kutup * 2 kenar * 30:1 dişli
+#endif
+
+// Batarya gerilimi (A0): NodeMCU'nun dahili bölücüsü (220k/100k) önüne
+// 680k seri dirençle tam ölçek ~10 V (2S LiPo). 0: ölçüm kapalı
+#ifndef BATTERY_FULL_SCALE_MV
+#define BATTERY_FULL_SCALE_MV 10000
+#endif
+
 // Global nesneler
 MotorController* motor;
 WiFiManager* wifi;
 WebServerManager* webServer;
 AudioManager* audio;
+DriveRecorder* recorder;
+BatteryMonitor* battery = nullptr;
+
+// loop() görevleri (periyot/öncelik); istatistikler /api/tasks
+Scheduler scheduler;
+
+// Uzun sürüşlerde heap eğilimi (/api/heap)
+HeapMonitor heapMonitor;
+
+// Canlı ayarlanan, EEPROM sektöründe saklanan parametreler
+ParamStore params;
 
 void setupOTA() {
     // OTA (Over-The-Air) Güncelleme Ayarları
@@ -36,110 +83,179 @@ void setupOTA() {
     ArduinoOTA.setPassword("admin123"); // OTA şifresi
     
     ArduinoOTA.onStart([]() {
-        String type;
+        // Süren kayıt flash'a yazılır ve /drive.log kapatılır: dosya
+        // sistemi açık dosyayla sökülmez, yeni imaj yazılırken dokunulmaz
+        recorder->end();
+        
+        const char* type;
         if (ArduinoOTA.getCommand() == U_FLASH) {
             type = "sketch";
         } else { // U_SPIFFS
             type = "filesystem";
             LittleFS.end();
         }
-        Serial.println("OTA Güncelleme Başladı: " + type);
+        LOG_BOOT("OTA Güncelleme Başladı: %s\n", type);
         motor->stop(); // Güvenlik için motorları durdur
     });
     
     ArduinoOTA.onEnd([]() {
-        Serial.println("\nOTA Güncelleme Tamamlandı!");
+        LOG_BOOT("\nOTA Güncelleme Tamamlandı!\n");
     });
     
     ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
-        Serial.printf("OTA İlerleme: %u%%\r", (progress * 100) / total);
+        LOG_BOOT("OTA İlerleme: %u%%\r", (progress * 100) / total);
     });
     
     ArduinoOTA.onError([](ota_error_t error) {
-        Serial.printf("OTA Hatası[%u]: ", error);
-        if (error == OTA_AUTH_ERROR) Serial.println("Yetkilendirme Hatası");
-        else if (error == OTA_BEGIN_ERROR) Serial.println("Başlatma Hatası");
-        else if (error == OTA_CONNECT_ERROR) Serial.println("Bağlantı Hatası");
-        else if (error == OTA_RECEIVE_ERROR) Serial.println("Alma Hatası");
-        else if (error == OTA_END_ERROR) Serial.println("Bitirme Hatası");
+        LOG_BOOT("OTA Hatası[%u]: ", error);
+        if (error == OTA_AUTH_ERROR) LOG_BOOT("Yetkilendirme Hatası\n");
+        else if (error == OTA_BEGIN_ERROR) LOG_BOOT("Başlatma Hatası\n");
+        else if (error == OTA_CONNECT_ERROR) LOG_BOOT("Bağlantı Hatası\n");
+        else if (error == OTA_RECEIVE_ERROR) LOG_BOOT("Alma Hatası\n");
+        else if (error == OTA_END_ERROR) LOG_BOOT("Bitirme Hatası\n");
     });
     
     ArduinoOTA.begin();
-    Serial.println("OTA Güncelleme Hazır");
-    Serial.print("OTA Hostname: rc-otonomous-car.local veya ");
-    Serial.println(WiFi.localIP());
+    LOG_BOOT("OTA Güncelleme Hazır\n");
+    LOG_BOOT("OTA Hostname: rc-otonomous-car.local veya %s\n", WiFi.localIP().toString().c_str());
+}
+
+// Tablo dolu olduğu için eklenemeyen görev (ör. motor tick'i ve bekçisi)
+// sessizce eksik kalmaz: açılış motorlar bırakılmış olarak burada durur
+static void addTask(const char* name, Scheduler::TaskFn run, uint32_t periodUs, uint8_t priority,
+                    uint32_t budgetUs) {
+    if (scheduler.add(name, run, periodUs, priority, budgetUs)) return;
+    LOG_BOOT("Zamanlayıcı dolu (%u görev): %s eklenemedi, durduruldu\n",
+             (unsigned)Scheduler::MAX_TASKS, name);
+    motor->stop();
+    for (;;) {
+        delay(1000);
+    }
 }
 
 void setup() {
-    Serial.begin(115200);
+    Serial.begin(115200, SERIAL_8N1, SERIAL_PINS);
     delay(1000);
     
-    Serial.println("\n=================================");
-    Serial.println("   RC Araba Kontrol Sistemi");
-    Serial.println("=================================");
+    LOG_BOOT("\n=================================\n");
+    LOG_BOOT("   RC Araba Kontrol Sistemi\n");
+    LOG_BOOT("=================================\n");
+    
+    // Parametreler: kayıt yoksa/bozuksa derlemedeki varsayılanlar
+    params.begin(hal::configSector(ParamStore::RECORD_SIZE));
     
-    // Motor kontrolörü oluştur
-    motor = new MotorController(PWMA, AIN1, AIN2, PWMB, BIN1, BIN2, STBY);
+    // Motor kontrolörü oluştur (hız, kalkış eşiği, rampa parametrelerden)
+    motor = new MotorController(hal::gpio(), PWMA, AIN1, AIN2, PWMB, BIN1, BIN2, STBY);
     motor->begin();
-    motor->setSpeed(150); // Varsayılan hız
+    motor->setParams(&params);
+    
+#if defined(ENCODER_LEFT_A) && defined(ENCODER_RIGHT_A)
+    // Kazançlar tools/speed_tune.cpp ile motor modeline karşı ayarlandı
+    SpeedConfig speed;
+    speed.countsPerRev = ENCODER_COUNTS_PER_REV;
+    speed.maxCountsPerSec = 1500;   // PWM_MAX'ta yüksüz hız (~215 rpm); wheels.rpm ile ölçülmeli
+    speed.kp = 300;
+    speed.ki = 4800;
+    speed.rateHz = MotorController::SPEED_HZ;
+    motor->setEncoders(hal::encoder(0, ENCODER_LEFT_A, ENCODER_LEFT_B),
+                       hal::encoder(1, ENCODER_RIGHT_A, ENCODER_RIGHT_B), speed);
+#endif
 
+#if BATTERY_FULL_SCALE_MV
+    // 2S: nominal 7,4 V (PWM değerleri buna göre), düşük 3,4 V/hücre,
+    // çöküş eşiği 3,0 V/hücre (regülatör girişi ~4,5 V'un altına inmeden)
+    BatteryConfig batteryConfig;
+    batteryConfig.fullScaleMv = BATTERY_FULL_SCALE_MV;
+    batteryConfig.nominalMv = 7400;
+    batteryConfig.lowMv = 6800;
+    batteryConfig.criticalMv = 6000;
+    batteryConfig.absentMv = 3000;  // Altı: USB'den besleniyor, telafi yok
+    battery = new BatteryMonitor(batteryConfig);
+    battery->poll(millis());
+    motor->setBattery(battery);
+    LOG_BOOT("Batarya: %u mV\n", (unsigned)battery->getMillivolts());
+#endif
+    
     // DFPlayer başlat
     audio = new AudioManager(DFPLAYER_RX, DFPLAYER_TX);
+    audio->setParams(&params);
     audio->begin();
     
     // WiFi başlat
+    // WiFi ayarları yalnızca açılışta okunur (sürüş sırasında bağlantıyı koparmaz)
     wifi = new WiFiManager();
+    wifi->setMode(params.getShadow().stationMode == 0);
+    wifi->setCredentials(params.getShadow().ssid, params.getShadow().password);
     wifi->begin();
     
-    // SPIFFS (LittleFS) başlat
+#ifndef EMBED_WEB_UI
+    // SPIFFS (LittleFS) başlat - gömülü arayüzde (PROGMEM) gerekmez
     if (!LittleFS.begin()) {
-        Serial.println("LittleFS başlatılamadı!");
+        LOG_BOOT("LittleFS başlatılamadı!\n");
         // Hata durumunda formatla (dikkatli olun!)
         // LittleFS.format();
         // LittleFS.begin();
     } else {
-        Serial.println("LittleFS başlatıldı");
+        LOG_BOOT("LittleFS başlatıldı\n");
         
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
         // Dosya sistemini listele (debug için)
         Dir dir = LittleFS.openDir("/");
         while (dir.next()) {
-            Serial.print("  ");
-            Serial.print(dir.fileName());
-            Serial.print(" - ");
-            Serial.print(dir.fileSize());
-            Serial.println(" bytes");
+            LOG_BOOT("  %s - %u bytes\n", dir.fileName().c_str(), (unsigned)dir.fileSize());
         }
+#endif
     }
+#endif
+    
+    // Sürüş kaydı (/drive.log); gömülü arayüzde dosya sistemi yok, kapalı kalır
+    recorder = new DriveRecorder(motor);
+    recorder->begin();
+    motor->setRecorder(recorder);
     
     // OTA'yı kur
     setupOTA();
     
     // Web server başlat
-    webServer = new WebServerManager(motor, audio);
+    webServer = new WebServerManager(motor, audio, wifi, &scheduler, &heapMonitor, recorder, battery, &params);
     webServer->begin();
     
-    Serial.println("\nSistem Hazır!");
-    Serial.print("Bağlanmak için: ");
-    Serial.print("http://");
-    Serial.println(wifi->getIPAddress());
-    Serial.println("WebSocket Port: 81");
-    Serial.println("=================================\n");
+    // Görevler: ad, iş, periyot (µs, 0: her geçiş), öncelik (büyük önce), bütçe (µs)
+    // Motor tick'i sabit 200 Hz, ağ trafiğinden bağımsız
+    addTask("motor", [](uint32_t) { motor->tick(); },
+            MotorController::CONTROL_PERIOD_US, 5, 500);
+    // Gelen kutusundaki en yeni sürüş çerçevesi, ping, telemetri
+    addTask("web", [](uint32_t) { webServer->loop(); }, 0, 4, 2000);
+    // DFPlayer: çağrı başına en fazla bir bayt (~1 ms hat süresi)
+    addTask("audio", [](uint32_t now) { audio->loop(now); }, 1000, 3, 1500);
+    // WiFi durum makinesi: olayları işler, gerekirse yeni deneme başlatır (beklemez)
+    addTask("wifi", [](uint32_t) { wifi->loop(millis()); }, 50000, 2, 1000);
+    addTask("ota", [](uint32_t) { ArduinoOTA.handle(); }, 20000, 1, 2000);
+    // Kayıt kuyruğunu flash'a yazar (geçiş başına bir blok), oynatmayı sürer
+    addTask("recorder", [](uint32_t) { recorder->poll(millis()); }, 1000, 1, 8000);
+    // A0: 20 ms'de 4 okuma (~0,4 ms); daha sık okuma WiFi'yi bozar
+    if (battery) {
+        addTask("battery", [](uint32_t) { battery->poll(millis()); }, 20000, 2, 600);
+    }
+    // Parametre kaydı: sektör silme onlarca ms sürer, yalnızca motorlar dururken
+    addTask("params", [](uint32_t) { params.poll(motor->isIdle()); }, 100000, 0, 60000);
+    addTask("heap", [](uint32_t) { heapMonitor.poll(millis(), hal::heap()); }, 1000000, 0, 200);
+    // Ertelenmiş günlük kayıtlarını UART'ı bloke etmeden boşalt
+    addTask("log", [](uint32_t) { Log::drain(); }, 0, 0, 1000);
+    
+    LOG_BOOT("\nSistem Hazır!\n");
+    LOG_BOOT("Bağlanmak için: http://%s\n", wifi->getIPAddress().c_str());
+    LOG_BOOT("WebSocket: ws://%s/ws\n", wifi->getIPAddress().c_str());
+#if UDP_CONTROL_PORT
+    LOG_BOOT("UDP: %s:%u (belirteç: /api/udp)\n", wifi->getIPAddress().c_str(), (unsigned)UDP_CONTROL_PORT);
+#endif
+    LOG_BOOT("=================================\n\n");
 }
 
 void loop() {
-    webServer->loop();
-    ArduinoOTA.handle(); // OTA'yı handle et
+    scheduler.runPass(micros());
     
-    // 30 saniyede bir bağlantı durumunu kontrol et
-    static unsigned long lastCheck = 0;
-    if (millis() - lastCheck > 30000) {
-        lastCheck = millis();
-        
-        if (!wifi->isConnected()) {
-            Serial.println("WiFi bağlantısı kesildi! Yeniden bağlanılıyor...");
-            wifi->begin();
-        }
-    }
-    
-    delay(10); // CPU kullanımını azalt
-}
\ No newline at end of file
+    // Boş süre sabit delay() yerine WiFi yığınına verilir; gelen çerçeveler
+    // bir sonraki geçişte, en fazla bir geçiş gecikmeyle işlenir
+    yield();
+}
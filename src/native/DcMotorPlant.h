@@ -0,0 +1,104 @@
+#ifndef DC_MOTOR_PLANT_H
+#define DC_MOTOR_PLANT_H
+
+#include <stdint.h>
+#include <math.h>
+
+// Fırçalı DC motor + dişli + teker modeli (host; simülatör ve tools/speed_tune).
+//
+// Elektriksel zaman sabiti (L/R, ~1 ms) mekaniğinkinden (~50 ms) çok küçük
+// olduğundan akım yarı-statik alınır: i = (V - Ke*w) / R. Sürücü PWM'i
+// ortalama gerilimdir (TB6612'de PWM'in düşük fazı kısa devre frenidir,
+// ortalama model buna uyar); STOP (IN1 = IN2 = 0) çıkışları açar, akım
+// sıfırdır ve teker sürtünmeyle yavaşlar. Sürtünme: viskoz + Coulomb +
+// kalkış (duran teker tork stiction'ı aşana kadar dönmez). Değerler teker
+// miline indirgenmiştir (dişli oranı dahil).
+struct DcMotorParams {
+    float supplyV;      // Batarya (V)
+    float resistance;   // Sargı direnci (ohm)
+    float kt;           // Tork/akım = zıt EMK sabiti (N·m/A = V·s/rad)
+    float inertia;      // Teker + araç kütlesinin payı (kg·m²)
+    float viscous;      // N·m·s/rad
+    float coulomb;      // Dönerken sabit sürtünme (N·m)
+    float stiction;     // Kalkış torku (N·m)
+    uint16_t countsPerRev;
+
+    // N20 30:1 + 65 mm teker, ~0.5 kg araç, 2S LiPo: PWM ~%50'de dönmeye
+    // devam eder, ~%57'de kalkar (MotorController minPwm 150 ile uyumlu)
+    static DcMotorParams n20() {
+        DcMotorParams p;
+        p.supplyV = 7.4f;
+        p.resistance = 4.0f;
+        p.kt = 0.15f;
+        p.inertia = 2.7e-4f;
+        p.viscous = 5e-4f;
+        p.coulomb = 0.139f;
+        p.stiction = 0.158f;
+        p.countsPerRev = 420;
+        return p;
+    }
+};
+
+class DcMotorPlant {
+private:
+    static constexpr float SUBSTEP = 2.5e-4f;   // s; mekanik sabitin ~1/200'ü
+    static constexpr float PI2 = 6.2831853f;
+
+    DcMotorParams params;
+    float omega = 0;        // rad/s
+    double angle = 0;       // rad (uzun sürüşte hassasiyet için double)
+    float current = 0;
+
+    void integrate(float duty, bool coast, float h) {
+        current = coast ? 0 : (duty * params.supplyV - params.kt * omega) / params.resistance;
+        float torque = params.kt * current - params.viscous * omega - load;
+
+        if (omega == 0) {
+            if (fabsf(torque) <= params.stiction) return;   // Yapışık
+            torque -= copysignf(params.coulomb, torque);
+        } else {
+            torque -= copysignf(params.coulomb, omega);
+        }
+
+        float next = omega + torque / params.inertia * h;
+        // Sürtünme yön çeviremez: sıfırdan geçerse teker durur
+        if (omega != 0 && (next > 0) != (omega > 0)) next = 0;
+        angle += 0.5 * (omega + next) * h;
+        omega = next;
+    }
+
+public:
+    float load = 0;         // Dış yük torku (N·m); pozitif ileri dönüşe karşı koyar (yokuş)
+
+    explicit DcMotorPlant(const DcMotorParams& p = DcMotorParams::n20()) : params(p) {}
+
+    // duty: -1..1 (işaretli ortalama gerilim oranı), coast: çıkışlar açık
+    void step(float duty, bool coast, float dt) {
+        while (dt > 0) {
+            float h = dt < SUBSTEP ? dt : SUBSTEP;
+            integrate(duty, coast, h);
+            dt -= h;
+        }
+    }
+
+    // Batarya gerilimi (iç dirençle çöken pil modeli için)
+    void setSupply(float volts) { params.supplyV = volts; }
+
+    const DcMotorParams& getParams() const { return params; }
+    float speed() const { return omega; }
+    float rpm() const { return omega * 60.0f / PI2; }
+    float amps() const { return current; }
+    double revolutions() const { return angle / PI2; }
+
+    // Çift kanallı enkoderin saydığı kenarlar (sıfıra doğru değil aşağı yuvarlanır)
+    int32_t counts() const { return (int32_t)floor(angle / PI2 * params.countsPerRev); }
+
+    // Sabit duty'de yüksüz kararlı hız (rad/s): kt*i = b*w + coulomb
+    float steadySpeed(float duty) const {
+        float drive = params.kt * duty * params.supplyV / params.resistance;
+        if (drive <= params.stiction) return 0;
+        return (drive - params.coulomb) / (params.viscous + params.kt * params.kt / params.resistance);
+    }
+};
+
+#endif
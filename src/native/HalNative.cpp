@@ -0,0 +1,295 @@
+#include "Hal.h"
+#include "NativeHal.h"
+#include "MotorController.h"
+#include <chrono>
+#include <random>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+static bool logEnabled = true;
+static uint16_t analogValue = 0;     // A0; simülatör ayarlar (0: batarya yok)
+
+static uint64_t elapsedNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - bootTime).count();
+}
+
+namespace hal {
+
+uint32_t millis() {
+    return (uint32_t)(elapsedNs() / 1000000ULL);
+}
+
+uint32_t micros() {
+    return (uint32_t)(elapsedNs() / 1000ULL);
+}
+
+uint32_t cycleCount() {
+    // Host'ta bir "cycle" = 1 ns
+    return (uint32_t)elapsedNs();
+}
+
+uint32_t cyclesPerMicro() {
+    return 1000;
+}
+
+void logf(const char* fmt, ...) {
+    if (!logEnabled) return;
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+}
+
+void logWrite(const char* data, size_t length) {
+    if (!logEnabled) return;
+    fwrite(data, 1, length, stderr);
+}
+
+size_t logWritable() {
+    return 4096;
+}
+
+HeapInfo heap() {
+    // Host tahsisçisi cihazınkiyle karşılaştırılamaz
+    HeapInfo info = { 0, 0, 0 };
+    return info;
+}
+
+GpioPort& gpio() {
+    return native::gpioPort();
+}
+
+SerialPort& softSerial(uint8_t rxPin, uint8_t txPin, uint32_t baud) {
+    (void)rxPin; (void)txPin; (void)baud;
+    return native::dfPlayer();
+}
+
+BlockFile* blockFile(const char* path, size_t blockSize, uint16_t blockCount) {
+    (void)path;
+    native::MemoryBlockFile& file = native::memoryBlockFile();
+    file.resize(blockSize, blockCount);
+    return &file;
+}
+
+BlockFile* configSector(size_t size) {
+    native::MemoryBlockFile& file = native::configMemory();
+    file.resize(size, 1);
+    return &file;
+}
+
+uint16_t analogRead() {
+    return analogValue;
+}
+
+uint32_t random32() {
+    static std::random_device device;
+    return device();
+}
+
+Encoder* encoder(uint8_t index, int8_t pinA, int8_t pinB) {
+    // Host'ta pin kesmesi yok; simülatör native::PlantEncoder'ı bağlar
+    (void)index; (void)pinA; (void)pinB;
+    return nullptr;
+}
+
+// Gerçek UDP soketi: simülatör, tools/udp_client için yerel karşı uç olur
+class PosixDatagramSocket : public DatagramSocket {
+private:
+    int fd = -1;
+
+public:
+    bool begin(uint16_t port) {
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0) return false;
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons(port);
+        if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+            close(fd);
+            fd = -1;
+            return false;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        return true;
+    }
+
+    int receive(uint8_t* buf, size_t size, Endpoint& from) override {
+        sockaddr_in addr = {};
+        socklen_t addrLength = sizeof(addr);
+        // MSG_TRUNC: sığmayan datagramın gerçek boyu döner
+        ssize_t n = recvfrom(fd, buf, size, MSG_TRUNC, (sockaddr*)&addr, &addrLength);
+        if (n <= 0) return 0;
+        from.address = addr.sin_addr.s_addr;
+        from.port = ntohs(addr.sin_port);
+        return (size_t)n > size ? -1 : (int)n;
+    }
+
+    bool send(const Endpoint& to, const uint8_t* data, size_t length) override {
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = to.address;
+        addr.sin_port = htons(to.port);
+        return sendto(fd, data, length, 0, (sockaddr*)&addr, sizeof(addr)) == (ssize_t)length;
+    }
+};
+
+DatagramSocket* udpSocket(uint16_t port) {
+    static PosixDatagramSocket* instance = nullptr;
+    if (instance) return instance;
+
+    PosixDatagramSocket* socket = new PosixDatagramSocket();
+    if (!socket->begin(port)) {
+        delete socket;
+        return nullptr;
+    }
+    instance = socket;
+    return instance;
+}
+
+}
+
+void native::MemoryBlockFile::resize(size_t size, uint16_t count) {
+    if (data.size() == size * count) return;
+    blockSize = size;
+    blocks = count;
+    data.assign(size * count, 0xFF);
+}
+
+bool native::MemoryBlockFile::read(uint16_t index, uint8_t* out, size_t length) {
+    if (index >= blocks || length > blockSize) return false;
+    memcpy(out, &data[(size_t)index * blockSize], length);
+    return true;
+}
+
+bool native::MemoryBlockFile::write(uint16_t index, const uint8_t* in, size_t length) {
+    if (index >= blocks || length > blockSize) return false;
+    memcpy(&data[(size_t)index * blockSize], in, length);
+    writes++;
+    return true;
+}
+
+native::PlantEncoder::PlantEncoder(NativeGpioPort& port, uint8_t pwm, uint8_t in1, uint8_t in2,
+                                   const DcMotorParams& params)
+    : gpio(port), pwmPin(pwm), in1Pin(in1), in2Pin(in2), plant(params) {}
+
+void native::PlantEncoder::advance(uint32_t nowUs) {
+    if (!started) {
+        started = true;
+        lastUs = nowUs;
+        return;
+    }
+    float dt = (nowUs - lastUs) * 1e-6f;
+    lastUs = nowUs;
+
+    // TB6612: IN1/IN2 = 1/0 ileri, 0/1 geri, 0/0 boşta, 1/1 kısa devre freni
+    bool in1 = gpio.level[in1Pin];
+    bool in2 = gpio.level[in2Pin];
+    float duty = in1 != in2 ? gpio.duty[pwmPin] / (float)MotorController::PWM_MAX : 0;
+    plant.step(in2 && !in1 ? -duty : duty, !in1 && !in2, dt);
+}
+
+void NativeGpioPort::configureOutput(uint8_t pin) {
+    (void)pin;
+}
+
+void NativeGpioPort::writeMasks(uint32_t setMask, uint32_t clearMask) {
+    for (uint8_t pin = 0; pin < 16; pin++) {
+        if (setMask & (1UL << pin)) level[pin] = true;
+        if (clearMask & (1UL << pin)) level[pin] = false;
+    }
+    registerWrites++;
+    lastWriteCycles = hal::cycleCount();
+}
+
+void NativeGpioPort::writeGpio16(bool high) {
+    level[16] = high;
+    registerWrites++;
+    lastWriteCycles = hal::cycleCount();
+}
+
+void NativeGpioPort::writePwm(uint8_t pin, uint16_t value) {
+    if (pin < PIN_COUNT) duty[pin] = value;
+    pwmWrites++;
+    lastWriteCycles = hal::cycleCount();
+}
+
+int NativeDFPlayer::read() {
+    if (rxHead == rxTail) return -1;
+    uint8_t value = rx[rxHead];
+    rxHead = (rxHead + 1) & (RX_SIZE - 1);
+    return value;
+}
+
+size_t NativeDFPlayer::write(uint8_t value) {
+    uint32_t start = hal::micros();
+    while (hal::micros() - start < byteTimeUs) {}
+    bytesWritten++;
+
+    DFPlayerProtocol::Packet packet;
+    if (!parser.push(value, packet)) return 1;
+    packets++;
+    if (!online) return 1;
+
+    if (packet.command == DFPlayerProtocol::CMD_RESET) {
+        reply(DFPlayerProtocol::EVT_ONLINE, 0x02);  // SD kart
+    } else if (packet.command == DFPlayerProtocol::CMD_PLAY_TRACK) {
+        lastTrack = packet.param;
+    }
+    if (packet.feedback) {
+        reply(DFPlayerProtocol::EVT_ACK, 0);
+    }
+    return 1;
+}
+
+void NativeDFPlayer::reply(uint8_t command, uint16_t param) {
+    DFPlayerProtocol::Packet packet = { command, 0, param };
+    uint8_t buf[DFPlayerProtocol::PACKET_SIZE];
+    DFPlayerProtocol::encode(packet, buf);
+    for (uint8_t i = 0; i < sizeof(buf); i++) {
+        rx[rxTail] = buf[i];
+        rxTail = (rxTail + 1) & (RX_SIZE - 1);
+    }
+}
+
+namespace native {
+
+NativeGpioPort& gpioPort() {
+    static NativeGpioPort port;
+    return port;
+}
+
+NativeDFPlayer& dfPlayer() {
+    static NativeDFPlayer player;
+    return player;
+}
+
+MemoryBlockFile& memoryBlockFile() {
+    static MemoryBlockFile file;
+    return file;
+}
+
+MemoryBlockFile& configMemory() {
+    static MemoryBlockFile file;
+    return file;
+}
+
+void setLogEnabled(bool enabled) {
+    logEnabled = enabled;
+}
+
+void setAnalog(uint16_t value) {
+    analogValue = value > 1023 ? 1023 : value;
+}
+
+}
@@ -0,0 +1,99 @@
+#ifndef NATIVE_HAL_H
+#define NATIVE_HAL_H
+
+#include "MotorDriver.h"
+#include "Hal.h"
+#include "DFPlayerProtocol.h"
+#include "DcMotorPlant.h"
+#include <vector>
+
+// Host tarafı simüle GPIO: pin seviyeleri, PWM değerleri ve yazım sayaçları
+class NativeGpioPort : public GpioPort {
+public:
+    static const uint8_t PIN_COUNT = 17;
+
+    bool level[PIN_COUNT] = {};
+    uint16_t duty[PIN_COUNT] = {};
+    uint32_t registerWrites = 0;
+    uint32_t pwmWrites = 0;
+    uint32_t lastWriteCycles = 0;   // hal::cycleCount() cinsinden
+
+    void configureOutput(uint8_t pin) override;
+    void writeMasks(uint32_t setMask, uint32_t clearMask) override;
+    void writeGpio16(bool high) override;
+    void writePwm(uint8_t pin, uint16_t duty) override;
+};
+
+// Simüle DFPlayer: gelen paketlere modül gibi yanıt verir (reset ->
+// EVT_ONLINE, geri bildirim isteyen komut -> EVT_ACK). write() cihazdaki
+// SoftwareSerial gibi bir baytın hat süresi boyunca meşgul bekler.
+class NativeDFPlayer : public hal::SerialPort {
+private:
+    static const uint8_t RX_SIZE = 64;  // 2'nin kuvveti
+
+    DFPlayerProtocol::Parser parser;
+    uint8_t rx[RX_SIZE];
+    uint8_t rxHead = 0;
+    uint8_t rxTail = 0;
+
+    void reply(uint8_t command, uint16_t param);
+
+public:
+    bool online = true;         // false: modül takılı değil, yanıt yok
+    uint32_t byteTimeUs = 1042; // 9600 baud, 8N1
+    uint32_t bytesWritten = 0;
+    uint32_t packets = 0;
+    uint16_t lastTrack = 0;
+
+    int read() override;
+    size_t write(uint8_t value) override;
+};
+
+// Simülatörün HAL'a özel erişimleri
+namespace native {
+
+// Bellekte blok dosyası (LittleFS yerine); data dosyanın birebir görüntüsü
+class MemoryBlockFile : public hal::BlockFile {
+public:
+    std::vector<uint8_t> data;
+    size_t blockSize = 0;
+    uint16_t blocks = 0;
+    uint32_t writes = 0;
+
+    void resize(size_t size, uint16_t count);
+    uint16_t blockCount() const override { return blocks; }
+    bool read(uint16_t index, uint8_t* out, size_t length) override;
+    bool write(uint16_t index, const uint8_t* in, size_t length) override;
+};
+
+// Sürücü pinlerinden (PWM + IN1/IN2) beslenen motor modeli ve enkoderi.
+// advance() her tick'ten önce çağrılır: PWM yalnızca tick'te değiştiğinden
+// model geçen aralığı o aralıkta geçerli çıkışla ilerletir.
+class PlantEncoder : public hal::Encoder {
+private:
+    NativeGpioPort& gpio;
+    uint8_t pwmPin;
+    uint8_t in1Pin;
+    uint8_t in2Pin;
+    uint32_t lastUs = 0;
+    bool started = false;
+
+public:
+    DcMotorPlant plant;
+
+    PlantEncoder(NativeGpioPort& port, uint8_t pwm, uint8_t in1, uint8_t in2,
+                 const DcMotorParams& params = DcMotorParams::n20());
+    void advance(uint32_t nowUs);
+    int32_t count() override { return plant.counts(); }
+    void setDirection(int8_t sign) override { (void)sign; }   // Çift kanal
+};
+
+NativeGpioPort& gpioPort();
+NativeDFPlayer& dfPlayer();
+MemoryBlockFile& memoryBlockFile();
+MemoryBlockFile& configMemory();    // hal::configSector() (EEPROM yerine)
+void setLogEnabled(bool enabled);   // Ölçüm sırasında konsolu sustur
+void setAnalog(uint16_t value);     // hal::analogRead() (A0) değeri
+}
+
+#endif
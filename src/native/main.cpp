@@ -0,0 +1,704 @@
+// Native (Linux) simülatör - [env:native]
+//
+// Cihazdaki komut yolunun tamamını host'ta tam hızda çalıştırır:
+// WebSocket çerçevesi -> CommandProcessor -> MotorController tick -> GPIO.
+// Her çerçeve için alım anından pin yazımına kadar geçen süre ve toplam
+// işlem hızı (çerçeve/s) raporlanır. Senaryoların beklentileri (uygulanan
+// çerçeve, bekçi süresi, kayıt/oynatma, parametre yükleme ...) sonda
+// denetlenir; karşılanmayan varsa çıkış kodu 1'dir. Birim düzeyindeki
+// testler test/ altında (pio test -e native).
+//
+//   pio run -e native && .pio/build/native/program [çerçeve_sayısı]
+
+// pio test src/'yi de derler: testlerin kendi main()'i var
+#ifndef PIO_UNIT_TESTING
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+#include "Hal.h"
+#include "NativeHal.h"
+#include "MotorController.h"
+#include "AudioManager.h"
+#include "CommandProcessor.h"
+#include "DriveProtocol.h"
+#include "Log.h"
+#include "Scheduler.h"
+#include "DriveRecorder.h"
+#include "ControlTimer.h"
+#include "UdpControl.h"
+#include "SpeedController.h"
+#include "BatteryMonitor.h"
+#include "ParamStore.h"
+#include <math.h>
+#include <unistd.h>
+
+// main.cpp ile aynı pinler
+static const uint8_t PWMA = 5, AIN1 = 4, AIN2 = 0;
+static const uint8_t PWMB = 13, BIN1 = 16, BIN2 = 15;
+static const uint8_t STBY = 2;
+
+class NativeTransport : public hal::Transport {
+public:
+    uint32_t textFrames = 0;
+    uint32_t binaryFrames = 0;
+    uint32_t bytes = 0;
+    char lastText[160] = "";
+    UdpControl* udp = nullptr;      // CLIENT_ID yanıtları (UDP karşı uç kipi)
+
+    bool sendText(uint8_t client, const char* data, size_t length) override {
+        (void)client;
+        textFrames++;
+        bytes += length;
+        size_t n = length < sizeof(lastText) - 1 ? length : sizeof(lastText) - 1;
+        memcpy(lastText, data, n);
+        lastText[n] = '\0';
+        return true;
+    }
+
+    bool sendBinary(uint8_t client, const uint8_t* data, size_t length) override {
+        if (client == UdpControl::CLIENT_ID) {
+            return udp && udp->sendBinary(data, length);
+        }
+        binaryFrames++;
+        bytes += length;
+        return true;
+    }
+};
+
+// Zamanlayıcı senaryosu: görevler yakalamasız lambda, nesneler buradan
+static MotorController* simMotor;
+static AudioManager* simAudio;
+static CommandProcessor* simProcessor;
+static uint16_t simSeq;
+static uint32_t simLastFrameMs;
+
+// Karşılanmayan beklentiler (raporun sonunda yazılır, çıkış kodu 1)
+static uint32_t failures = 0;
+
+static void expect(bool ok, const char* what) {
+    if (ok) return;
+    failures++;
+    printf("BEKLENTİ KARŞILANMADI: %s\n", what);
+}
+
+struct Report {
+    std::vector<uint32_t> latencies;   // ns
+    uint32_t elapsedUs = 0;
+};
+
+static void print(const char* name, Report& r) {
+    if (r.latencies.empty()) return;
+    std::sort(r.latencies.begin(), r.latencies.end());
+    size_t n = r.latencies.size();
+    uint64_t sum = 0;
+    for (uint32_t v : r.latencies) sum += v;
+
+    printf("%-14s çerçeve=%zu  ort=%llu ns  p50=%u ns  p99=%u ns  max=%u ns  hız=%.0f çerçeve/s\n",
+           name, n, (unsigned long long)(sum / n),
+           r.latencies[n / 2], r.latencies[(n * 99) / 100], r.latencies[n - 1],
+           r.elapsedUs ? n * 1e6 / r.elapsedUs : 0.0);
+}
+
+// Bir çerçeveyi işle, tick'i çalıştır ve pin yazımına kadar geçen süreyi kaydet
+template <typename Handler>
+static void runFrame(MotorController& motor, NativeGpioPort& gpio, Report& report, Handler handle) {
+    uint32_t received = hal::cycleCount();
+    handle();
+    motor.tick();
+    if ((int32_t)(gpio.lastWriteCycles - received) >= 0) {
+        report.latencies.push_back(gpio.lastWriteCycles - received);
+    }
+}
+
+// Düz sürüş, motor modeline karşı: sağ motor %5 zayıf ve %8 sürtünmeli.
+// setTarget(150, 150) (telafiyle 212 PWM) 1,5 s, sonra durdurma;
+// tekerlerin kat ettiği yol farkından yön sapması (derece; 65 mm teker,
+// 130 mm iz). closed: enkoderler bağlı.
+static float runStraightDrive(bool closed, char* wheels, size_t size) {
+    NativeGpioPort& gpio = native::gpioPort();
+    DcMotorParams weak = DcMotorParams::n20();
+    weak.kt *= 0.95f;
+    weak.coulomb *= 1.08f;
+    weak.stiction *= 1.08f;
+    native::PlantEncoder left(gpio, PWMA, AIN1, AIN2);
+    native::PlantEncoder right(gpio, PWMB, BIN1, BIN2, weak);
+
+    MotorController motor(gpio, PWMA, AIN1, AIN2, PWMB, BIN1, BIN2, STBY);
+    motor.begin();
+    if (closed) {
+        SpeedConfig speed = { 420, 1500, 300, 4800, MotorController::SPEED_HZ };
+        motor.setEncoders(&left, &right, speed);
+    }
+    motor.setTarget(150, 150);
+
+    ControlTimer timer(MotorController::CONTROL_PERIOD_US);
+    uint32_t from = hal::millis();
+    bool stopped = false;
+    while (hal::millis() - from < 2000) {
+        uint32_t now = hal::micros();
+        if (!timer.poll(now)) continue;
+        left.advance(now);
+        right.advance(now);
+        if (!stopped && hal::millis() - from >= 1500) {
+            motor.writeWheelsJson(wheels, size);
+            motor.setTarget(0, 0);
+            stopped = true;
+        }
+        motor.feedWatchdog();
+        motor.tick();
+    }
+    motor.stop();
+
+    const float circumference = 2 * 3.14159265f * 0.0325f;
+    float diff = (float)(right.plant.revolutions() - left.plant.revolutions()) * circumference;
+    return diff / 0.13f * 180.0f / 3.14159265f;
+}
+
+// Batarya: açık devre gerilimi openCircuitV, iç direnç ohms; motorlar
+// çektikleri akımla çöken gerilimle sürülür, A0 aynı gerilimi okur (10 V
+// tam ölçek). setTarget(150, 150) 1,5 s; son 0,5 s'nin ortalama sol teker rpm'i,
+// minVolts: kalkış sonrası (ilk 200 ms hariç) en düşük gerilim.
+// monitor: BatteryMonitor telafi + çöküş tavanı devrede.
+static float runBatteryDrive(float openCircuitV, float ohms, bool monitor, float& minVolts,
+                             char* json, size_t size) {
+    NativeGpioPort& gpio = native::gpioPort();
+    native::PlantEncoder left(gpio, PWMA, AIN1, AIN2);
+    native::PlantEncoder right(gpio, PWMB, BIN1, BIN2);
+    MotorController motor(gpio, PWMA, AIN1, AIN2, PWMB, BIN1, BIN2, STBY);
+    motor.begin();
+
+    BatteryConfig config = { 10000, 7400, 6800, 6000, 3000 };
+    BatteryMonitor battery(config);
+    native::setAnalog((uint16_t)lroundf(openCircuitV * 102.3f));
+    battery.poll(hal::millis());
+    if (monitor) motor.setBattery(&battery);
+    motor.setTarget(150, 150);
+
+    ControlTimer timer(MotorController::CONTROL_PERIOD_US);
+    uint32_t from = hal::millis();
+    uint32_t ticks = 0;
+    float rpmSum = 0;
+    uint32_t rpmCount = 0;
+    minVolts = openCircuitV;
+    while (hal::millis() - from < 1500) {
+        uint32_t now = hal::micros();
+        if (!timer.poll(now)) continue;
+        float volts = openCircuitV - ohms * (fabsf(left.plant.amps()) + fabsf(right.plant.amps()));
+        if (volts < minVolts && hal::millis() - from >= 200) minVolts = volts;
+        left.plant.setSupply(volts);
+        right.plant.setSupply(volts);
+        native::setAnalog((uint16_t)lroundf(volts * 102.3f));
+        left.advance(now);
+        right.advance(now);
+        if (++ticks % 4 == 0) battery.poll(hal::millis());     // "battery" görevi, 20 ms
+        motor.feedWatchdog();
+        motor.tick();
+        if (hal::millis() - from >= 1000) {
+            rpmSum += left.plant.rpm();
+            rpmCount++;
+        }
+    }
+    motor.stop();
+    native::setAnalog(0);
+    battery.writeJson(json, size);
+    return rpmCount ? rpmSum / rpmCount : 0;
+}
+
+// Canlı parametre: düzenleme WebSocket komutlarıyla (CommandProcessor),
+// yarım gazla (joystick birimi, ölü bölge telafili) sürerken min_pwm
+// değişir ve yayınlanır. Kayıt motorlar durunca bellekteki sektöre
+// yazılır; ikinci depo aynı sektörden yükler, tek bayt bozulunca CRC
+// kaydı reddeder.
+struct ParamsRun {
+    uint16_t dutyBefore;
+    uint16_t dutyAfter;
+    uint32_t ticksToApply;      // apply -> PWM değişimi
+    bool savedWhileDriving;
+    ParamStore::Source reloaded;
+    uint8_t reloadedMinPwm;
+    uint32_t reloadUs;
+    ParamStore::Source corrupted;
+    char event[384];
+};
+
+static void runLiveParams(ParamsRun& run) {
+    NativeGpioPort& gpio = native::gpioPort();
+    native::MemoryBlockFile& sector = native::configMemory();
+    ParamStore store;
+    store.begin(hal::configSector(ParamStore::RECORD_SIZE));
+
+    MotorController motor(gpio, PWMA, AIN1, AIN2, PWMB, BIN1, BIN2, STBY);
+    motor.begin();
+    motor.setParams(&store);
+    NativeTransport transport;
+    CommandProcessor processor(&motor, nullptr, &transport);
+    processor.setParams(&store);
+    auto send = [&](const char* text) {
+        char buf[96];
+        size_t n = strlen(text);
+        memcpy(buf, text, n);
+        processor.handleText(0, (uint8_t*)buf, n, hal::cycleCount());
+    };
+    auto tick = [&]() {
+        motor.feedWatchdog();
+        motor.tick();
+    };
+
+    // Rampa pinleri hemen taşısın
+    send("{\"cmd\":\"param\",\"name\":\"accel\",\"value\":5000}");
+    send("{\"cmd\":\"param\",\"name\":\"decel\",\"value\":5000}");
+    send("{\"cmd\":\"params\",\"action\":\"apply\"}");
+    send("{\"cmd\":\"custom\",\"left\":500,\"right\":500}");
+    for (int i = 0; i < 200; i++) tick();
+    run.dutyBefore = gpio.duty[PWMA];
+
+    send("{\"cmd\":\"param\",\"name\":\"min_pwm\",\"value\":170}");
+    send("{\"cmd\":\"param\",\"name\":\"min_pwm\",\"value\":999}");    // Reddedilir
+    send("{\"cmd\":\"params\",\"action\":\"save\"}");
+    run.ticksToApply = 0;
+    while (gpio.duty[PWMA] == run.dutyBefore && run.ticksToApply < 100) {
+        tick();
+        run.ticksToApply++;
+    }
+    run.dutyAfter = gpio.duty[PWMA];
+
+    // Sürerken yazılmaz; durunca ilk poll'da yazılır
+    uint32_t writes = sector.writes;
+    store.poll(motor.isIdle());
+    run.savedWhileDriving = sector.writes != writes;
+    motor.setTarget(0, 0);
+    for (int i = 0; i < 200; i++) tick();
+    store.poll(motor.isIdle());
+    store.writeEvent(run.event, sizeof(run.event));
+
+    ParamStore reload;
+    reload.begin(hal::configSector(ParamStore::RECORD_SIZE));
+    run.reloaded = reload.getSource();
+    run.reloadedMinPwm = reload.getShadow().minPwm;
+    run.reloadUs = reload.getLoadUs();
+
+    sector.data[ParamStore::HEADER_SIZE + 1] ^= 0x10;
+    ParamStore corrupt;
+    corrupt.begin(hal::configSector(ParamStore::RECORD_SIZE));
+    run.corrupted = corrupt.getSource();
+    motor.stop();
+}
+
+// UDP kanalının yerel karşı ucu: gerçek soket, 200 Hz tick; cihaz
+// olmadan tools/udp_client.cpp ile kayıp/gecikme ölçümü için.
+// seconds == 0: Ctrl-C'ye kadar
+static int runUdpStandIn(uint16_t port, uint32_t seconds) {
+    MotorController motor(hal::gpio(), PWMA, AIN1, AIN2, PWMB, BIN1, BIN2, STBY);
+    motor.begin();
+    NativeTransport transport;
+    CommandProcessor processor(&motor, nullptr, &transport);
+    UdpControl udp(&processor, port);
+    transport.udp = &udp;
+    if (!udp.begin()) return 1;
+
+    uint32_t token = udp.openSession();
+    printf("UDP karşı uç: port %u, belirteç %u\n", (unsigned)port, (unsigned)token);
+    printf("  udp_client 127.0.0.1 --port %u --token %u\n", (unsigned)port, (unsigned)token);
+    fflush(stdout);
+
+    ControlTimer timer(MotorController::CONTROL_PERIOD_US);
+    uint32_t start = hal::millis();
+    uint32_t lastReport = start;
+    char stats[512];
+    while (seconds == 0 || hal::millis() - start < seconds * 1000) {
+        udp.poll();
+        processor.flush();
+        if (timer.poll(hal::micros())) {
+            motor.tick();
+        }
+        while (Log::drain(16)) {}
+        if (hal::millis() - lastReport >= 5000) {
+            lastReport = hal::millis();
+            size_t n = udp.writeJson(stats, sizeof(stats));
+            stats[n++] = ' ';
+            processor.getDriveInbox().writeJson(stats + n, sizeof(stats) - n);
+            printf("%s\n", stats);
+            fflush(stdout);
+        }
+        usleep(100);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--udp") == 0) {
+        return runUdpStandIn(argc > 2 ? (uint16_t)atoi(argv[2]) : 4210,
+                             argc > 3 ? (uint32_t)atoi(argv[3]) : 0);
+    }
+
+    long frames = argc > 1 ? atol(argv[1]) : 100000;
+
+    MotorController motor(hal::gpio(), PWMA, AIN1, AIN2, PWMB, BIN1, BIN2, STBY);
+    motor.begin();
+
+    AudioManager audio(14, 12);
+    audio.begin();
+
+    NativeTransport transport;
+    CommandProcessor processor(&motor, &audio, &transport);
+    processor.onConnect(0);
+
+    // Rampa her çerçevede pinleri hareket ettirsin diye anında tepki
+    RampConfig instant;
+    instant.accelPerSec = 60000;
+    instant.decelPerSec = 60000;
+    instant.jerkPerSec2 = 0;
+    motor.setRamp(instant);
+
+    NativeGpioPort& gpio = native::gpioPort();
+    native::setLogEnabled(false);
+
+    Report json;
+    uint32_t start = hal::micros();
+    for (long i = 0; i < frames; i++) {
+        char buf[64];
+        int value = (i & 1) ? 200 : -200;
+        int n = snprintf(buf, sizeof(buf), "{\"cmd\":\"custom\",\"left\":%d,\"right\":%d}", value, -value);
+        runFrame(motor, gpio, json, [&]() {
+            processor.handleText(0, (uint8_t*)buf, (size_t)n, hal::cycleCount());
+        });
+    }
+    json.elapsedUs = hal::micros() - start;
+
+    Report binary;
+    start = hal::micros();
+    for (long i = 0; i < frames; i++) {
+        DriveProtocol::Frame frame;
+        frame.opcode = DriveProtocol::OP_DRIVE;
+        frame.flags = 0;
+        frame.seq = (uint16_t)i;
+        frame.left = (int16_t)((i & 1) ? 200 : -200);
+        frame.right = (int16_t)-frame.left;
+        frame.stamp = hal::millis();
+        uint8_t buf[DriveProtocol::FRAME_SIZE];
+        DriveProtocol::encode(frame, buf);
+        runFrame(motor, gpio, binary, [&]() {
+            processor.handleBinary(0, buf, sizeof(buf), hal::cycleCount());
+            processor.flush();
+        });
+    }
+    binary.elapsedUs = hal::micros() - start;
+
+    // WiFi takılması: 20'lik patlamalar tek geçişte gelir, en yenisi uygulanır.
+    // Her patlamanın ilk çerçevesi 600 ms önce damgalanmış (bayat), bir çerçeve
+    // de sırası bozuk olarak tekrar gönderilir.
+    uint16_t seq = (uint16_t)frames;
+    uint32_t burstApplied = 0;
+    for (int burst = 0; burst < 100; burst++) {
+        uint32_t now = hal::millis();
+        for (int k = 0; k < 20; k++) {
+            DriveProtocol::Frame frame;
+            frame.opcode = DriveProtocol::OP_DRIVE;
+            frame.flags = 0;
+            frame.seq = (k == 10) ? (uint16_t)(seq - 3) : ++seq;
+            frame.left = (int16_t)(k * 10);
+            frame.right = (int16_t)-(k * 10);
+            frame.stamp = (k == 0) ? now - 600 : now;
+            uint8_t buf[DriveProtocol::FRAME_SIZE];
+            DriveProtocol::encode(frame, buf);
+            processor.handleBinary(0, buf, sizeof(buf), hal::cycleCount());
+        }
+        uint32_t before = processor.getDriveInbox().getApplied();
+        processor.flush();
+        motor.tick();
+        burstApplied += processor.getDriveInbox().getApplied() - before;
+    }
+
+    // Ölü adam bekçisi: ileri komutundan sonra bağlantı susar. Ölçülen
+    // RTT 10 ms -> timeout = 40 + 2*10 = 60 ms; araç decel rampasıyla durur.
+    RampConfig ramp;
+    ramp.accelPerSec = 60000;
+    ramp.decelPerSec = 1020;
+    ramp.jerkPerSec2 = 0;
+    motor.setRamp(ramp);
+    WatchdogConfig wd;
+    wd.minTimeoutMs = 40;
+    wd.maxTimeoutMs = 500;
+    wd.rttMultiplier = 2;
+    motor.getWatchdog().configure(wd);
+    processor.onPong(0, 10);
+
+    {
+        DriveProtocol::Frame frame;
+        frame.opcode = DriveProtocol::OP_DRIVE;
+        frame.flags = 0;
+        frame.seq = ++seq;
+        frame.left = 1000;      // Tam ölçek (PWM_MAX)
+        frame.right = 1000;
+        frame.stamp = hal::millis();
+        uint8_t buf[DriveProtocol::FRAME_SIZE];
+        DriveProtocol::encode(frame, buf);
+        processor.handleBinary(0, buf, sizeof(buf), hal::cycleCount());
+        processor.flush();
+    }
+
+    uint32_t silentFrom = hal::millis();
+    uint32_t tripAt = 0, stoppedAt = 0;
+    uint32_t nextTick = hal::micros();
+    while (hal::millis() - silentFrom < 500 && !stoppedAt) {
+        if ((int32_t)(hal::micros() - nextTick) < 0) continue;
+        nextTick += MotorController::CONTROL_PERIOD_US;
+        motor.tick();
+        if (!tripAt && motor.getWatchdog().hasFault()) tripAt = hal::millis();
+        if (tripAt && gpio.duty[PWMA] == 0) stoppedAt = hal::millis();
+    }
+
+    // DFPlayer: açılış (reset -> EVT_ONLINE) ve üç korna basışı kuyruktan
+    // bayt bayt boşalır; sürüş yolu hiç beklemez
+    uint32_t audioFrom = hal::millis();
+    while (!audio.isReady() && hal::millis() - audioFrom < 1000) {
+        audio.loop(hal::micros());
+    }
+    uint32_t audioReadyMs = hal::millis() - audioFrom;
+    for (int i = 0; i < 3; i++) {
+        char buf[] = "{\"cmd\":\"sound\",\"action\":\"horn\"}";
+        processor.handleText(0, (uint8_t*)buf, sizeof(buf) - 1, hal::cycleCount());
+    }
+    audioFrom = hal::millis();
+    while (native::dfPlayer().packets < 6 && hal::millis() - audioFrom < 1000) {
+        audio.loop(hal::micros());
+    }
+    uint32_t audioDrainMs = hal::millis() - audioFrom;
+    audio.loop(hal::micros());  // Son ACK'ler
+
+    // main.cpp'deki görev düzeni, 1,5 sn: 50 Hz sürüş çerçevesi (web görevi
+    // gelen kutusuna koyup boşaltır), 200 Hz motor tick'i, ses ve log
+    simMotor = &motor;
+    simAudio = &audio;
+    simProcessor = &processor;
+    simSeq = seq;
+    Scheduler scheduler;
+    scheduler.add("motor", [](uint32_t) { simMotor->tick(); },
+                  MotorController::CONTROL_PERIOD_US, 5, 500);
+    scheduler.add("web", [](uint32_t) {
+        uint32_t now = hal::millis();
+        if (now - simLastFrameMs >= 20) {
+            simLastFrameMs = now;
+            DriveProtocol::Frame frame = {};
+            frame.opcode = DriveProtocol::OP_MIX;
+            frame.seq = ++simSeq;
+            frame.left = (int16_t)((now / 20) % 2 ? 600 : -600);
+            frame.right = 200;
+            frame.stamp = now;
+            uint8_t buf[DriveProtocol::FRAME_SIZE];
+            DriveProtocol::encode(frame, buf);
+            simProcessor->handleBinary(0, buf, sizeof(buf), hal::cycleCount());
+        }
+        simProcessor->flush();
+    }, 0, 4, 2000);
+    scheduler.add("audio", [](uint32_t now) { simAudio->loop(now); }, 1000, 3, 1500);
+    scheduler.add("log", [](uint32_t) { Log::drain(); }, 0, 0, 1000);
+    uint32_t schedFrom = hal::millis();
+    while (hal::millis() - schedFrom < 1500) {
+        scheduler.runPass(hal::micros());
+    }
+
+    // Sürüş kaydı: 400 karışık çerçeve (5 ms arayla) kaydedilir, sonra
+    // bellekteki blok dosyasından 8x hızla oynatılır
+    DriveRecorder recorder(&motor);
+    recorder.begin();
+    motor.setRecorder(&recorder);
+    recorder.requestStart();
+    recorder.poll(hal::millis());
+    for (int i = 0; i < 400; i++) {
+        uint32_t from = hal::micros();
+        DriveProtocol::Frame frame = {};
+        frame.opcode = DriveProtocol::OP_MIX;
+        frame.seq = ++simSeq;
+        frame.left = (int16_t)((i % 50) * 20 - 500);
+        frame.right = (int16_t)((i / 50) * 100 - 400);
+        frame.stamp = hal::millis();
+        uint8_t buf[DriveProtocol::FRAME_SIZE];
+        DriveProtocol::encode(frame, buf);
+        processor.handleBinary(0, buf, sizeof(buf), hal::cycleCount());
+        processor.flush();
+        while (hal::micros() - from < 5000) {
+            recorder.poll(hal::millis());
+        }
+    }
+    motor.stop();
+    recorder.requestStop();
+    uint32_t recordMs = hal::millis();
+    recorder.poll(hal::millis());
+    while (recorder.getState() != DriveRecorder::IDLE || hal::millis() - recordMs < 5) {
+        recorder.poll(hal::millis());
+    }
+    recorder.requestReplay(8);
+    uint32_t replayFrom = hal::millis();
+    do {
+        recorder.poll(hal::millis());
+    } while (recorder.getState() != DriveRecorder::IDLE && hal::millis() - replayFrom < 2000);
+    uint32_t replayMs = hal::millis() - replayFrom;
+    motor.setRecorder(nullptr);
+
+    // Manevra: iki yönlü eğrilik yayı (sekiz), 1 tekrar, 200 Hz tick'le
+    // cihazda yürütülür; ikinci yükleme elle bir çerçeveyle kesilir
+    static const int16_t EIGHT[][4] = {
+        { ManeuverRunner::CURVATURE, 600, 700, 1200 },
+        { ManeuverRunner::CURVATURE, 600, -700, 1200 },
+        { ManeuverRunner::WHEELS, 0, 0, 100 },
+    };
+    uint8_t upload[DriveProtocol::MANEUVER_HEADER_SIZE + 3 * DriveProtocol::MANEUVER_SEGMENT_SIZE] = {
+        DriveProtocol::OP_MANEUVER, 0, 1, 0, 3, 1
+    };
+    for (uint8_t i = 0; i < 3; i++) {
+        uint8_t* p = upload + DriveProtocol::MANEUVER_HEADER_SIZE + i * DriveProtocol::MANEUVER_SEGMENT_SIZE;
+        p[0] = (uint8_t)EIGHT[i][0];
+        DriveProtocol::writeU16(p + 1, (uint16_t)EIGHT[i][1]);
+        DriveProtocol::writeU16(p + 3, (uint16_t)EIGHT[i][2]);
+        DriveProtocol::writeU16(p + 5, (uint16_t)EIGHT[i][3]);
+    }
+    uint32_t eventsBefore = transport.textFrames;
+    processor.handleBinary(0, upload, sizeof(upload), hal::cycleCount());
+    uint32_t maneuverFrom = hal::millis();
+    ControlTimer maneuverTimer(MotorController::CONTROL_PERIOD_US);
+    do {
+        if (maneuverTimer.poll(hal::micros())) {
+            motor.tick();
+            processor.flush();
+        }
+    } while (motor.getManeuver().isRunning() || hal::millis() - maneuverFrom < 10);
+    uint32_t maneuverMs = hal::millis() - maneuverFrom;
+    ManeuverRunner::State maneuverState = motor.getManeuver().getState();
+    uint32_t maneuverEvents = transport.textFrames - eventsBefore;
+    char maneuverDone[160];
+    memcpy(maneuverDone, transport.lastText, sizeof(maneuverDone));
+
+    processor.handleBinary(0, upload, sizeof(upload), hal::cycleCount());
+    maneuverFrom = hal::millis();
+    bool manual = false;
+    while (hal::millis() - maneuverFrom < 500) {
+        if (maneuverTimer.poll(hal::micros())) {
+            if (!manual && hal::millis() - maneuverFrom >= 300) {
+                DriveProtocol::Frame frame = {};
+                frame.opcode = DriveProtocol::OP_DRIVE;
+                frame.seq = ++simSeq;
+                frame.left = frame.right = 300;
+                frame.stamp = hal::millis();
+                uint8_t buf[DriveProtocol::FRAME_SIZE];
+                DriveProtocol::encode(frame, buf);
+                processor.handleBinary(0, buf, sizeof(buf), hal::cycleCount());
+                manual = true;
+            }
+            motor.tick();
+            processor.flush();
+        }
+    }
+
+    processor.onDisconnect(0);
+    
+    // Kapalı çevrim hız kontrolü: aynı sürüş enkodersiz ve enkoderli
+    char openWheels[200], closedWheels[200];
+    float openDrift = runStraightDrive(false, openWheels, sizeof(openWheels));
+    float closedDrift = runStraightDrive(true, closedWheels, sizeof(closedWheels));
+    
+    // Batarya (iç direnç 0,3 ohm): dolu 7,4 V ve boşalmış 6,7 V, izleme
+    // kapalı/açık; yıpranmış paket (1,2 ohm) kalkışta çöker, tavan devreye girer
+    char batteryJson[240], guardJson[240], scratch[240];
+    float sag, sagRaw, sagGuard;
+    float rpmFull = runBatteryDrive(7.4f, 0.3f, false, sag, scratch, sizeof(scratch));
+    float rpmDrained = runBatteryDrive(6.7f, 0.3f, false, sag, scratch, sizeof(scratch));
+    float rpmFullMon = runBatteryDrive(7.4f, 0.3f, true, sag, scratch, sizeof(scratch));
+    float rpmDrainedMon = runBatteryDrive(6.7f, 0.3f, true, sag, batteryJson, sizeof(batteryJson));
+    runBatteryDrive(7.0f, 1.2f, false, sagRaw, scratch, sizeof(scratch));
+    runBatteryDrive(7.0f, 1.2f, true, sagGuard, guardJson, sizeof(guardJson));
+    ParamsRun paramsRun;
+    runLiveParams(paramsRun);
+    native::setLogEnabled(true);
+    while (Log::drain(16)) {}
+
+    printf("Komut yolu: çerçeve -> CommandProcessor -> tick -> GPIO\n");
+    print("JSON", json);
+    print("Binary", binary);
+    char stats[800];
+    processor.getLatencyStats().writeJson(stats, sizeof(stats));
+    printf("LatencyStats (µs): %s\n", stats);
+    processor.getDriveInbox().writeJson(stats, sizeof(stats));
+    printf("DriveInbox: %s (patlama başına uygulanan: %.2f)\n", stats, burstApplied / 100.0);
+    printf("Bekçi: timeout=%u ms, tetiklenme=%u ms, duruş=%u ms (sessizlikten itibaren)\n",
+           motor.getWatchdog().timeoutMs(), tripAt - silentFrom, stoppedAt - silentFrom);
+    audio.writeJson(stats, sizeof(stats));
+    printf("DFPlayer: hazır=%u ms, 3 korna boşalması=%u ms; %s\n", audioReadyMs, audioDrainMs, stats);
+    recorder.writeJson(stats, sizeof(stats));
+    printf("Sürüş kaydı: 2 sn kayıt, 8x oynatma=%u ms, %u blok yazımı; %s\n", replayMs,
+           native::memoryBlockFile().writes, stats);
+    printf("Manevra: beklenen 5000 ms, süren %u ms, %u ilerleme olayı; son: %s\n",
+           maneuverMs, maneuverEvents, maneuverDone);
+    motor.getManeuver().writeSummary(stats, sizeof(stats));
+    printf("Manevra kesme: %s\n", stats);
+    printf("Düz sürüş (sağ motor zayıf, 1,5 s): açık çevrim sapma %.1f°, kapalı çevrim %.1f°\n",
+           openDrift, closedDrift);
+    printf("  açık: %s\n  kapalı: %s\n", openWheels, closedWheels);
+    printf("Batarya (150/150): 7,4 V -> 6,7 V izlemesiz %.0f -> %.0f rpm, telafili %.0f -> %.0f rpm\n  %s\n",
+           rpmFull, rpmDrained, rpmFullMon, rpmDrainedMon, batteryJson);
+    printf("Yıpranmış paket (1,2 ohm): kalkış sonrası en düşük %.2f V korumasız, %.2f V PWM tavanıyla\n  %s\n",
+           sagRaw, sagGuard, guardJson);
+    printf("Canlı parametre: min_pwm 150 -> 170, PWM %u -> %u (%u tick), sürerken kayıt %s; "
+           "yeniden yükleme %s min_pwm %u (%u µs), bozuk bayt: %s\n  %s\n",
+           paramsRun.dutyBefore, paramsRun.dutyAfter, (unsigned)paramsRun.ticksToApply,
+           paramsRun.savedWhileDriving ? "yazıldı" : "ertelendi",
+           ParamStore::sourceName(paramsRun.reloaded), paramsRun.reloadedMinPwm,
+           (unsigned)paramsRun.reloadUs, ParamStore::sourceName(paramsRun.corrupted), paramsRun.event);
+    char tasks[1536];
+    scheduler.writeJson(tasks, sizeof(tasks));
+    printf("Zamanlayıcı: %s\n", tasks);
+    printf("GPIO: register yazımı=%u, PWM yazımı=%u; yanıt: metin=%u, binary=%u\n",
+           gpio.registerWrites, gpio.pwmWrites, transport.textFrames, transport.binaryFrames);
+
+    // Süreler gerçek saatle ölçülür: sınırlar yüklü host'ta da tutacak kadar geniş
+    const DriveInbox& inbox = processor.getDriveInbox();
+    expect(json.latencies.size() == (size_t)frames, "her JSON çerçevesi pinlere ulaşmalı");
+    expect(binary.latencies.size() == (size_t)frames, "her ikili çerçeve pinlere ulaşmalı");
+    expect(burstApplied == 100, "patlama başına tek çerçeve uygulanmalı");
+    expect(inbox.getStale() >= 100, "600 ms bayat çerçeveler atılmalı");
+    expect(inbox.getReordered() >= 100, "sırası bozuk çerçeveler atılmalı");
+    expect(tripAt != 0 && stoppedAt != 0, "bekçi tetiklenmeli ve araç durmalı");
+    expect(tripAt - silentFrom >= motor.getWatchdog().timeoutMs() &&
+           tripAt - silentFrom <= motor.getWatchdog().timeoutMs() + 50,
+           "bekçi zaman aşımında tetiklenmeli");
+    expect(audio.isReady() && native::dfPlayer().packets >= 6, "DFPlayer hazır, 3 korna gönderilmiş olmalı");
+    expect(recorder.getState() == DriveRecorder::IDLE && replayMs < 1000, "8x oynatma bitmeli");
+    expect(maneuverState == ManeuverRunner::DONE, "manevra tamamlanmalı");
+    expect(maneuverMs >= 4990 && maneuverMs <= 5100, "manevra planlanan sürede bitmeli");
+    expect(manual && motor.getManeuver().getState() == ManeuverRunner::ABORTED,
+           "elle çerçeve manevrayı kesmeli");
+    expect(fabsf(closedDrift) < 5 && fabsf(closedDrift) < fabsf(openDrift) / 4,
+           "kapalı çevrim sapmayı gidermeli");
+    expect(rpmFullMon - rpmDrainedMon < (rpmFull - rpmDrained) / 4, "batarya telafisi hızı korumalı");
+    expect(sagGuard > sagRaw + 0.3f, "PWM tavanı çöküşü sınırlamalı");
+    expect(paramsRun.dutyAfter > paramsRun.dutyBefore && paramsRun.ticksToApply == 1,
+           "min_pwm sonraki tick'te geçerli olmalı");
+    expect(!paramsRun.savedWhileDriving, "kayıt sürerken ertelenmeli");
+    expect(paramsRun.reloaded == ParamStore::SOURCE_STORED && paramsRun.reloadedMinPwm == 170,
+           "kayıt yeniden yüklenmeli");
+    expect(paramsRun.corrupted == ParamStore::SOURCE_INVALID, "bozuk kayıt reddedilmeli");
+
+    // OTA başlangıcı: süren kayıt poll() beklenmeden yazılır, dosya kapanır
+    motor.setRecorder(&recorder);
+    recorder.requestStart();
+    recorder.poll(hal::millis());
+    motor.setTarget(100, 100);
+    uint32_t otaWrites = native::memoryBlockFile().writes;
+    recorder.end();
+    motor.setRecorder(nullptr);
+    motor.stop();
+    expect(recorder.getState() == DriveRecorder::UNAVAILABLE && native::memoryBlockFile().writes > otaWrites,
+           "OTA öncesi kayıt yazılıp kapatılmalı");
+
+    if (failures) {
+        printf("%u beklenti karşılanmadı\n", (unsigned)failures);
+        return 1;
+    }
+    printf("Tüm beklentiler karşılandı\n");
+    return 0;
+}
+#endif
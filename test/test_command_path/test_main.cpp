@@ -0,0 +1,384 @@
+// Komut yolu uçtan uca testleri: çerçeve -> CommandProcessor -> tick ->
+// GPIO. HAL'ın native uygulamasıyla çalışır (yalnızca [env:native]).
+//   pio test -e native -f test_command_path
+
+#include <unity.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Hal.h"
+#include "native/NativeHal.h"
+#include "MotorController.h"
+#include "CommandProcessor.h"
+#include "DriveProtocol.h"
+#include "UdpControl.h"
+
+// main.cpp ile aynı pinler
+static const uint8_t PWMA = 5, AIN1 = 4, AIN2 = 0;
+static const uint8_t PWMB = 13, BIN1 = 16, BIN2 = 15;
+static const uint8_t STBY = 2;
+
+class NullTransport : public hal::Transport {
+public:
+    uint32_t textFrames = 0;
+
+    bool sendText(uint8_t, const char*, size_t) override {
+        textFrames++;
+        return true;
+    }
+    bool sendBinary(uint8_t, const uint8_t*, size_t) override { return true; }
+};
+
+static NativeGpioPort& gpio = native::gpioPort();
+static MotorController* motor;
+static NullTransport* transport;
+static CommandProcessor* processor;
+static uint16_t seq;
+
+void setUp() {
+    native::setLogEnabled(false);
+    motor = new MotorController(gpio, PWMA, AIN1, AIN2, PWMB, BIN1, BIN2, STBY);
+    motor->begin();
+    transport = new NullTransport();
+    processor = new CommandProcessor(motor, nullptr, transport);
+    processor->onConnect(0);
+
+    // Rampa tek tick'te hedefe: pinler komutun kendisini gösterir
+    RampConfig instant = { 60000, 60000, 0 };
+    motor->setRamp(instant);
+    seq = 100;
+}
+
+void tearDown() {
+    delete processor;
+    delete transport;
+    delete motor;
+}
+
+static void sendJson(const char* text, uint8_t client = 0) {
+    char buf[128];
+    size_t n = strlen(text);
+    memcpy(buf, text, n);
+    processor->handleText(client, (uint8_t*)buf, n, hal::cycleCount());
+}
+
+static void sendBinary(uint8_t opcode, uint16_t frameSeq, int16_t left, int16_t right, uint32_t stamp,
+                       uint8_t client = 0) {
+    DriveProtocol::Frame frame = {};
+    frame.opcode = opcode;
+    frame.seq = frameSeq;
+    frame.left = left;
+    frame.right = right;
+    frame.stamp = stamp;
+    uint8_t buf[DriveProtocol::FRAME_SIZE];
+    DriveProtocol::encode(frame, buf);
+    processor->handleBinary(client, buf, sizeof(buf), hal::cycleCount());
+}
+
+static void assertStopped() {
+    TEST_ASSERT_EQUAL_INT(0, gpio.duty[PWMA]);
+    TEST_ASSERT_EQUAL_INT(0, gpio.duty[PWMB]);
+    TEST_ASSERT_FALSE(gpio.level[AIN1] || gpio.level[AIN2]);
+    TEST_ASSERT_FALSE(gpio.level[BIN1] || gpio.level[BIN2]);
+}
+
+// Tam ölçek: sol ileri (AIN1), sağ geri (BIN2), ikisi de PWM_MAX
+static void test_json_custom_drives_pins() {
+    sendJson("{\"cmd\":\"custom\",\"left\":1000,\"right\":-1000}");
+    motor->tick();
+
+    TEST_ASSERT_EQUAL_INT(MotorController::PWM_MAX, gpio.duty[PWMA]);
+    TEST_ASSERT_EQUAL_INT(MotorController::PWM_MAX, gpio.duty[PWMB]);
+    TEST_ASSERT_TRUE(gpio.level[AIN1] && !gpio.level[AIN2]);
+    TEST_ASSERT_TRUE(!gpio.level[BIN1] && gpio.level[BIN2]);
+    TEST_ASSERT_EQUAL_UINT32(2, transport->textFrames);    // Hoşgeldin + durum yanıtı
+}
+
+// Yarım ölçek ölü bölge telafisiyle kalkış eşiğinin üstüne eşlenir;
+// durdurma rampasız, aynı tick'te
+static void test_json_half_scale_and_stop() {
+    sendJson("{\"cmd\":\"custom\",\"left\":500,\"right\":500}");
+    motor->tick();
+
+    TEST_ASSERT_TRUE(gpio.duty[PWMA] > 150);    // Varsayılan kalkış eşiği
+    TEST_ASSERT_TRUE(gpio.duty[PWMA] < MotorController::PWM_MAX);
+    TEST_ASSERT_EQUAL_INT(gpio.duty[PWMA], gpio.duty[PWMB]);
+    TEST_ASSERT_TRUE(gpio.level[AIN1] && gpio.level[BIN1]);
+
+    sendJson("{\"cmd\":\"move\",\"direction\":\"stop\"}");
+    assertStopped();
+}
+
+// HTTP kısa kodları aynı kayıttan: F ileri, S dur; bilinmeyen reddedilir
+static void test_http_control_short_codes() {
+    TEST_ASSERT_TRUE(processor->handleControl("F", hal::cycleCount()));
+    motor->tick();
+    TEST_ASSERT_TRUE(gpio.duty[PWMA] > 0);
+    TEST_ASSERT_EQUAL_INT(gpio.duty[PWMA], gpio.duty[PWMB]);
+    TEST_ASSERT_TRUE(gpio.level[AIN1] && gpio.level[BIN1]);
+
+    TEST_ASSERT_TRUE(processor->handleControl("S", hal::cycleCount()));
+    assertStopped();
+    TEST_ASSERT_FALSE(processor->handleControl("XYZ", hal::cycleCount()));
+}
+
+// Sabit komutlar varsayılan hızla (150) ölü bölge telafisi olmadan:
+// oranlar pinlerde aynen görünür (turn_ratio 0.7 -> 105)
+static void test_presets_bypass_deadband() {
+    TEST_ASSERT_TRUE(processor->handleControl("F", hal::cycleCount()));
+    motor->tick();
+    TEST_ASSERT_EQUAL_INT(150, gpio.duty[PWMA]);
+    TEST_ASSERT_EQUAL_INT(150, gpio.duty[PWMB]);
+    TEST_ASSERT_TRUE(gpio.level[AIN1] && gpio.level[BIN1]);
+
+    motor->turnLeft();
+    motor->tick();      // Sol teker yön değiştirirken rampa bir tick sıfırda
+    motor->tick();
+    TEST_ASSERT_EQUAL_INT(105, gpio.duty[PWMA]);
+    TEST_ASSERT_EQUAL_INT(150, gpio.duty[PWMB]);
+    TEST_ASSERT_TRUE(!gpio.level[AIN1] && gpio.level[AIN2]);
+    TEST_ASSERT_TRUE(gpio.level[BIN1] && !gpio.level[BIN2]);
+
+    // Joystick birimi telafili kalır: aynı 150 kalkış eşiğinin üstüne eşlenir
+    motor->setTarget(150, 150);
+    motor->tick();
+    motor->tick();
+    TEST_ASSERT_TRUE(gpio.duty[PWMA] > 150);
+}
+
+// Her sabit komut eski teker oranlarını aynen verir: dış teker varsayılan
+// hız, iç teker turn_ratio (0.7) / curve_ratio (0.5) katı
+static void test_preset_wheel_ratios() {
+    struct Case {
+        void (MotorController::*command)();
+        int left;
+        int right;
+    };
+    static const Case cases[] = {
+        { &MotorController::forward,        150,  150 },
+        { &MotorController::backward,      -150, -150 },
+        { &MotorController::turnLeft,      -105,  150 },
+        { &MotorController::turnRight,      150, -105 },
+        { &MotorController::forwardLeft,     75,  150 },
+        { &MotorController::forwardRight,   150,   75 },
+        { &MotorController::backwardLeft,   -75, -150 },
+        { &MotorController::backwardRight, -150,  -75 },
+        { &MotorController::pivotLeft,     -150,  150 },
+        { &MotorController::pivotRight,     150, -150 },
+    };
+
+    for (const Case& c : cases) {
+        motor->stop();      // Rampalar sıfırdan: yön değişimi tick beklemez
+        (motor->*c.command)();
+        motor->tick();
+        TEST_ASSERT_EQUAL_INT(c.left < 0 ? -c.left : c.left, gpio.duty[PWMA]);
+        TEST_ASSERT_EQUAL_INT(c.right < 0 ? -c.right : c.right, gpio.duty[PWMB]);
+        TEST_ASSERT_TRUE(c.left > 0 ? gpio.level[AIN1] && !gpio.level[AIN2] : !gpio.level[AIN1] && gpio.level[AIN2]);
+        TEST_ASSERT_TRUE(c.right > 0 ? gpio.level[BIN1] && !gpio.level[BIN2] : !gpio.level[BIN1] && gpio.level[BIN2]);
+    }
+
+    // Her hızda hız × oran, sıfıra doğru kırpılmış (eski analogWrite'ın
+    // tamsayıya çevirmesi); float'ın 90 * 0.7 = 62.999.. artefaktı hariç
+    for (int speed = 0; speed <= 255; speed++) {
+        motor->setSpeed(speed);
+        motor->stop();
+        motor->turnRight();
+        motor->tick();
+        TEST_ASSERT_EQUAL_INT(speed, gpio.duty[PWMA]);
+        TEST_ASSERT_EQUAL_INT(speed * 7 / 10, gpio.duty[PWMB]);
+
+        motor->stop();
+        motor->forwardLeft();
+        motor->tick();
+        TEST_ASSERT_EQUAL_INT(speed / 2, gpio.duty[PWMA]);
+        TEST_ASSERT_EQUAL_INT(speed, gpio.duty[PWMB]);
+    }
+}
+
+// Bir geçişte gelen çerçevelerden yalnızca en yenisi uygulanır
+static void test_binary_applies_newest_only() {
+    uint32_t now = hal::millis();
+    sendBinary(DriveProtocol::OP_DRIVE, ++seq, 1000, 1000, now);
+    sendBinary(DriveProtocol::OP_DRIVE, ++seq, -1000, -1000, now);
+    sendBinary(DriveProtocol::OP_DRIVE, ++seq, 0, 1000, now);
+    processor->flush();
+    motor->tick();
+
+    const DriveInbox& inbox = processor->getDriveInbox();
+    TEST_ASSERT_EQUAL_UINT32(1, inbox.getApplied());
+    TEST_ASSERT_EQUAL_UINT32(2, inbox.getSuperseded());
+    TEST_ASSERT_EQUAL_INT(0, gpio.duty[PWMA]);
+    TEST_ASSERT_EQUAL_INT(MotorController::PWM_MAX, gpio.duty[PWMB]);
+}
+
+// Eski/tekrar seq atılır, pinler son kabul edilen komutta kalır
+static void test_inbox_drops_reordered() {
+    uint32_t now = hal::millis();
+    sendBinary(DriveProtocol::OP_DRIVE, 200, 1000, 1000, now);
+    processor->flush();
+    motor->tick();
+    sendBinary(DriveProtocol::OP_DRIVE, 198, -1000, -1000, now);
+    sendBinary(DriveProtocol::OP_DRIVE, 200, -1000, -1000, now);
+    processor->flush();
+    motor->tick();
+
+    const DriveInbox& inbox = processor->getDriveInbox();
+    TEST_ASSERT_EQUAL_UINT32(2, inbox.getReordered());
+    TEST_ASSERT_EQUAL_UINT32(1, inbox.getApplied());
+    TEST_ASSERT_TRUE(gpio.level[AIN1] && gpio.level[BIN1]);
+    TEST_ASSERT_EQUAL_INT(MotorController::PWM_MAX, gpio.duty[PWMA]);
+}
+
+// Kuyrukta staleMs'den uzun beklemiş (damgası tabandan eski) çerçeve atılır
+static void test_inbox_drops_stale() {
+    uint32_t now = hal::millis();
+    sendBinary(DriveProtocol::OP_DRIVE, ++seq, 1000, 1000, now);
+    processor->flush();
+    motor->tick();
+    sendBinary(DriveProtocol::OP_DRIVE, ++seq, -1000, -1000, now - DriveInbox::DEFAULT_STALE_MS - 100);
+    processor->flush();
+    motor->tick();
+
+    const DriveInbox& inbox = processor->getDriveInbox();
+    TEST_ASSERT_EQUAL_UINT32(1, inbox.getStale());
+    TEST_ASSERT_EQUAL_UINT32(1, inbox.getApplied());
+    TEST_ASSERT_TRUE(gpio.level[AIN1] && gpio.level[BIN1]);
+}
+
+// UDP sürücüsü ile WebSocket keepalive'ları iç içe: seq ve yaş tabanı
+// istemci başına, araya giren istemci UDP korumasını sıfırlamaz
+static void test_inbox_tracks_clients_separately() {
+    const uint8_t udp = UdpControl::CLIENT_ID;
+    const uint32_t otherClock = 123456;     // WebSocket istemcisinin saati başka
+    uint32_t now = hal::millis();
+    sendBinary(DriveProtocol::OP_DRIVE, 500, 1000, 1000, now, udp);
+    processor->flush();
+    motor->tick();
+
+    sendBinary(DriveProtocol::OP_KEEPALIVE, 7, 0, 0, now + otherClock);
+    sendBinary(DriveProtocol::OP_DRIVE, 499, -1000, -1000, now, udp);
+    sendBinary(DriveProtocol::OP_KEEPALIVE, 8, 0, 0, now + otherClock);
+    sendBinary(DriveProtocol::OP_DRIVE, 501, -1000, -1000, now - DriveInbox::DEFAULT_STALE_MS - 100, udp);
+    sendBinary(DriveProtocol::OP_KEEPALIVE, 9, 0, 0, now + otherClock);
+    processor->flush();
+    motor->tick();
+
+    const DriveInbox& inbox = processor->getDriveInbox();
+    TEST_ASSERT_EQUAL_UINT32(1, inbox.getReordered());
+    TEST_ASSERT_EQUAL_UINT32(1, inbox.getStale());
+    TEST_ASSERT_EQUAL_UINT32(1, inbox.getApplied());
+    TEST_ASSERT_TRUE(gpio.level[AIN1] && gpio.level[BIN1]);
+    TEST_ASSERT_EQUAL_INT(MotorController::PWM_MAX, gpio.duty[PWMA]);
+
+    // Her iki istemci kendi sırasında taze kalır
+    sendBinary(DriveProtocol::OP_DRIVE, 10, 0, 1000, now + otherClock);
+    processor->flush();
+    motor->tick();
+    sendBinary(DriveProtocol::OP_DRIVE, 502, 1000, 0, hal::millis(), udp);
+    processor->flush();
+    motor->tick();
+    TEST_ASSERT_EQUAL_UINT32(3, inbox.getApplied());
+    TEST_ASSERT_EQUAL_INT(MotorController::PWM_MAX, gpio.duty[PWMA]);
+    TEST_ASSERT_EQUAL_INT(0, gpio.duty[PWMB]);
+}
+
+// OP_STOP bayat ya da sırasız olsa bile uygulanır
+static void test_stale_stop_still_stops() {
+    uint32_t now = hal::millis();
+    sendBinary(DriveProtocol::OP_DRIVE, 300, 1000, 1000, now);
+    processor->flush();
+    motor->tick();
+    sendBinary(DriveProtocol::OP_STOP, 299, 0, 0, now - 2000);
+    assertStopped();
+}
+
+// Yalnızca değişimde gönderen JSON istemcisi {"cmd":"ka"} ile sürmeye
+// devam eder; keepalive kesilince bekçi aracı durdurur
+static void test_json_keepalive_feeds_watchdog() {
+    WatchdogConfig wd = { 40, 60, 2 };     // RTT ölçümü yok: 60 ms
+    motor->getWatchdog().configure(wd);
+
+    sendJson("{\"cmd\":\"custom\",\"left\":1000,\"right\":1000}");
+    uint32_t from = hal::millis();
+    uint32_t lastKeepalive = from;
+    while (hal::millis() - from < 200) {
+        if (hal::millis() - lastKeepalive >= 20) {
+            sendJson("{\"cmd\":\"ka\"}");
+            lastKeepalive = hal::millis();
+        }
+        motor->tick();
+        usleep(1000);
+    }
+    TEST_ASSERT_FALSE(motor->getWatchdog().hasFault());
+    TEST_ASSERT_EQUAL_INT(MotorController::PWM_MAX, gpio.duty[PWMA]);
+
+    // Son keepalive; sonrası sessizlik
+    sendJson("{\"cmd\":\"ka\"}");
+    from = hal::millis();
+    while (!motor->getWatchdog().hasFault() && hal::millis() - from < 500) {
+        motor->tick();
+        usleep(1000);
+    }
+    TEST_ASSERT_TRUE(motor->getWatchdog().hasFault());
+    TEST_ASSERT_TRUE(hal::millis() - from >= 60);
+}
+
+// Keepalive yalnızca sürücü istemciden: istemci 0 sürer ve susar, boşta
+// duran istemci 1'in (JSON ve ikili) keepalive'ları bekçiyi beslemez
+static void test_keepalive_only_from_driver() {
+    WatchdogConfig wd = { 40, 60, 2 };
+    motor->getWatchdog().configure(wd);
+    processor->onConnect(1);
+
+    sendJson("{\"cmd\":\"custom\",\"left\":1000,\"right\":1000}", 0);
+    uint32_t from = hal::millis();
+    uint32_t lastKeepalive = from;
+    uint16_t idleSeq = 0;
+    while (!motor->getWatchdog().hasFault() && hal::millis() - from < 500) {
+        if (hal::millis() - lastKeepalive >= 20) {
+            sendJson("{\"cmd\":\"ka\"}", 1);
+            sendBinary(DriveProtocol::OP_KEEPALIVE, ++idleSeq, 0, 0, hal::millis(), 1);
+            lastKeepalive = hal::millis();
+        }
+        motor->tick();
+        usleep(1000);
+    }
+    TEST_ASSERT_TRUE(motor->getWatchdog().hasFault());
+    TEST_ASSERT_TRUE(hal::millis() - from < 200);
+
+    // /control da bir istemcidir: kendi sürdüğünü "ka" ile canlı tutar
+    TEST_ASSERT_TRUE(processor->handleControl("F", hal::cycleCount()));
+    from = hal::millis();
+    lastKeepalive = from;
+    while (hal::millis() - from < 200) {
+        if (hal::millis() - lastKeepalive >= 20) {
+            TEST_ASSERT_TRUE(processor->handleControl("ka", hal::cycleCount()));
+            lastKeepalive = hal::millis();
+        }
+        motor->tick();
+        usleep(1000);
+    }
+    TEST_ASSERT_FALSE(motor->getWatchdog().hasFault());
+    TEST_ASSERT_EQUAL_INT(150, gpio.duty[PWMA]);
+}
+
+static int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_json_custom_drives_pins);
+    RUN_TEST(test_json_half_scale_and_stop);
+    RUN_TEST(test_http_control_short_codes);
+    RUN_TEST(test_presets_bypass_deadband);
+    RUN_TEST(test_preset_wheel_ratios);
+    RUN_TEST(test_binary_applies_newest_only);
+    RUN_TEST(test_inbox_drops_reordered);
+    RUN_TEST(test_inbox_drops_stale);
+    RUN_TEST(test_inbox_tracks_clients_separately);
+    RUN_TEST(test_stale_stop_still_stops);
+    RUN_TEST(test_json_keepalive_feeds_watchdog);
+    RUN_TEST(test_keepalive_only_from_driver);
+    return UNITY_END();
+}
+
+int main() {
+    return runTests();
+}
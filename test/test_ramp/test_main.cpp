@@ -0,0 +1,217 @@
+// RampGenerator ve ölü bölge telafisi birim testleri (saf hesap, başlık).
+//   pio test -e native -f test_ramp
+//
+// Rampa değerleri Q8'den PWM birimine sıfıra doğru kırpılır; tick başına
+// sınırlar bu yüzden ceil(adım / 256) ile, jerk de ikinci farkta +1 yuvarlama
+// payıyla denetlenir. Birikimli sınır (S-eğrisi) Q8'de kesindir.
+
+#include <unity.h>
+#include <stdlib.h>
+
+#include "RampGenerator.h"
+
+static const uint32_t TICK_HZ = 200;
+static const int16_t MIN_PWM = 150;
+static const int16_t PWM_MAX = 255;
+
+// MotorController'daki varsayılanlar
+static const RampConfig TRAPEZOID = { 510, 1020, 0 };
+static const RampConfig S_CURVE = { 510, 1020, 4000 };
+
+// RampGenerator::configure() ile aynı Q8 / tick adımı
+static int32_t stepQ8(uint32_t perSec, uint32_t hz) {
+    int32_t step = (int32_t)((perSec << 8) / hz);
+    return step > 0 ? step : 1;
+}
+
+static int32_t ceilPwm(int32_t q8) {
+    return (q8 + 255) >> 8;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Durağandan hedefe: hedefe uzaklık hiç artmaz, hedef aşılmaz ve ulaşılır
+static void checkApproach(const RampConfig& config, int16_t from, int16_t target, uint32_t maxTicks) {
+    RampGenerator ramp;
+    ramp.configure(config, TICK_HZ);
+    ramp.reset(from);
+
+    int16_t previous = from;
+    uint32_t tick = 0;
+    for (; tick < maxTicks && previous != target; tick++) {
+        int16_t value = ramp.step(target);
+        TEST_ASSERT_TRUE_MESSAGE(abs(target - value) <= abs(target - previous), "hedeften uzaklaştı");
+        if (target >= from) {
+            TEST_ASSERT_TRUE_MESSAGE(value <= target, "hedef aşıldı");
+        } else {
+            TEST_ASSERT_TRUE_MESSAGE(value >= target, "hedef aşıldı");
+        }
+        previous = value;
+    }
+    TEST_ASSERT_EQUAL_INT16(target, previous);
+
+    // Hedefte kalır
+    for (uint32_t i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_INT16(target, ramp.step(target));
+    }
+}
+
+static void test_trapezoid_monotonic_no_overshoot() {
+    checkApproach(TRAPEZOID, 0, 255, TICK_HZ);
+    checkApproach(TRAPEZOID, 0, -255, TICK_HZ);
+    checkApproach(TRAPEZOID, 255, 0, TICK_HZ);
+    checkApproach(TRAPEZOID, 100, 101, TICK_HZ);
+}
+
+static void test_scurve_monotonic_no_overshoot() {
+    checkApproach(S_CURVE, 0, 255, 2 * TICK_HZ);
+    checkApproach(S_CURVE, 0, -200, 2 * TICK_HZ);
+    checkApproach(S_CURVE, 255, 0, 2 * TICK_HZ);
+    checkApproach(S_CURVE, 0, 3, 2 * TICK_HZ);
+}
+
+// Hız büyürken accel, küçülürken decel sınırı; yön değişimi sıfırdan geçer
+static void checkRateLimits(const RampConfig& config) {
+    const int32_t accel = ceilPwm(stepQ8(config.accelPerSec, TICK_HZ));
+    const int32_t decel = ceilPwm(stepQ8(config.decelPerSec, TICK_HZ));
+    const int16_t targets[] = { 255, -200, 120, 0, -255, 0 };
+
+    RampGenerator ramp;
+    ramp.configure(config, TICK_HZ);
+
+    int16_t previous = 0;
+    for (int16_t target : targets) {
+        for (uint32_t i = 0; i < 2 * TICK_HZ; i++) {
+            int16_t value = ramp.step(target);
+            int32_t delta = abs(value - previous);
+            if (abs(value) > abs(previous)) {
+                TEST_ASSERT_TRUE_MESSAGE(delta <= accel, "accel sınırı aşıldı");
+            } else {
+                TEST_ASSERT_TRUE_MESSAGE(delta <= decel, "decel sınırı aşıldı");
+            }
+            TEST_ASSERT_FALSE_MESSAGE((previous > 0 && value < 0) || (previous < 0 && value > 0),
+                                      "yön değişimi sıfırı atladı");
+            previous = value;
+        }
+        TEST_ASSERT_EQUAL_INT16(target, previous);
+    }
+}
+
+static void test_trapezoid_rate_limits() {
+    checkRateLimits(TRAPEZOID);
+}
+
+static void test_scurve_rate_limits() {
+    checkRateLimits(S_CURVE);
+}
+
+// S-eğrisi: tick başına ivme değişimi jerk ile sınırlı
+static void test_scurve_jerk_limit() {
+    const int32_t jerk = stepQ8(S_CURVE.jerkPerSec2, TICK_HZ * TICK_HZ);
+    const int32_t accel = stepQ8(S_CURVE.accelPerSec, TICK_HZ);
+    const int32_t slack = ceilPwm(jerk) + 1;
+    const int16_t targets[] = { 255, 0, -180, 60 };
+
+    RampGenerator ramp;
+    ramp.configure(S_CURVE, TICK_HZ);
+
+    // Kalkış: N tick sonra hız, ivmesi tick başına en fazla jerk artan
+    // profilin birikimini (Q8, kesin) geçemez
+    int32_t boundQ8 = 0;
+    for (int32_t n = 1; n <= 40; n++) {
+        int32_t rate = n * jerk < accel ? n * jerk : accel;
+        boundQ8 += rate;
+        int16_t value = ramp.step(255);
+        TEST_ASSERT_TRUE_MESSAGE((int32_t)value << 8 <= boundQ8, "ivme jerk sınırından hızlı arttı");
+    }
+
+    ramp.reset(0);
+    int16_t v0 = 0;
+    int16_t v1 = 0;
+    for (int16_t target : targets) {
+        for (uint32_t i = 0; i < 2 * TICK_HZ; i++) {
+            int16_t v2 = ramp.step(target);
+            int32_t jerkPwm = abs((v2 - v1) - (v1 - v0));
+            TEST_ASSERT_TRUE_MESSAGE(jerkPwm <= slack, "jerk sınırı aşıldı");
+            v0 = v1;
+            v1 = v2;
+        }
+    }
+}
+
+// Trapez ile karşılaştırma: jerk sınırı kalkışı gerçekten yumuşatır
+static void test_scurve_slower_start_than_trapezoid() {
+    RampGenerator trapezoid;
+    RampGenerator sCurve;
+    trapezoid.configure(TRAPEZOID, TICK_HZ);
+    sCurve.configure(S_CURVE, TICK_HZ);
+
+    int16_t t = 0;
+    int16_t s = 0;
+    for (uint32_t i = 0; i < 10; i++) {
+        t = trapezoid.step(255);
+        s = sCurve.step(255);
+    }
+    TEST_ASSERT_TRUE(s < t);
+}
+
+static void test_reset_bypasses_ramp() {
+    RampGenerator ramp;
+    ramp.configure(S_CURVE, TICK_HZ);
+    for (uint32_t i = 0; i < 50; i++) ramp.step(255);
+    ramp.reset();
+    TEST_ASSERT_EQUAL_INT16(0, ramp.value());
+    TEST_ASSERT_EQUAL_INT16(0, ramp.step(0));
+}
+
+static void test_deadband_zero_at_zero() {
+    TEST_ASSERT_EQUAL_INT16(0, compensateDeadband(0, MIN_PWM, PWM_MAX));
+    TEST_ASSERT_EQUAL_INT16(0, compensateDeadband(0, 0, PWM_MAX));
+}
+
+// Sıfır dışında sürekli: komşu girdiler en fazla 1 PWM farklı, monoton,
+// tek (odd) simetrik; uçlar [MIN_PWM, PWM_MAX]
+static void test_deadband_continuous() {
+    TEST_ASSERT_TRUE(compensateDeadband(1, MIN_PWM, PWM_MAX) > MIN_PWM);
+    TEST_ASSERT_TRUE(compensateDeadband(1, MIN_PWM, PWM_MAX) <= MIN_PWM + 1);
+    TEST_ASSERT_EQUAL_INT16(PWM_MAX, compensateDeadband(PWM_MAX, MIN_PWM, PWM_MAX));
+    TEST_ASSERT_EQUAL_INT16(PWM_MAX, compensateDeadband(1000, MIN_PWM, PWM_MAX));
+
+    int16_t previous = compensateDeadband(1, MIN_PWM, PWM_MAX);
+    for (int16_t speed = 2; speed <= PWM_MAX; speed++) {
+        int16_t out = compensateDeadband(speed, MIN_PWM, PWM_MAX);
+        TEST_ASSERT_TRUE_MESSAGE(out - previous >= 0 && out - previous <= 1, "telafi sürekli değil");
+        TEST_ASSERT_EQUAL_INT16(-out, compensateDeadband(-speed, MIN_PWM, PWM_MAX));
+        previous = out;
+    }
+}
+
+static int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_trapezoid_monotonic_no_overshoot);
+    RUN_TEST(test_scurve_monotonic_no_overshoot);
+    RUN_TEST(test_trapezoid_rate_limits);
+    RUN_TEST(test_scurve_rate_limits);
+    RUN_TEST(test_scurve_jerk_limit);
+    RUN_TEST(test_scurve_slower_start_than_trapezoid);
+    RUN_TEST(test_reset_bypasses_ramp);
+    RUN_TEST(test_deadband_zero_at_zero);
+    RUN_TEST(test_deadband_continuous);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);    // Seri monitör bağlansın
+    runTests();
+}
+
+void loop() {}
+#else
+int main() {
+    return runTests();
+}
+#endif
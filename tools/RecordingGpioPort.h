@@ -0,0 +1,45 @@
+#ifndef RECORDING_GPIO_PORT_H
+#define RECORDING_GPIO_PORT_H
+
+#include <cstdio>
+#include <vector>
+
+#include "MotorDriver.h"
+
+// Host tarafı GpioPort mock'u: her register/PWM yazımını sırasıyla kaydeder
+class RecordingGpioPort : public GpioPort {
+public:
+    enum Kind { CONFIGURE, MASKS, GPIO16, PWM };
+
+    struct Write {
+        Kind kind;
+        uint32_t a;   // pin / setMask / değer
+        uint32_t b;   // clearMask / duty
+    };
+
+    std::vector<Write> writes;
+
+    void configureOutput(uint8_t pin) override { writes.push_back({ CONFIGURE, pin, 0 }); }
+    void writeMasks(uint32_t setMask, uint32_t clearMask) override {
+        writes.push_back({ MASKS, setMask, clearMask });
+    }
+    void writeGpio16(bool high) override { writes.push_back({ GPIO16, high ? 1u : 0u, 0 }); }
+    void writePwm(uint8_t pin, uint16_t duty) override { writes.push_back({ PWM, pin, duty }); }
+
+    void clear() { writes.clear(); }
+
+    void print(const char* label) const {
+        printf("%-16s %zu yazım:", label, writes.size());
+        for (const Write& w : writes) {
+            switch (w.kind) {
+                case CONFIGURE: printf(" OUT(%u)", w.a); break;
+                case MASKS: printf(" GPOS=0x%04x/GPOC=0x%04x", w.a, w.b); break;
+                case GPIO16: printf(" GP16O=%u", w.a); break;
+                case PWM: printf(" PWM(%u)=%u", w.a, w.b); break;
+            }
+        }
+        printf("\n");
+    }
+};
+
+#endif
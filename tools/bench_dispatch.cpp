@@ -0,0 +1,139 @@
+// Metin komut dağıtım maliyeti karşılaştırması (host tarafı)
+//
+// Aynı token akışını üç yoldan geçirip token başına ns ölçer:
+//  - String zinciri: eski handleWebSocketMessage/handleCommand gibi her
+//    dalda geçici String (burada std::string) ile == karşılaştırması
+//  - strcmp zinciri: kayıt tablosundan önceki CommandProcessor if/else'i
+//  - Kayıt: CommandRegistry::find (derleme zamanı sıralı tablo, ikili arama)
+// Akış HTTP kısa kodları, JSON yön/komut adları ve bilinmeyen tokenlardan
+// oluşur; zincirlerin sonundaki tokenlar en pahalı durumu gösterir.
+//
+// Derleme:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/bench_dispatch.cpp -o bench_dispatch
+//   ./bench_dispatch [iterasyon]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "CommandRegistry.h"
+
+static volatile int32_t sink = 0;
+
+typedef std::chrono::steady_clock Clock;
+
+static const char* const TOKENS[] = {
+    "F", "B", "L", "R", "S", "FL", "BR", "PL", "PR", "SPD",
+    "forward", "backward", "left", "right", "stop",
+    "forward_left", "backward_right", "custom", "speed", "sound",
+    "horn_x", "unknown"
+};
+static const size_t TOKEN_COUNT = sizeof(TOKENS) / sizeof(TOKENS[0]);
+
+// Eski yol: her karşılaştırma için geçici String
+static int dispatchString(const char* token) {
+    std::string cmd = token;
+    if (cmd == std::string("F")) return 1;
+    else if (cmd == std::string("B")) return 2;
+    else if (cmd == std::string("L")) return 3;
+    else if (cmd == std::string("R")) return 4;
+    else if (cmd == std::string("FL")) return 5;
+    else if (cmd == std::string("FR")) return 6;
+    else if (cmd == std::string("BL")) return 7;
+    else if (cmd == std::string("BR")) return 8;
+    else if (cmd == std::string("S")) return 9;
+    else if (cmd == std::string("PL")) return 10;
+    else if (cmd == std::string("PR")) return 11;
+    else if (cmd == std::string("SPD")) return 12;
+    else if (cmd == std::string("move")) return 13;
+    else if (cmd == std::string("speed")) return 14;
+    else if (cmd == std::string("custom")) return 15;
+    else if (cmd == std::string("sound")) return 16;
+    else if (cmd == std::string("forward")) return 17;
+    else if (cmd == std::string("backward")) return 18;
+    else if (cmd == std::string("left")) return 19;
+    else if (cmd == std::string("right")) return 20;
+    else if (cmd == std::string("stop")) return 21;
+    else if (cmd == std::string("forward_left")) return 22;
+    else if (cmd == std::string("forward_right")) return 23;
+    else if (cmd == std::string("backward_left")) return 24;
+    else if (cmd == std::string("backward_right")) return 25;
+    return 0;
+}
+
+// Önceki CommandProcessor: aynı zincir, strcmp ile
+static int dispatchStrcmp(const char* cmd) {
+    if (strcmp(cmd, "F") == 0) return 1;
+    else if (strcmp(cmd, "B") == 0) return 2;
+    else if (strcmp(cmd, "L") == 0) return 3;
+    else if (strcmp(cmd, "R") == 0) return 4;
+    else if (strcmp(cmd, "FL") == 0) return 5;
+    else if (strcmp(cmd, "FR") == 0) return 6;
+    else if (strcmp(cmd, "BL") == 0) return 7;
+    else if (strcmp(cmd, "BR") == 0) return 8;
+    else if (strcmp(cmd, "S") == 0) return 9;
+    else if (strcmp(cmd, "PL") == 0) return 10;
+    else if (strcmp(cmd, "PR") == 0) return 11;
+    else if (strncmp(cmd, "SPD", 3) == 0) return 12;
+    else if (strcmp(cmd, "move") == 0) return 13;
+    else if (strcmp(cmd, "speed") == 0) return 14;
+    else if (strcmp(cmd, "custom") == 0) return 15;
+    else if (strcmp(cmd, "sound") == 0) return 16;
+    else if (strcmp(cmd, "forward") == 0) return 17;
+    else if (strcmp(cmd, "backward") == 0) return 18;
+    else if (strcmp(cmd, "left") == 0) return 19;
+    else if (strcmp(cmd, "right") == 0) return 20;
+    else if (strcmp(cmd, "stop") == 0) return 21;
+    else if (strcmp(cmd, "forward_left") == 0) return 22;
+    else if (strcmp(cmd, "forward_right") == 0) return 23;
+    else if (strcmp(cmd, "backward_left") == 0) return 24;
+    else if (strcmp(cmd, "backward_right") == 0) return 25;
+    return 0;
+}
+
+static int dispatchRegistry(const char* token) {
+    const CommandRegistry::Entry* entry =
+        CommandRegistry::find(CommandRegistry::COMMANDS, token, strlen(token));
+    return entry ? entry->id + 1 : 0;
+}
+
+template <typename Dispatch>
+static double measure(long iterations, Dispatch dispatch) {
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; i++) {
+        // Derleyicinin sabit katlamasını engelle: token uçucu indeksle seçilir
+        sink += dispatch(TOKENS[(size_t)(i + sink) % TOKEN_COUNT]);
+    }
+    Clock::time_point end = Clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(int argc, char** argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 5000000;
+
+    // Üç yol aynı tokenı tanımalı
+    for (size_t i = 0; i < TOKEN_COUNT; i++) {
+        bool known = dispatchRegistry(TOKENS[i]) != 0;
+        if (known != (dispatchStrcmp(TOKENS[i]) != 0) || known != (dispatchString(TOKENS[i]) != 0)) {
+            fprintf(stderr, "Uyumsuz token: %s\n", TOKENS[i]);
+            return 1;
+        }
+    }
+
+    double baseline = measure(iterations, [](const char* token) { return (int)token[0]; });
+    double stringNs = measure(iterations, dispatchString) - baseline;
+    double strcmpNs = measure(iterations, dispatchStrcmp) - baseline;
+    double registryNs = measure(iterations, dispatchRegistry) - baseline;
+
+    printf("iterasyon      : %ld (%zu token, %zu kayıt)\n", iterations, TOKEN_COUNT,
+           sizeof(CommandRegistry::COMMANDS) / sizeof(CommandRegistry::COMMANDS[0]));
+    printf("String zinciri : %8.1f ns/token\n", stringNs);
+    printf("strcmp zinciri : %8.1f ns/token\n", strcmpNs);
+    printf("Kayıt tablosu  : %8.1f ns/token\n", registryNs);
+    if (registryNs > 0) {
+        printf("Oran           : String %.1fx, strcmp %.1fx\n", stringNs / registryNs, strcmpNs / registryNs);
+    }
+    return 0;
+}
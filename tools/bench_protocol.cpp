@@ -0,0 +1,115 @@
+// Sürüş çerçevesi çözme maliyeti karşılaştırması (host tarafı)
+//
+// JSON yolu (WebServerManager::handleWebSocketMessage ile aynı adımlar:
+// payload kopyası + StaticJsonDocument<256> + String karşılaştırması) ile
+// DriveProtocol::decode yolunu çerçeve başına ns olarak ölçer.
+//
+// Derleme (ArduinoJson header-only, `pio run` sonrası libdeps'te bulunur):
+//   g++ -std=gnu++17 -O2 -Iinclude -I.pio/libdeps/esp12e/ArduinoJson/src tools/bench_protocol.cpp -o bench_protocol
+//   ./bench_protocol [iterasyon]
+
+#include <ArduinoJson.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "DriveProtocol.h"
+
+static volatile int32_t sink = 0;
+
+typedef std::chrono::steady_clock Clock;
+
+static double nsPerFrame(Clock::time_point start, Clock::time_point end, long iterations) {
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+// Cihazdaki JSON yolu: String kopyası, ayrıştırma, "cmd" karşılaştırması
+static void decodeJson(const char* payload, size_t length) {
+    std::string message = std::string(payload).substr(0, length);
+
+    StaticJsonDocument<256> doc;
+    deserializeJson(doc, message);
+
+    std::string cmd = doc["cmd"] | "";
+    if (cmd == "move") {
+        sink += 1;
+    } else if (cmd == "speed") {
+        sink += 2;
+    } else if (cmd == "custom") {
+        int left = doc["left"] | 0;
+        int right = doc["right"] | 0;
+        sink += left - right;
+    }
+}
+
+static void decodeBinary(const uint8_t* payload, size_t length) {
+    DriveProtocol::Frame frame;
+    if (DriveProtocol::decode(payload, length, frame) &&
+        frame.opcode == DriveProtocol::OP_DRIVE) {
+        sink += frame.left - frame.right;
+    }
+}
+
+int main(int argc, char** argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 1000000;
+
+    // Joystick'in gönderdiği tipik çerçeveler
+    char json[64];
+    uint8_t bin[DriveProtocol::FRAME_SIZE];
+
+    Clock::time_point t0 = Clock::now();
+    for (long i = 0; i < iterations; i++) {
+        int v = (int)(i % 2001) - 1000;
+        int n = snprintf(json, sizeof(json), "{\"cmd\":\"custom\",\"left\":%d,\"right\":%d}", v, -v);
+        decodeJson(json, (size_t)n);
+    }
+    Clock::time_point t1 = Clock::now();
+
+    for (long i = 0; i < iterations; i++) {
+        int v = (int)(i % 2001) - 1000;
+        DriveProtocol::Frame frame;
+        frame.opcode = DriveProtocol::OP_DRIVE;
+        frame.flags = 0;
+        frame.seq = (uint16_t)i;
+        frame.left = (int16_t)v;
+        frame.right = (int16_t)-v;
+        frame.stamp = (uint32_t)i;
+        DriveProtocol::encode(frame, bin);
+        decodeBinary(bin, sizeof(bin));
+    }
+    Clock::time_point t2 = Clock::now();
+
+    // Kodlama maliyetini ayırmak için yalnızca hazırlık döngüleri
+    for (long i = 0; i < iterations; i++) {
+        int v = (int)(i % 2001) - 1000;
+        sink += snprintf(json, sizeof(json), "{\"cmd\":\"custom\",\"left\":%d,\"right\":%d}", v, -v);
+    }
+    Clock::time_point t3 = Clock::now();
+
+    for (long i = 0; i < iterations; i++) {
+        int v = (int)(i % 2001) - 1000;
+        DriveProtocol::Frame frame;
+        frame.opcode = DriveProtocol::OP_DRIVE;
+        frame.flags = 0;
+        frame.seq = (uint16_t)i;
+        frame.left = (int16_t)v;
+        frame.right = (int16_t)-v;
+        frame.stamp = (uint32_t)i;
+        DriveProtocol::encode(frame, bin);
+        sink += bin[4];
+    }
+    Clock::time_point t4 = Clock::now();
+
+    double jsonNs = nsPerFrame(t0, t1, iterations) - nsPerFrame(t2, t3, iterations);
+    double binNs = nsPerFrame(t1, t2, iterations) - nsPerFrame(t3, t4, iterations);
+
+    printf("iterasyon      : %ld\n", iterations);
+    printf("JSON  çözme    : %8.1f ns/çerçeve\n", jsonNs);
+    printf("Binary çözme   : %8.1f ns/çerçeve\n", binNs);
+    if (binNs > 0) {
+        printf("Oran           : %8.1fx\n", jsonNs / binNs);
+    }
+    return 0;
+}
@@ -0,0 +1,216 @@
+# Web arayüzü varlık derleyicisi
+#
+# data/ içindeki dosyaları küçültür (minify), gzip'ler ve LittleFS imajı için
+# .pio/www dizinine yazar. Her dosya yalnızca .gz hâliyle saklanır; sunucu
+# (StaticAssets) bunları Content-Encoding: gzip ile gönderir. İçerik
+# özetleri /assets.idx manifestine ETag olarak yazılır, HTML içindeki yerel
+# script/stylesheet referanslarına ?v=<özet> eklenir; böylece js/css uzun
+# süre (immutable) önbelleklenebilir, HTML ise ETag ile 304 döner.
+#
+# -DEMBED_WEB_UI ile derlenirken aynı paket LittleFS yerine PROGMEM dizileri
+# olarak include/WebAssetsEmbedded.h'ye de üretilir (bkz. StaticAssets).
+#
+# PlatformIO ön betiği olarak her derlemede çalışır (extra_scripts), elle de
+# çalıştırılabilir:
+#   python tools/build_assets.py [kaynak] [hedef] [--embed başlık.h]
+
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+# Hiçbir sayfanın yüklemediği kopyalar imaja girmez
+EXCLUDE = {"joystick-new.js"}
+
+CONTENT_TYPES = {
+    ".html": "text/html",
+    ".js": "application/javascript",
+    ".css": "text/css",
+    ".ico": "image/x-icon",
+    ".png": "image/png",
+    ".svg": "image/svg+xml",
+    ".json": "application/json",
+}
+
+MANIFEST = "assets.idx"
+EMBED_HEADER = os.path.join("include", "WebAssetsEmbedded.h")
+
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text)
+    text = re.sub(r"\s*([{};,>])\s*", r"\1", text)
+    return text.replace(";}", "}").strip()
+
+
+def minify_js(text):
+    # Muhafazakâr: satır yapısı korunur (ASI'ye dokunulmaz), yalnızca girinti,
+    # boş satırlar ve tam satır // yorumları atılır
+    lines = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def minify_html(text):
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.S)
+    return minify_js(text)
+
+
+def minify(name, text):
+    if name.endswith(".min.js"):
+        return text
+    if name.endswith(".css"):
+        return minify_css(text)
+    if name.endswith(".js"):
+        return minify_js(text)
+    if name.endswith(".html"):
+        return minify_html(text)
+    return text
+
+
+def digest(data):
+    return hashlib.sha1(data).hexdigest()[:8]
+
+
+def version_refs(html, hashes):
+    # src="script.js" -> src="script.js?v=1a2b3c4d" (yalnızca yerel dosyalar)
+    def repl(match):
+        attr, quote, ref = match.group(1), match.group(2), match.group(3)
+        key = "/" + ref.lstrip("/")
+        if key not in hashes or key.endswith(".html"):
+            return match.group(0)
+        return "%s=%s%s?v=%s%s" % (attr, quote, ref, hashes[key], quote)
+
+    return re.sub(r'(src|href)=(["\'])([^"\'?#:]+)\2', repl, html)
+
+
+def collect(source):
+    """Kaynak dosyaları işler; (yol, içerik tipi, gzip baytları, özet, ham boyut,
+    küçültülmüş boyut) listesi döner. HTML en sonda işlenir ki referans
+    verdiği dosyaların özetleri bilinsin."""
+    names = sorted(n for n in os.listdir(source)
+                   if os.path.isfile(os.path.join(source, n)) and n not in EXCLUDE)
+    names.sort(key=lambda n: n.endswith(".html"))
+
+    hashes = {}
+    assets = []
+    for name in names:
+        ext = os.path.splitext(name)[1]
+        with open(os.path.join(source, name), "rb") as f:
+            raw = f.read()
+
+        if ext in (".html", ".js", ".css"):
+            text = minify(name, raw.decode("utf-8"))
+            if ext == ".html":
+                text = version_refs(text, hashes)
+            body = text.encode("utf-8")
+        else:
+            body = raw
+
+        # mtime=0: aynı girdi her zaman aynı .gz'yi (ve özeti) üretir
+        packed = gzip.compress(body, compresslevel=9, mtime=0)
+        path = "/" + name
+        hashes[path] = digest(body)
+        assets.append((path, CONTENT_TYPES.get(ext, "application/octet-stream"),
+                       packed, hashes[path], len(raw), len(body)))
+    return assets
+
+
+def report(assets):
+    total = [0, 0, 0]
+    print("%-20s %8s %8s %8s  %s" % ("dosya", "ham", "küçük", "gzip", "etag"))
+    for path, _, packed, tag, raw, small in assets:
+        print("%-20s %8d %8d %8d  %s" % (path, raw, small, len(packed), tag))
+        total[0] += raw
+        total[1] += small
+        total[2] += len(packed)
+    print("%-20s %8d %8d %8d  (%%%d)" % ("toplam", total[0], total[1], total[2],
+                                        100 * total[2] // max(total[0], 1)))
+
+
+def build(source, target):
+    if os.path.abspath(source) == os.path.abspath(target):
+        sys.exit("build_assets: hedef dizin kaynakla aynı olamaz: " + target)
+
+    assets = collect(source)
+
+    os.makedirs(target, exist_ok=True)
+    for name in os.listdir(target):
+        os.remove(os.path.join(target, name))
+
+    with open(os.path.join(target, MANIFEST), "w") as manifest:
+        for path, _, packed, tag, _, _ in assets:
+            with open(os.path.join(target, path.lstrip("/") + ".gz"), "wb") as f:
+                f.write(packed)
+            manifest.write("%s %s\n" % (path, tag))
+
+    report(assets)
+    return assets
+
+
+def embed(assets, header):
+    """gzip'li paketi PROGMEM dizileri olarak C++ başlığına yazar."""
+    out = ["// Otomatik üretildi: tools/build_assets.py - elle düzenlemeyin",
+           "#ifndef WEB_ASSETS_EMBEDDED_H",
+           "#define WEB_ASSETS_EMBEDDED_H",
+           "",
+           "#include <Arduino.h>",
+           '#include "StaticAssets.h"',
+           ""]
+    for i, (_, _, packed, _, _, _) in enumerate(assets):
+        out.append("static const uint8_t ASSET_%d[] PROGMEM = {" % i)
+        for j in range(0, len(packed), 16):
+            out.append("    " + ", ".join("0x%02x" % b for b in packed[j:j + 16]) + ",")
+        out.append("};")
+        out.append("")
+
+    out.append("static const EmbeddedAsset EMBEDDED_ASSETS[] = {")
+    for i, (path, ctype, packed, tag, _, _) in enumerate(assets):
+        out.append('    { "%s", "%s", "\\"%s\\"", ASSET_%d, %d },' % (path, ctype, tag, i, len(packed)))
+    out.append("};")
+    out.append("")
+    out.append("static const uint8_t EMBEDDED_ASSET_COUNT = %d;" % len(assets))
+    out.append("")
+    out.append("#endif")
+
+    text = "\n".join(out) + "\n"
+    # Değişmediyse dokunma: gereksiz yeniden derlemeyi önler
+    if os.path.exists(header):
+        with open(header) as f:
+            if f.read() == text:
+                return
+    with open(header, "w") as f:
+        f.write(text)
+
+
+if __name__ == "__main__":
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    args = sys.argv[1:]
+    header = None
+    if "--embed" in args:
+        i = args.index("--embed")
+        header = args[i + 1] if i + 1 < len(args) else os.path.join(root, EMBED_HEADER)
+        del args[i:i + 2]
+    src = args[0] if len(args) > 0 else os.path.join(root, "data")
+    dst = args[1] if len(args) > 1 else os.path.join(root, ".pio", "www")
+    assets = build(src, dst)
+    if header:
+        embed(assets, header)
+else:
+    try:
+        Import("env")  # noqa: F821 (PlatformIO SCons ortamı)
+        project = env.subst("$PROJECT_DIR")  # noqa: F821
+        assets = build(os.path.join(project, "data"), env.subst("$PROJECT_DATA_DIR"))  # noqa: F821
+
+        flags = env.GetProjectOption("build_flags", "")  # noqa: F821
+        if not isinstance(flags, str):
+            flags = " ".join(flags)
+        if "-DEMBED_WEB_UI" in flags.split():
+            embed(assets, os.path.join(project, EMBED_HEADER))
+    except NameError:
+        pass
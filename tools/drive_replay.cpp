@@ -0,0 +1,228 @@
+// Sürüş kaydı çözücü ve oynatıcı (host tarafı)
+//
+// Cihazdan indirilen /drive.log'u (include/DriveLog.h biçimi) okur, son
+// (ya da seçilen) oturumun bloklarını seq sırasıyla çözer ve kayıtları
+// MotorController ile aynı rampa + ölü bölge zincirinden 200 Hz sanal
+// tick'le geçirir. Çıktı: özet (kayıt/bayt, kaynak dağılımı, çözme hızı)
+// ve --csv ile tick başına t_ms, kaynak, hedef ve PWM değerleri.
+// --speed N > 0 ise tick'ler gerçek zamanın N katı hızla yayılır
+// (ör. başka bir araca canlı akıtmak için); 0 en hızlı.
+//
+// Derleme:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/drive_replay.cpp -o drive_replay
+//   curl -o drive.log http://<ip>/drive.log
+//   ./drive_replay drive.log [--session N] [--speed N] [--csv]
+//   ./drive_replay --sample ornek.log     # Cihazsız deneme için sentetik oturum
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "DriveLog.h"
+#include "LatencyStats.h"
+#include "RampGenerator.h"
+
+using namespace DriveLog;
+
+typedef std::chrono::steady_clock Clock;
+
+static const uint16_t BLOCK_COUNT = 128;   // DriveRecorder::BLOCK_COUNT
+static const uint32_t TICK_HZ = 200;
+static const int16_t MIN_PWM = 150;
+static const int16_t PWM_MAX = 255;
+
+static const char* const SOURCE_NAMES[8] = {
+    "internal", "drive_bin", "drive_json", "move", "speed", "sound", "?", "stop"
+};
+
+struct Block {
+    Header header;
+    const uint8_t* data;
+};
+
+static std::vector<uint8_t> readFile(const char* path) {
+    std::vector<uint8_t> data;
+    FILE* f = fopen(path, "rb");
+    if (!f) return data;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.insert(data.end(), buf, buf + n);
+    fclose(f);
+    return data;
+}
+
+// Joystick sürüşü benzeri oturum: yumuşak gaz/direksiyon, arada durdurma
+static int writeSample(const char* path) {
+    std::vector<uint8_t> file(BLOCK_SIZE * BLOCK_COUNT, 0xFF);
+    BlockWriter writer;
+    uint32_t seq = 0;
+    Record last = { 0, 0, 0, 0 };
+    writer.begin(&file[0], 1, seq, last);
+
+    uint32_t t = 0;
+    for (int i = 0; i < 3000; i++) {
+        t += 25 + (uint32_t)(i % 7) * 3;
+        double phase = i * 0.01;
+        Record r;
+        r.t = t;
+        r.left = (int16_t)lround(200 * sin(phase) + 40 * sin(phase * 3.1));
+        r.right = (int16_t)lround(200 * sin(phase + 0.4));
+        r.source = 1;
+        if (i % 600 == 599) {
+            r.left = r.right = 0;
+            r.source = SOURCE_STOP;
+        }
+        if (!writer.append(r)) {
+            writer.seal();
+            seq++;
+            writer.begin(&file[(seq % BLOCK_COUNT) * BLOCK_SIZE], 1, seq, writer.lastRecord());
+            writer.append(r);
+        }
+    }
+    writer.seal();
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return 1;
+    fwrite(file.data(), 1, file.size(), f);
+    fclose(f);
+    printf("%s: 3000 kayıt, %u blok\n", path, seq + 1);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "kullanım: %s <drive.log> [--session N] [--speed N] [--csv] | --sample <dosya>\n", argv[0]);
+        return 2;
+    }
+    if (strcmp(argv[1], "--sample") == 0) {
+        return argc > 2 ? writeSample(argv[2]) : 2;
+    }
+
+    const char* path = argv[1];
+    long wantedSession = -1;
+    double speed = 0;
+    bool csv = false;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--session") == 0 && i + 1 < argc) wantedSession = atol(argv[++i]);
+        else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) speed = atof(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0) csv = true;
+    }
+
+    std::vector<uint8_t> file = readFile(path);
+    if (file.size() < BLOCK_SIZE) {
+        fprintf(stderr, "%s okunamadı ya da boş\n", path);
+        return 1;
+    }
+
+    // Geçerli bloklar; oturum verilmediyse en büyük seq'li bloğun oturumu
+    std::vector<Block> blocks;
+    for (size_t offset = 0; offset + BLOCK_SIZE <= file.size(); offset += BLOCK_SIZE) {
+        Block b;
+        b.data = &file[offset];
+        if (readHeader(b.data, b.header)) blocks.push_back(b);
+    }
+    if (blocks.empty()) {
+        fprintf(stderr, "Geçerli blok yok\n");
+        return 1;
+    }
+    if (wantedSession < 0) {
+        const Block* newest = &blocks[0];
+        for (const Block& b : blocks) {
+            if ((int32_t)(b.header.seq - newest->header.seq) > 0) newest = &b;
+        }
+        wantedSession = newest->header.session;
+    }
+    blocks.erase(std::remove_if(blocks.begin(), blocks.end(), [&](const Block& b) {
+        return b.header.session != (uint16_t)wantedSession;
+    }), blocks.end());
+    std::sort(blocks.begin(), blocks.end(), [](const Block& a, const Block& b) {
+        return (int32_t)(a.header.seq - b.header.seq) < 0;
+    });
+
+    // Çöz
+    std::vector<Record> records;
+    size_t payload = 0;
+    Clock::time_point decodeStart = Clock::now();
+    for (const Block& b : blocks) {
+        BlockReader reader;
+        Header header;
+        if (!reader.begin(b.data, header)) continue;
+        payload += HEADER_SIZE + header.used;
+        Record r;
+        while (reader.next(r)) records.push_back(r);
+    }
+    double decodeNs = std::chrono::duration<double, std::nano>(Clock::now() - decodeStart).count();
+    if (records.empty()) {
+        fprintf(stderr, "Oturum %ld boş\n", wantedSession);
+        return 1;
+    }
+
+    // MotorController varsayılanlarıyla rampa + ölü bölge
+    RampConfig config;
+    config.accelPerSec = 510;
+    config.decelPerSec = 1020;
+    config.jerkPerSec2 = 4000;
+    RampGenerator leftRamp, rightRamp;
+    leftRamp.configure(config, TICK_HZ);
+    rightRamp.configure(config, TICK_HZ);
+
+    if (csv) printf("t_ms,kaynak,hedef_sol,hedef_sag,pwm_sol,pwm_sag\n");
+
+    uint32_t sourceCounts[8] = {};
+    int16_t goalLeft = 0, goalRight = 0;
+    uint8_t source = 0;
+    size_t next = 0;
+    uint32_t t0 = records[0].t;
+    uint32_t end = records.back().t - t0 + 1000;   // Son kayıttan sonra rampa otursun
+    uint32_t ticks = 0, settledTicks = 0;
+    Clock::time_point wallStart = Clock::now();
+
+    for (uint32_t tick = 0; tick * 1000 / TICK_HZ <= end; tick++) {
+        uint32_t tMs = tick * 1000 / TICK_HZ;
+        while (next < records.size() && records[next].t - t0 <= tMs) {
+            const Record& r = records[next++];
+            sourceCounts[r.source & 7]++;
+            source = r.source;
+            goalLeft = r.left;
+            goalRight = r.right;
+            if (r.source == SOURCE_STOP) {
+                leftRamp.reset();
+                rightRamp.reset();
+            }
+        }
+
+        // Sabit komutlar (move) telafisiz PWM'dir (MotorController ile aynı)
+        int16_t left = leftRamp.step(goalLeft);
+        int16_t right = rightRamp.step(goalRight);
+        if (source != CMD_MOVE) {
+            left = compensateDeadband(left, MIN_PWM, PWM_MAX);
+            right = compensateDeadband(right, MIN_PWM, PWM_MAX);
+        }
+        ticks++;
+        if (leftRamp.value() == goalLeft && rightRamp.value() == goalRight) settledTicks++;
+
+        if (speed > 0) {
+            std::this_thread::sleep_until(wallStart + std::chrono::microseconds((uint64_t)(tMs * 1000 / speed)));
+        }
+        if (csv) printf("%u,%s,%d,%d,%d,%d\n", tMs, SOURCE_NAMES[source & 7], goalLeft, goalRight, left, right);
+    }
+
+    FILE* out = csv ? stderr : stdout;
+    fprintf(out, "oturum         : %ld (%zu blok)\n", wantedSession, blocks.size());
+    fprintf(out, "kayıt          : %zu, süre %.1f s\n", records.size(), (records.back().t - t0) / 1000.0);
+    fprintf(out, "boyut          : %zu bayt, %.2f bayt/kayıt (ham 9 bayt)\n", payload,
+            (double)(payload - blocks.size() * HEADER_SIZE) / records.size());
+    fprintf(out, "çözme          : %.1f ns/kayıt\n", decodeNs / records.size());
+    fprintf(out, "kaynaklar      :");
+    for (uint8_t i = 0; i < 8; i++) {
+        if (sourceCounts[i]) fprintf(out, " %s=%u", SOURCE_NAMES[i], sourceCounts[i]);
+    }
+    fprintf(out, "\ntick           : %u (%u Hz), rampa hedefte: %%%.1f\n", ticks, TICK_HZ,
+            100.0 * settledTicks / ticks);
+    return 0;
+}
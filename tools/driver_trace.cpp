@@ -0,0 +1,41 @@
+// TB6612FNG sürücü yazım dizisi izi (host tarafı)
+//
+// Tb6612Driver'ı kayıt tutan bir GpioPort mock'u ile çalıştırır ve her
+// komut için cihazda yapılacak register/PWM yazımlarını sırasıyla basar.
+// Pinler main.cpp ile aynıdır (BIN1 = GPIO16).
+//
+// Derleme:
+//   g++ -std=gnu++17 -O2 -Iinclude -Itools tools/driver_trace.cpp -o driver_trace
+
+#include "MotorDriver.h"
+#include "RecordingGpioPort.h"
+
+int main() {
+    RecordingGpioPort port;
+    Tb6612Driver driver(port, 5, 4, 0, 13, 16, 15, 2);
+
+    driver.begin();
+    port.print("begin");
+
+    struct Step { const char* label; int16_t left; int16_t right; };
+    const Step steps[] = {
+        { "ileri 150", 150, 150 },
+        { "ileri 150 (aynı)", 150, 150 },
+        { "ileri 200", 200, 200 },
+        { "sola pivot", -150, 150 },
+        { "sağa pivot", 150, -150 },
+        { "geri", -180, -180 },
+        { "dur", 0, 0 },
+    };
+
+    for (const Step& step : steps) {
+        port.clear();
+        driver.apply(step.left, step.right);
+        port.print(step.label);
+    }
+
+    port.clear();
+    driver.release();
+    port.print("acil durdurma");
+    return 0;
+}
@@ -0,0 +1,44 @@
+// Hız rampası basamak yanıtı (host tarafı)
+//
+// RampGenerator + ölü bölge telafisini MotorController ile aynı
+// parametrelerle 200 Hz'de çalıştırır ve CSV olarak yazar:
+//   t_ms, hedef, rampa, pwm
+// Basamaklar: 0 -> 255 -> -200 -> 0 (her biri 1 s). Eğrilerin özellikleri
+// (aşmasız yaklaşım, accel/decel/jerk sınırları, telafinin sürekliliği)
+// test/test_ramp'ta denetlenir; bu araç yalnızca çizim içindir.
+//
+// Derleme:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/ramp_response.cpp -o ramp_response
+//   ./ramp_response [accel] [decel] [jerk] > yanit.csv
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "RampGenerator.h"
+
+int main(int argc, char** argv) {
+    const uint32_t tickHz = 200;
+    const int16_t minPwm = 150;
+    const int16_t pwmMax = 255;
+
+    RampConfig config;
+    config.accelPerSec = (uint16_t)(argc > 1 ? atoi(argv[1]) : 510);
+    config.decelPerSec = (uint16_t)(argc > 2 ? atoi(argv[2]) : 1020);
+    config.jerkPerSec2 = (uint32_t)(argc > 3 ? atol(argv[3]) : 4000);
+
+    RampGenerator ramp;
+    ramp.configure(config, tickHz);
+
+    const int16_t steps[] = { 255, -200, 0 };
+
+    printf("t_ms,hedef,rampa,pwm\n");
+    uint32_t tick = 0;
+    for (int16_t target : steps) {
+        for (uint32_t i = 0; i < tickHz; i++, tick++) {
+            int16_t value = ramp.step(target);
+            printf("%u,%d,%d,%d\n", tick * 1000 / tickHz, target, value,
+                   compensateDeadband(value, minPwm, pwmMax));
+        }
+    }
+    return 0;
+}
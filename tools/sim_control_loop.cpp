@@ -0,0 +1,123 @@
+// Kontrol döngüsü zamanlama simülasyonu (host tarafı)
+//
+// loop()'u sanal bir micros() saatiyle modeller: her geçişte WebSocket
+// servisi, ara sıra gelen çerçeve patlamaları ve nadir WiFi duraklamaları
+// rastgele süre harcar. ControlTimer'ın tick jitter'ı, kaçırılan tick
+// sayısı ve posta kutusuna yazılan hedefin pinlere uygulanma gecikmesi
+// raporlanır. Karşılaştırma için eski `delay(10)` döngüsü de çalıştırılır.
+//
+// Derleme:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/sim_control_loop.cpp -o sim_control_loop
+//   ./sim_control_loop [saniye] [seed]
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "ControlTimer.h"
+#include "SetpointMailbox.h"
+
+struct Scenario {
+    const char* name;
+    uint32_t loopDelayUs;   // loop() sonundaki bekleme (eski kod: 10000)
+};
+
+struct Result {
+    uint32_t ticks;
+    uint32_t missed;
+    uint32_t avgJitter;
+    uint32_t maxJitter;
+    uint32_t applied;
+    uint32_t avgApplyLatency;
+    uint32_t maxApplyLatency;
+};
+
+static Result run(const Scenario& sc, uint32_t seconds, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> serviceUs(20, 80);     // Boş webSocket->loop()
+    std::uniform_int_distribution<uint32_t> frameUs(200, 900);     // Çerçeve işleme
+    std::uniform_int_distribution<uint32_t> percent(0, 999);
+    std::uniform_int_distribution<uint32_t> rare(0, 9999);
+
+    ControlTimer timer(5000); // 200 Hz
+    SetpointMailbox mailbox;
+    uint32_t version = 0;
+
+    uint32_t now = 0;
+    const uint32_t end = seconds * 1000000UL;
+
+    // Posta kutusuna yazılan son hedefin zamanı (uygulama gecikmesi için)
+    bool pending = false;
+    uint32_t postedAt = 0;
+    uint64_t latencySum = 0;
+    uint32_t latencyMax = 0;
+    uint32_t applied = 0;
+    int16_t value = 0;
+
+    while (now < end) {
+        // Kontrol tick'i
+        if (timer.poll(now)) {
+            Setpoint sp;
+            if (mailbox.take(sp, version) && pending) {
+                uint32_t latency = now - postedAt;
+                latencySum += latency;
+                if (latency > latencyMax) latencyMax = latency;
+                applied++;
+                pending = false;
+            }
+            now += 15; // Pin yazma maliyeti
+        }
+
+        // webSocket->loop(): çoğunlukla boş, %5 ihtimalle çerçeve,
+        // %0.5 ihtimalle 5 çerçevelik patlama
+        now += serviceUs(rng);
+        uint32_t p = percent(rng);
+        uint32_t frames = p < 5 ? 5 : (p < 55 ? 1 : 0);
+        for (uint32_t i = 0; i < frames; i++) {
+            now += frameUs(rng);
+            value = (int16_t)(value + 1);
+            mailbox.post(value, (int16_t)-value);
+            if (!pending) {
+                pending = true;
+                postedAt = now;
+            }
+        }
+
+        // Nadir WiFi/OTA duraklaması (~15 ms)
+        if (rare(rng) == 0) now += 15000;
+
+        now += sc.loopDelayUs;
+    }
+
+    Result r;
+    r.ticks = timer.getTicks();
+    r.missed = timer.getMissedTicks();
+    r.avgJitter = timer.getAvgJitterUs();
+    r.maxJitter = timer.getMaxJitterUs();
+    r.applied = applied;
+    r.avgApplyLatency = applied ? (uint32_t)(latencySum / applied) : 0;
+    r.maxApplyLatency = latencyMax;
+    return r;
+}
+
+int main(int argc, char** argv) {
+    uint32_t seconds = argc > 1 ? (uint32_t)atoi(argv[1]) : 60;
+    uint32_t seed = argc > 2 ? (uint32_t)atoi(argv[2]) : 1;
+
+    const Scenario scenarios[] = {
+        { "yield() döngüsü", 0 },
+        { "delay(10) döngüsü", 10000 },
+    };
+
+    printf("Simülasyon süresi: %u s, hedef: 200 Hz (5000 us)\n\n", seconds);
+    printf("%-20s %8s %8s %10s %10s %12s %12s\n",
+           "senaryo", "tick", "kaçan", "jitter_ort", "jitter_max", "uygulama_ort", "uygulama_max");
+
+    for (const Scenario& sc : scenarios) {
+        Result r = run(sc, seconds, seed);
+        printf("%-20s %8u %8u %8u us %8u us %10u us %10u us\n",
+               sc.name, r.ticks, r.missed, r.avgJitter, r.maxJitter,
+               r.avgApplyLatency, r.maxApplyLatency);
+    }
+    return 0;
+}
@@ -0,0 +1,315 @@
+// Teker hız denetleyicisi ayar ve regresyon aracı (host tarafı)
+//
+// include/SpeedController.h'yi MotorController::tick() ile aynı zincirde
+// (rampa -> PI düzeltmesi -> ölü bölge telafisi -> sürücü) DC motor
+// modeline (src/native/DcMotorPlant.h) karşı çalıştırır. 200 Hz tick ve
+// SPEED_DIVIDER'lık PI güncellemesi sanal zamanda ilerler; saniyelik sürüş
+// milisaniyede biter. Senaryolar:
+//   basamak  : 0 -> hedef (rampasız), yükselme/aşma/oturma, kalıcı hata
+//   yük      : t = 2 s'de yokuş torku; en derin düşüş ve toparlanma süresi
+//   düz sürüş: iki teker, sağ motor %5 zayıf + %8 sürtünmeli; 4 s ileri,
+//              açık ve kapalı çevrimde yön sapması (derece)
+//
+// Derleme:
+//   g++ -std=gnu++17 -O2 -Iinclude -Isrc/native tools/speed_tune.cpp -o speed_tune
+//   ./speed_tune [--kp 300] [--ki 4800] [--max-cps N] [--divider 4] [--jitter µs]
+//   ./speed_tune --sweep           # kp x ki ızgarası
+//   ./speed_tune --csv > adim.csv  # basamak + yük senaryosunun tick izi
+//   ./speed_tune --check           # varsayılan kazançlar sınırları aşarsa çıkış 1
+//
+// --max-cps verilmezse ileri besleme ölçeği modelin PWM_MAX'taki yüksüz
+// hızından alınır (cihazdaki SpeedConfig::maxCountsPerSec karşılığı).
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "RampGenerator.h"
+#include "SpeedController.h"
+#include "DcMotorPlant.h"
+
+static const uint32_t TICK_HZ = 200;        // MotorController::CONTROL_HZ
+static const int16_t MIN_PWM = 150;
+static const int16_t PWM_MAX = 255;
+static const float WHEEL_RADIUS_M = 0.0325f;
+static const float TRACK_M = 0.13f;
+
+struct Options {
+    uint16_t kp = 300;
+    uint16_t ki = 4800;
+    uint16_t maxCps = 0;        // 0: modelden
+    uint8_t divider = 4;        // MotorController::SPEED_DIVIDER
+    uint32_t jitterUs = 0;      // Tick aralığı oynaması (zamanlayıcı gecikmesi)
+    int16_t stepCommand = 180;
+    float loadNm = 0.03f;
+};
+
+// Tick zamanları: k * periyot + gecikme (ControlTimer gibi faza kilitli,
+// gecikme birikmez). Oynama tekrarlanabilir (sweep karşılaştırılabilir kalsın).
+struct TickClock {
+    uint32_t jitterUs;
+    uint32_t rng = 1;
+    uint32_t index = 0;
+    uint32_t nowUs = 0;
+
+    explicit TickClock(uint32_t jitter) : jitterUs(jitter) {}
+
+    // Sonraki tick'e geçer; geçen süre (s)
+    float advance() {
+        uint32_t delay = 0;
+        if (jitterUs) {
+            rng = rng * 1664525u + 1013904223u;
+            delay = (rng >> 8) % (jitterUs + 1);
+        }
+        uint32_t next = ++index * (1000000u / TICK_HZ) + delay;
+        float dt = (next - nowUs) * 1e-6f;
+        nowUs = next;
+        return dt;
+    }
+    float seconds() const { return nowUs * 1e-6f; }
+};
+
+// MotorController'daki teker zinciri
+struct Wheel {
+    DcMotorPlant plant;
+    RampGenerator ramp;
+    SpeedController speed;
+    bool closed = true;
+    uint8_t divider = 4;
+    uint8_t phase = 0;
+    int16_t out = 0;
+
+    Wheel(const DcMotorParams& params, const Options& opt, uint16_t maxCps, const RampConfig& rampConfig)
+        : plant(params), divider(opt.divider) {
+        ramp.configure(rampConfig, TICK_HZ);
+        SpeedConfig config;
+        config.countsPerRev = params.countsPerRev;
+        config.maxCountsPerSec = maxCps;
+        config.kp = opt.kp;
+        config.ki = opt.ki;
+        config.rateHz = (uint16_t)(TICK_HZ / opt.divider);
+        speed.configure(config);
+    }
+
+    // dt: önceki tick'ten bu yana geçen süre; model o aralığı önceki
+    // çıkışla ilerletir, sonra yeni çıkış hesaplanır
+    void tick(int16_t goal, uint32_t nowUs, float dt) {
+        plant.step(out / (float)PWM_MAX, out == 0, dt);
+        int16_t command = ramp.step(goal);
+        if (closed) {
+            if (++phase >= divider) {
+                phase = 0;
+                speed.update(command, plant.counts(), nowUs, PWM_MAX);
+            }
+            command = speed.apply(command, PWM_MAX);
+        }
+        // PWM 0: sürücü DIR_STOP (IN1 = IN2 = 0), motor boşta
+        out = compensateDeadband(command, MIN_PWM, PWM_MAX);
+    }
+};
+
+static RampConfig instantRamp() {
+    RampConfig r;
+    r.accelPerSec = 60000;
+    r.decelPerSec = 60000;
+    r.jerkPerSec2 = 0;
+    return r;
+}
+
+static RampConfig defaultRamp() {
+    // MotorController varsayılanı
+    RampConfig r;
+    r.accelPerSec = 510;
+    r.decelPerSec = 1020;
+    r.jerkPerSec2 = 4000;
+    return r;
+}
+
+static float countsPerSecToRpm(float cps, uint16_t countsPerRev) {
+    return cps * 60.0f / countsPerRev;
+}
+
+struct StepMetrics {
+    float targetRpm = 0;
+    float riseMs = -1;          // %10 -> %90
+    float overshootPct = 0;
+    float settleMs = -1;        // ±%5 bandına son giriş
+    float steadyErrPct = 0;     // 1.5..2 s ortalaması
+    float loadDipPct = 0;       // Yük sonrası en derin düşüş
+    float recoverMs = -1;       // Yükten sonra ±%5'e dönüş
+    float loadErrPct = 0;       // 3.5..4 s ortalaması
+    uint32_t saturations = 0;
+};
+
+// Tek teker: 0..2 s basamak, 2..4 s yük. csv: tick izi stdout'a
+static StepMetrics runStep(const Options& opt, uint16_t maxCps, bool closed, bool csv) {
+    DcMotorParams params = DcMotorParams::n20();
+    Wheel wheel(params, opt, maxCps, instantRamp());
+    wheel.closed = closed;
+
+    StepMetrics m;
+    float targetCps = (float)opt.stepCommand * maxCps / PWM_MAX;
+    m.targetRpm = countsPerSecToRpm(targetCps, params.countsPerRev);
+    float t10 = -1, t90 = -1, peak = 0, lastOutside = 0, steadySum = 0, loadSum = 0;
+    float minAfterLoad = 1e9f, lastOutsideLoad = 2.0f;
+    uint32_t steadyN = 0, loadN = 0;
+
+    if (csv) printf("t_ms,target_rpm,rpm,pwm,trim,load_nm\n");
+    TickClock clock(opt.jitterUs);
+    float t = 0;
+    while (t < 4.0f) {
+        wheel.plant.load = t >= 2.0f ? opt.loadNm : 0;
+        float dt = clock.advance();
+        t = clock.seconds();
+        wheel.tick(opt.stepCommand, clock.nowUs, dt);
+
+        float rpm = wheel.plant.rpm();
+        float ratio = rpm / m.targetRpm;
+        if (t < 2.0f) {
+            if (t10 < 0 && ratio >= 0.1f) t10 = t;
+            if (t90 < 0 && ratio >= 0.9f) t90 = t;
+            if (rpm > peak) peak = rpm;
+            if (fabsf(ratio - 1) > 0.05f) lastOutside = t;
+            if (t >= 1.5f) { steadySum += rpm; steadyN++; }
+        } else {
+            if (rpm < minAfterLoad) minAfterLoad = rpm;
+            if (fabsf(ratio - 1) > 0.05f) lastOutsideLoad = t;
+            if (t >= 3.5f) { loadSum += rpm; loadN++; }
+        }
+        if (csv) {
+            printf("%.1f,%.1f,%.1f,%d,%d,%.3f\n", t * 1000, m.targetRpm, rpm, wheel.out,
+                   wheel.speed.getCorrection(), wheel.plant.load);
+        }
+    }
+
+    if (t10 >= 0 && t90 >= 0) m.riseMs = (t90 - t10) * 1000;
+    m.overshootPct = peak > m.targetRpm ? (peak / m.targetRpm - 1) * 100 : 0;
+    m.settleMs = lastOutside < 1.9f ? lastOutside * 1000 : -1;
+    m.steadyErrPct = steadyN ? (steadySum / steadyN / m.targetRpm - 1) * 100 : 0;
+    m.loadDipPct = (1 - minAfterLoad / m.targetRpm) * 100;
+    m.recoverMs = lastOutsideLoad < 3.9f ? (lastOutsideLoad - 2.0f) * 1000 : -1;
+    m.loadErrPct = loadN ? (loadSum / loadN / m.targetRpm - 1) * 100 : 0;
+    m.saturations = wheel.speed.getSaturations();
+    return m;
+}
+
+// İki teker, forward(): hedef 200, varsayılan rampa, 4 s. Dönüş: yön sapması (derece)
+static float runStraight(const Options& opt, uint16_t maxCps, bool closed, float& distanceM) {
+    DcMotorParams weak = DcMotorParams::n20();
+    weak.kt *= 0.95f;
+    weak.coulomb *= 1.08f;
+    weak.stiction *= 1.08f;
+    Wheel left(DcMotorParams::n20(), opt, maxCps, defaultRamp());
+    Wheel right(weak, opt, maxCps, defaultRamp());
+    left.closed = right.closed = closed;
+
+    TickClock clock(opt.jitterUs);
+    while (clock.seconds() < 4.0f) {
+        int16_t goal = clock.seconds() < 3.5f ? 200 : 0;
+        float dt = clock.advance();
+        left.tick(goal, clock.nowUs, dt);
+        right.tick(goal, clock.nowUs, dt);
+    }
+    float circumference = 2 * (float)M_PI * WHEEL_RADIUS_M;
+    float sLeft = (float)left.plant.revolutions() * circumference;
+    float sRight = (float)right.plant.revolutions() * circumference;
+    distanceM = 0.5f * (sLeft + sRight);
+    return (sRight - sLeft) / TRACK_M * 180.0f / (float)M_PI;
+}
+
+static void printStep(const char* name, const StepMetrics& m) {
+    printf("%-12s hedef %.0f rpm  yükselme %.0f ms  aşma %%%.1f  oturma %.0f ms  kalıcı hata %%%.2f\n",
+           name, m.targetRpm, m.riseMs, m.overshootPct, m.settleMs, m.steadyErrPct);
+    printf("%-12s yük: düşüş %%%.1f  toparlanma %.0f ms  hata %%%.2f  (doyum %u)\n",
+           "", m.loadDipPct, m.recoverMs, m.loadErrPct, m.saturations);
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    bool sweep = false, csv = false, check = false;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--kp") == 0 && hasValue) opt.kp = (uint16_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--ki") == 0 && hasValue) opt.ki = (uint16_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-cps") == 0 && hasValue) opt.maxCps = (uint16_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--divider") == 0 && hasValue) opt.divider = (uint8_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jitter") == 0 && hasValue) opt.jitterUs = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--sweep") == 0) sweep = true;
+        else if (strcmp(argv[i], "--csv") == 0) csv = true;
+        else if (strcmp(argv[i], "--check") == 0) check = true;
+        else {
+            fprintf(stderr, "kullanım: %s [--kp N] [--ki N] [--max-cps N] [--divider N] [--jitter µs] "
+                            "[--sweep | --csv | --check]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (opt.divider == 0) opt.divider = 1;
+
+    DcMotorPlant reference;
+    float fullCps = reference.steadySpeed(1.0f) / (2 * (float)M_PI) * reference.getParams().countsPerRev;
+    uint16_t maxCps = opt.maxCps ? opt.maxCps : (uint16_t)lroundf(fullCps);
+
+    if (csv) {
+        runStep(opt, maxCps, true, true);
+        return 0;
+    }
+
+    if (sweep) {
+        static const uint16_t KP[] = { 0, 100, 200, 300, 500, 800, 1200 };
+        static const uint16_t KI[] = { 300, 600, 1200, 2400, 4800 };
+        printf("maxCountsPerSec=%u, PI %u Hz\n", maxCps, TICK_HZ / opt.divider);
+        printf("   kp    ki  aşma%%  oturma_ms  hata%%  yük_düşüş%%  toparlanma_ms  sapma°\n");
+        for (uint16_t kp : KP) {
+            for (uint16_t ki : KI) {
+                Options o = opt;
+                o.kp = kp;
+                o.ki = ki;
+                StepMetrics m = runStep(o, maxCps, true, false);
+                float distance;
+                float drift = runStraight(o, maxCps, true, distance);
+                printf("%5u %5u %6.1f %10.0f %6.2f %11.1f %14.0f %7.2f\n", kp, ki, m.overshootPct,
+                       m.settleMs, m.steadyErrPct, m.loadDipPct, m.recoverMs, drift);
+            }
+        }
+        return 0;
+    }
+
+    printf("Model: N20 %.1f V, yüksüz tam hız %.0f rpm (%.0f kenar/s); maxCountsPerSec=%u\n",
+           reference.getParams().supplyV, reference.steadySpeed(1.0f) * 60 / (2 * M_PI), fullCps, maxCps);
+    printf("PI: kp=%u ki=%u, %u Hz (bölücü %u), tick oynaması %u µs\n\n",
+           opt.kp, opt.ki, TICK_HZ / opt.divider, opt.divider, opt.jitterUs);
+
+    StepMetrics open = runStep(opt, maxCps, false, false);
+    StepMetrics closed = runStep(opt, maxCps, true, false);
+    printStep("açık çevrim", open);
+    printStep("kapalı", closed);
+
+    float openDistance, closedDistance;
+    float openDrift = runStraight(opt, maxCps, false, openDistance);
+    float closedDrift = runStraight(opt, maxCps, true, closedDistance);
+    printf("\nDüz sürüş (sağ motor zayıf), 4 s:\n");
+    printf("açık çevrim  yol %.2f m, sapma %.1f°\n", openDistance, openDrift);
+    printf("kapalı       yol %.2f m, sapma %.1f°\n", closedDistance, closedDrift);
+
+    if (!check) return 0;
+
+    // Regresyon sınırları: kazanç/zamanlama değişikliği bunları bozmamalı
+    int failures = 0;
+    struct Limit { const char* name; bool ok; float value; };
+    const Limit limits[] = {
+        { "aşma <= %15", closed.overshootPct <= 15, closed.overshootPct },
+        { "oturma <= 400 ms", closed.settleMs >= 0 && closed.settleMs <= 400, closed.settleMs },
+        { "|kalıcı hata| <= %2", fabsf(closed.steadyErrPct) <= 2, closed.steadyErrPct },
+        { "yükte |hata| <= %2", fabsf(closed.loadErrPct) <= 2, closed.loadErrPct },
+        { "toparlanma <= 500 ms", closed.recoverMs >= 0 && closed.recoverMs <= 500, closed.recoverMs },
+        { "sapma <= açık çevrimin 1/5'i", fabsf(closedDrift) * 5 <= fabsf(openDrift), closedDrift },
+    };
+    printf("\n");
+    for (const Limit& limit : limits) {
+        printf("%s %s (%.2f)\n", limit.ok ? "OK  " : "HATA", limit.name, limit.value);
+        if (!limit.ok) failures++;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,247 @@
+// UDP sürüş kanalı referans istemcisi ve yük aracı (Linux)
+//
+// Cihaza (ya da yerel karşı uca) sabit hızda, sıra numaralı OP_DRIVE
+// datagramları gönderir (include/DriveProtocol.h: belirteç + 12 byte
+// çerçeve), OP_ACK yankılarından gidiş-dönüş süresini ve kaybı ölçer.
+// Belirteç verilmezse GET /api/udp?new=1 ile yeni oturum açılır.
+//
+// Derleme:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/udp_client.cpp -o udp_client
+// Cihaza karşı:
+//   ./udp_client 192.168.4.1 [--rate 50] [--duration 10] [--ack-every 1]
+// Yerel karşı uç (cihazsız):
+//   .pio/build/native/program --udp 4210        # belirteci yazdırır
+//   ./udp_client 127.0.0.1 --token <belirteç> --rate 500
+//
+// Seçenekler: --port (4210), --http-port (80), --token, --rate (Hz),
+// --duration (s), --ack-every (her N çerçevede bir ACK iste), --csv (RTT
+// örnekleri stdout'a; özet stderr'e)
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "DriveProtocol.h"
+
+using namespace DriveProtocol;
+
+typedef std::chrono::steady_clock Clock;
+
+static Clock::time_point startTime = Clock::now();
+
+static double nowMs() {
+    return std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+}
+
+static int connectTo(const char* host, uint16_t port, int type) {
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = type;
+    addrinfo* result = nullptr;
+    char service[8];
+    snprintf(service, sizeof(service), "%u", (unsigned)port);
+    if (getaddrinfo(host, service, &hints, &result) != 0 || !result) return -1;
+
+    int fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (fd >= 0 && connect(fd, result->ai_addr, result->ai_addrlen) < 0) {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(result);
+    return fd;
+}
+
+// GET /api/udp?new=1 -> "token":N
+static bool fetchToken(const char* host, uint16_t httpPort, uint32_t& token) {
+    int fd = connectTo(host, httpPort, SOCK_STREAM);
+    if (fd < 0) return false;
+
+    char request[256];
+    int n = snprintf(request, sizeof(request),
+                     "GET /api/udp?new=1 HTTP/1.0\r\nHost: %s\r\nConnection: close\r\n\r\n", host);
+    bool ok = write(fd, request, (size_t)n) == n;
+
+    std::string response;
+    char buf[512];
+    ssize_t r;
+    while (ok && (r = read(fd, buf, sizeof(buf))) > 0) response.append(buf, (size_t)r);
+    close(fd);
+
+    size_t pos = response.find("\"token\":");
+    if (pos == std::string::npos) return false;
+    token = (uint32_t)strtoul(response.c_str() + pos + 8, nullptr, 10);
+    return token != 0;
+}
+
+static void sendFrame(int fd, uint32_t token, const Frame& frame) {
+    uint8_t packet[UDP_PACKET_SIZE];
+    writeU32(packet, token);
+    encode(frame, packet + UDP_TOKEN_SIZE);
+    if (send(fd, packet, sizeof(packet), 0) < 0) {
+        perror("send");
+    }
+}
+
+static double percentile(const std::vector<double>& sorted, double pct) {
+    if (sorted.empty()) return 0;
+    size_t i = (size_t)(pct / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argv[1][0] == '-') {
+        fprintf(stderr, "kullanım: %s <host> [--port 4210] [--http-port 80] [--token N] [--rate 50] "
+                        "[--duration 10] [--ack-every 1] [--csv]\n", argv[0]);
+        return 2;
+    }
+    const char* host = argv[1];
+    uint16_t port = 4210;
+    uint16_t httpPort = 80;
+    uint32_t token = 0;
+    double rate = 50;
+    double duration = 10;
+    uint32_t ackEvery = 1;
+    bool csv = false;
+    for (int i = 2; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--port") == 0 && hasValue) port = (uint16_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--http-port") == 0 && hasValue) httpPort = (uint16_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--token") == 0 && hasValue) token = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--rate") == 0 && hasValue) rate = atof(argv[++i]);
+        else if (strcmp(argv[i], "--duration") == 0 && hasValue) duration = atof(argv[++i]);
+        else if (strcmp(argv[i], "--ack-every") == 0 && hasValue) ackEvery = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0) csv = true;
+    }
+    if (rate <= 0 || ackEvery == 0) return 2;
+
+    if (token == 0 && !fetchToken(host, httpPort, token)) {
+        fprintf(stderr, "Belirteç alınamadı (http://%s:%u/api/udp); --token verin\n", host, (unsigned)httpPort);
+        return 1;
+    }
+
+    int fd = connectTo(host, port, SOCK_DGRAM);
+    if (fd < 0) {
+        fprintf(stderr, "%s:%u açılamadı\n", host, (unsigned)port);
+        return 1;
+    }
+
+    // seq -> gönderim anı (ms); ACK beklenmiyorsa NAN
+    std::vector<double> sentAt(65536, NAN);
+    std::vector<double> rtts;
+    uint32_t sent = 0, requested = 0, acked = 0, duplicates = 0, reordered = 0, faults = 0;
+    uint16_t seq = 0;
+    int32_t lastAckSeq = -1;
+    int16_t serverDropped = 0;
+    double interval = 1000.0 / rate;
+    double nextSend = nowMs();
+    double sendEnd = nextSend + duration * 1000.0;
+    double stopAt = 0;
+
+    if (csv) printf("seq,rtt_ms\n");
+
+    while (true) {
+        double now = nowMs();
+        if (now >= sendEnd && stopAt == 0) {
+            // Bitiş: durdurma (kayıp olabilir diye üç kez), ACK'ler için 1 s
+            for (int i = 0; i < 3; i++) {
+                Frame stop = {};
+                stop.opcode = OP_STOP;
+                stop.seq = ++seq;
+                stop.stamp = (uint32_t)now;
+                sendFrame(fd, token, stop);
+            }
+            stopAt = now;
+        }
+        if (stopAt != 0 && now - stopAt > 1000) break;
+
+        if (stopAt == 0 && now >= nextSend) {
+            // Yavaş salınan joystick: sol/sağ ±400
+            double phase = now / 1000.0;
+            Frame frame = {};
+            frame.opcode = OP_DRIVE;
+            frame.seq = ++seq;
+            frame.left = (int16_t)lround(400 * sin(phase));
+            frame.right = (int16_t)lround(400 * sin(phase + 0.5));
+            frame.stamp = (uint32_t)now;
+            if (seq % ackEvery == 0) {
+                frame.flags = FLAG_ACK_REQUEST;
+                sentAt[seq] = now;
+                requested++;
+            } else {
+                sentAt[seq] = NAN;
+            }
+            sendFrame(fd, token, frame);
+            sent++;
+            nextSend += interval;
+            // Geride kaldıysak yetişmeye çalışma (gönderim patlaması olmasın)
+            if (nextSend < now) nextSend = now + interval;
+        }
+
+        double wait = stopAt == 0 ? nextSend - nowMs() : 10;
+        pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, wait > 0 ? (int)ceil(wait) : 0) <= 0) continue;
+
+        uint8_t packet[64];
+        ssize_t n;
+        while ((n = recv(fd, packet, sizeof(packet), MSG_DONTWAIT)) > 0) {
+            double rx = nowMs();
+            if ((size_t)n != UDP_PACKET_SIZE || readU32(packet) != token) continue;
+            Frame ack;
+            if (packet[UDP_TOKEN_SIZE] != OP_ACK) continue;
+            ack.flags = packet[UDP_TOKEN_SIZE + 1];
+            ack.seq = readU16(packet + UDP_TOKEN_SIZE + 2);
+            ack.right = (int16_t)readU16(packet + UDP_TOKEN_SIZE + 6);
+
+            if (ack.flags & FLAG_FAULT) faults++;
+            serverDropped = ack.right;
+            if (std::isnan(sentAt[ack.seq])) {
+                duplicates++;
+                continue;
+            }
+            double rtt = rx - sentAt[ack.seq];
+            sentAt[ack.seq] = NAN;
+            if (lastAckSeq >= 0 && (int16_t)(ack.seq - (uint16_t)lastAckSeq) < 0) {
+                reordered++;
+            } else {
+                lastAckSeq = ack.seq;
+            }
+            acked++;
+            rtts.push_back(rtt);
+            if (csv) printf("%u,%.3f\n", (unsigned)ack.seq, rtt);
+        }
+    }
+    close(fd);
+
+    double jitter = 0;
+    for (size_t i = 1; i < rtts.size(); i++) jitter += fabs(rtts[i] - rtts[i - 1]);
+    if (rtts.size() > 1) jitter /= (double)(rtts.size() - 1);
+    std::vector<double> sorted = rtts;
+    std::sort(sorted.begin(), sorted.end());
+
+    FILE* out = csv ? stderr : stdout;
+    fprintf(out, "hedef          : %s:%u, belirteç %u\n", host, (unsigned)port, (unsigned)token);
+    fprintf(out, "gönderilen     : %u çerçeve, %.1f s, %.0f Hz (hedef %.0f Hz)\n", sent, duration,
+            sent / duration, rate);
+    fprintf(out, "ACK            : %u / %u istenen, kayıp %%%.2f (gidiş+dönüş)\n", acked, requested,
+            requested ? 100.0 * (requested - acked) / requested : 0.0);
+    if (!sorted.empty()) {
+        fprintf(out, "RTT (ms)       : min %.2f  p50 %.2f  p90 %.2f  p99 %.2f  max %.2f  jitter %.2f\n",
+                sorted.front(), percentile(sorted, 50), percentile(sorted, 90), percentile(sorted, 99),
+                sorted.back(), jitter);
+    }
+    fprintf(out, "sırasız ACK    : %u, yinelenen/geç: %u\n", reordered, duplicates);
+    fprintf(out, "sunucuda atılan: %d çerçeve (eski/sırasız/bayat), bekçi uyarısı: %u ACK\n",
+            serverDropped, faults);
+    return 0;
+}